@@ -1,3 +1,3 @@
-SRC_BIN += seccomp_bpf_policy.bin
+SRC_BIN += seccomp_bpf_policy.bin seccomp_bpf_policy_rpc_mailbox.bin
 
-vpath seccomp_bpf_policy.bin $(REP_DIR)/src/lib/seccomp/spec/x86_64
+vpath seccomp_bpf_policy%.bin $(REP_DIR)/src/lib/seccomp/spec/x86_64
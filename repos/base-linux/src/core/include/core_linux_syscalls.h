@@ -36,15 +36,19 @@ inline int lx_mkdir(char const *pathname, mode_t mode)
 }
 
 
-inline int lx_ftruncate(int fd, unsigned long length)
+inline int lx_unlink(const char *fname)
 {
-	return (int)lx_syscall(SYS_ftruncate, fd, length);
+	return (int)lx_syscall(SYS_unlinkat, AT_FDCWD, fname, 0);
 }
 
 
-inline int lx_unlink(const char *fname)
+/* defined in asm-generic/mman-common.h */
+enum { LX_MADV_HUGEPAGE = 14 };
+
+
+inline int lx_madvise(void *addr, Genode::size_t length, int advice)
 {
-	return (int)lx_syscall(SYS_unlinkat, AT_FDCWD, fname, 0);
+	return (int)lx_syscall(SYS_madvise, addr, length, advice);
 }
 
 
@@ -266,10 +270,4 @@ inline int lx_pipe(int pipefd[2])
 	return (int)lx_syscall(SYS_pipe2, pipefd, 0);
 }
 
-
-inline int lx_read(int fd, void *buf, Genode::size_t count)
-{
-	return (int)lx_syscall(SYS_read, fd, buf, count);
-}
-
 #endif /* _CORE__INCLUDE__CORE_LINUX_SYSCALLS_H_ */
@@ -52,6 +52,37 @@ static unsigned long ram_quota_from_env()
 }
 
 
+/**
+ * Read minimum size of RAM dataspaces backed by huge pages
+ *
+ * Huge pages are used only if the 'GENODE_HUGE_PAGE_THRESHOLD' environment
+ * variable is set to a non-zero number of bytes. It applies to dataspaces
+ * of at least this size that are a multiple of 2 MiB. Those are backed by
+ * transparent huge pages, which requires the host setting
+ * '/sys/kernel/mm/transparent_hugepage/shmem_enabled' to be 'advise',
+ * 'within_size', or 'always'. The pool of persistent huge pages (hugetlbfs)
+ * is not used because its files cannot be mapped at fixed addresses or
+ * offsets that are not aligned to 2 MiB, as needed for sub region maps and
+ * for attachments at a given local address. With transparent huge pages,
+ * such attachments succeed but use regular pages. Huge pages are thereby
+ * effective only where the local address and offset are aligned to 2 MiB,
+ * which is the case if the kernel chooses the address.
+ */
+static inline unsigned long huge_page_threshold_from_env()
+{
+	using namespace Genode;
+
+	for (char **curr = lx_environ; curr && *curr; curr++) {
+
+		Arg arg = Arg_string::find_arg(*curr, "GENODE_HUGE_PAGE_THRESHOLD");
+		if (arg.valid())
+			return arg.ulong_value(0);
+	}
+
+	return 0;
+}
+
+
 class Core::Platform : public Platform_generic
 {
 	private:
@@ -17,6 +17,7 @@
 /* local includes */
 #include <ram_dataspace_factory.h>
 #include <resource_path.h>
+#include <platform.h>
 
 /* base-internal includes */
 #include <base/internal/capability_space_tpl.h>
@@ -30,17 +31,20 @@ using namespace Core;
 
 static int ram_ds_cnt = 0;  /* counter for creating unique dataspace IDs */
 
-bool Ram_dataspace_factory::_export_ram_ds(Dataspace_component &ds)
+
+/**
+ * Create file in the resource path
+ *
+ * Used as fallback if the kernel lacks support for 'memfd_create'.
+ */
+static int create_file(size_t size)
 {
 	Linux_dataspace::Filename const fname(resource_path(), "/ds-", ram_ds_cnt++);
 
 	/* create file using a unique file name in the resource path */
 	lx_unlink(fname.string());
 	int const fd = lx_open(fname.string(), O_CREAT|O_RDWR|O_TRUNC|LX_O_CLOEXEC, S_IRWXU);
-	lx_ftruncate(fd, ds.size());
-
-	/* remember file descriptor in dataspace component object */
-	ds.fd(fd);
+	lx_ftruncate(fd, size);
 
 	/*
 	 * Wipe the file from the Linux file system. The kernel will still keep the
@@ -49,6 +53,66 @@ bool Ram_dataspace_factory::_export_ram_ds(Dataspace_component &ds)
 	 * w/o the right file descriptor won't be able to open and access the file.
 	 */
 	lx_unlink(fname.string());
+	return fd;
+}
+
+
+/**
+ * Back large dataspace by transparent huge pages
+ *
+ * The file is temporarily mapped in core with the 'MADV_HUGEPAGE' hint and
+ * populated by touching each huge page. The pages stay in the file after
+ * the mapping is gone. Where a component attaches the dataspace at an
+ * address chosen by the kernel, the huge pages are mapped as such. For
+ * attachments at fixed addresses or offsets that are not aligned to the
+ * huge-page size, e.g., within a sub region map, the kernel maps the same
+ * pages with regular page-table entries. The attachment never fails
+ * because of the huge pages.
+ */
+static void populate_huge_pages(int fd, size_t size)
+{
+#ifdef _LP64
+	enum { HUGE_PAGE_SIZE = 2*1024*1024 };
+
+	static size_t const threshold = huge_page_threshold_from_env();
+
+	if (!threshold || size < threshold || (size % HUGE_PAGE_SIZE))
+		return;
+
+	void * const addr = lx_mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (((long)addr < 0) && ((long)addr > -4095))
+		return;
+
+	/* without THP support by the host, the dataspace keeps regular pages */
+	lx_madvise(addr, size, LX_MADV_HUGEPAGE);
+
+	for (size_t offset = 0; offset < size; offset += HUGE_PAGE_SIZE)
+		*((char volatile *)addr + offset) = 0;
+
+	lx_munmap(addr, size);
+#else
+	(void)fd; (void)size;
+#endif
+}
+
+
+bool Ram_dataspace_factory::_export_ram_ds(Dataspace_component &ds)
+{
+	/* create anonymous file without touching the file system */
+	int fd = lx_memfd_create("ram_ds", LX_MFD_CLOEXEC);
+	if (fd >= 0 && lx_ftruncate(fd, ds.size()) != 0) {
+		lx_close(fd);
+		fd = -1;
+	}
+
+	if (fd >= 0)
+		populate_huge_pages(fd, ds.size());
+
+	if (fd < 0)
+		fd = create_file(ds.size());
+
+	/* remember file descriptor in dataspace component object */
+	ds.fd(fd);
 	return true;
 }
 
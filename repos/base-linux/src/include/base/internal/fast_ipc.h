@@ -0,0 +1,241 @@
+/*
+ * \brief  Shared-memory path for capability-free RPC on Linux
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * A client thread can set up a channel to an RPC object, consisting of a
+ * mailbox in shared memory, an eventfd that serves as doorbell for the
+ * server's epoll, and a socket pair for replies that carry capabilities.
+ * Calls without capability arguments are then passed through the mailbox.
+ * The client blocks on the futex word of the mailbox until the server
+ * replied.
+ *
+ * The shared-memory path is opt-in. It is enabled by setting the
+ * 'GENODE_RPC_MAILBOX' environment variable of core to 1, which core passes
+ * on to all components. Only then, the seccomp policy of the components
+ * permits the syscalls needed for setting up channels.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__INTERNAL__FAST_IPC_H_
+#define _INCLUDE__BASE__INTERNAL__FAST_IPC_H_
+
+/* Genode includes */
+#include <base/stdint.h>
+#include <util/noncopyable.h>
+#include <util/reconstructible.h>
+#include <cpu/atomic.h>
+#include <cpu/memory_barrier.h>
+
+/* Linux includes */
+#include <linux_syscalls.h>
+
+namespace Genode::Fast_ipc {
+
+	struct Mailbox;
+	class  Client_channel;
+	class  Client_channels;
+
+	/**
+	 * Return true if the shared-memory path is enabled
+	 */
+	bool enabled();
+}
+
+
+/**
+ * Mailbox shared by the client and the server of a channel
+ *
+ * Both parties must treat the content as untrusted because the peer may
+ * modify it at any time.
+ */
+struct Genode::Fast_ipc::Mailbox
+{
+	enum { SIZE = 4096 };
+
+	enum State {
+		SETUP,        /* created by the client, not yet accepted by the server */
+		IDLE,
+		REQUEST,      /* request message written by the client */
+		REPLY,        /* reply message written by the server */
+		SOCKET_REPLY, /* reply sent via the reply socket of the channel */
+		CLOSED        /* channel released by the client or the server */
+	};
+
+	int      volatile state;   /* futex word */
+	unsigned volatile size;    /* size of message in bytes */
+
+	char msg[SIZE - 2*sizeof(int)];
+
+	bool transition(State from, State to) { return cmpxchg(&state, from, to); }
+
+	void close()
+	{
+		while (!cmpxchg(&state, state, CLOSED));
+		wake();
+	}
+
+	void wake() { lx_futex((int *)&state, LX_FUTEX_WAKE, 1); }
+
+	/**
+	 * Block while the mailbox is in state 's'
+	 */
+	void wait_while(State s)
+	{
+		while (state == s)
+			lx_futex((int *)&state, LX_FUTEX_WAIT, s);
+
+		memory_barrier();
+	}
+};
+
+
+/**
+ * Client-side state of a channel
+ */
+class Genode::Fast_ipc::Client_channel
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Client_channel(Client_channel const &);
+		Client_channel &operator = (Client_channel const &);
+
+	public:
+
+		uint64_t      recipient = 0;      /* inode of the destination socket */
+		unsigned long last_use  = 0;
+
+		/*
+		 * A recipient that declined or released the channel is called
+		 * via the socket path only.
+		 */
+		bool refused = false;
+
+		Mailbox *mailbox  = nullptr;
+		Lx_sd    doorbell { -1 };
+		Lx_sd    memfd    { -1 };   /* backing store of 'mailbox' during setup */
+
+		Constructible<Lx_socketpair> reply { };
+
+		Client_channel() { }
+
+		~Client_channel() { close(); }
+
+		bool active() const { return mailbox && !refused && !memfd.valid(); }
+
+		void ring_doorbell()
+		{
+			uint64_t const one = 1;
+			(void)lx_write(doorbell.value, &one, sizeof(one));
+		}
+
+		/**
+		 * Release resources, keeping the identity of the recipient
+		 */
+		void close()
+		{
+			if (mailbox) {
+				if (doorbell.valid() && !memfd.valid()) {
+					mailbox->close();
+					ring_doorbell();
+				}
+				lx_munmap(mailbox, Mailbox::SIZE);
+				mailbox = nullptr;
+			}
+
+			if (doorbell.valid()) lx_close(doorbell.value);
+			if (memfd.valid())    lx_close(memfd.value);
+			doorbell = Lx_sd::invalid();
+			memfd    = Lx_sd::invalid();
+
+			if (reply.constructed()) {
+				if (reply->local.value  != -1) lx_close(reply->local.value);
+				if (reply->remote.value != -1) lx_close(reply->remote.value);
+				reply.destruct();
+			}
+		}
+
+		/**
+		 * Complete the setup once the server replied to the setup request
+		 *
+		 * The server accepts the channel by marking the mailbox as idle.
+		 */
+		void complete_setup()
+		{
+			if (mailbox->state != Mailbox::IDLE) {
+				refuse();
+				return;
+			}
+
+			lx_close(memfd.value);
+			memfd = Lx_sd::invalid();
+		}
+
+		/**
+		 * Release channel, calling 'recipient' via the socket path from now on
+		 */
+		void refuse()
+		{
+			close();
+			refused = true;
+		}
+};
+
+
+/**
+ * Channels of a client thread, recycled in least-recently-used order
+ */
+class Genode::Fast_ipc::Client_channels : Noncopyable
+{
+	private:
+
+		enum { MAX_CHANNELS = 4 };
+
+		Client_channel _channels[MAX_CHANNELS] { };
+
+		unsigned long _use_count = 0;
+
+	public:
+
+		Client_channels() { }
+
+		/**
+		 * Return channel for calls to 'recipient'
+		 *
+		 * \param recipient  inode of the destination socket
+		 * \return           nullptr if the recipient is unknown
+		 */
+		Client_channel *channel(uint64_t recipient)
+		{
+			if (!recipient)
+				return nullptr;
+
+			Client_channel *lru_ptr = &_channels[0];
+
+			for (Client_channel &channel : _channels) {
+				if (channel.recipient == recipient) {
+					channel.last_use = ++_use_count;
+					return &channel;
+				}
+				if (channel.last_use < lru_ptr->last_use)
+					lru_ptr = &channel;
+			}
+
+			lru_ptr->close();
+			lru_ptr->recipient = recipient;
+			lru_ptr->refused   = false;
+			lru_ptr->last_use  = ++_use_count;
+			return lru_ptr;
+		}
+};
+
+#endif /* _INCLUDE__BASE__INTERNAL__FAST_IPC_H_ */
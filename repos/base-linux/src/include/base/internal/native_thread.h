@@ -16,6 +16,9 @@
 
 #include <base/stdint.h>
 #include <base/native_capability.h>
+#include <util/reconstructible.h>
+
+#include <base/internal/fast_ipc.h>
 
 #include <linux_syscalls.h>
 
@@ -95,8 +98,86 @@ struct Genode::Native_thread : Noncopyable
 			 */
 			void rpc_ep_exited() { _rpc_ep_exited = true; }
 
+			/**
+			 * Add or remove the doorbell of a shared-memory RPC channel
+			 *
+			 * These methods must be called by the polling thread.
+			 */
+			bool add_doorbell(Lx_sd);
+			void remove_doorbell(Lx_sd sd) { _remove(sd); }
+
+			/**
+			 * Release the shared-memory RPC channels to an RPC object
+			 *
+			 * \param object  local socket of the RPC object, or an invalid
+			 *                socket to release all channels served by the
+			 *                polling thread
+			 *
+			 * This method is implemented in 'ipc.cc'.
+			 */
+			void release_fast_channels(Lx_sd object);
+
 	} epoll { };
 
+	/**
+	 * Channel for receiving RPC replies
+	 *
+	 * The remote end of the socket pair is delegated to the server along
+	 * with each request. A server may keep it and send forged replies later
+	 * on. Hence, the socket pair is bound to a single recipient, identified
+	 * by the inode of the destination socket, and reused only for
+	 * subsequent calls to the same recipient. A call to another recipient
+	 * replaces the socket pair, which renders copies of the former remote
+	 * end held by the former recipient useless.
+	 */
+	class Reply_channel : Noncopyable
+	{
+		private:
+
+			Constructible<Lx_socketpair> _socketpair { };
+
+			uint64_t _recipient = 0;   /* inode of destination socket */
+
+			void _close()
+			{
+				if (!_socketpair.constructed())
+					return;
+
+				if (_socketpair->local.value  != -1) lx_close(_socketpair->local.value);
+				if (_socketpair->remote.value != -1) lx_close(_socketpair->remote.value);
+
+				_socketpair.destruct();
+			}
+
+		public:
+
+			~Reply_channel() { _close(); }
+
+			/**
+			 * Return socket pair for a call to 'recipient'
+			 *
+			 * \param recipient  inode of the destination socket
+			 */
+			Lx_socketpair const &socketpair(uint64_t recipient)
+			{
+				/* an unknown recipient never shares the channel */
+				if (!_socketpair.constructed() || !recipient
+				 || recipient != _recipient) {
+					_close();
+					_socketpair.construct();
+					_recipient = recipient;
+				}
+
+				return *_socketpair;
+			}
+
+	} reply_channel { };
+
+	/**
+	 * Shared-memory channels for capability-free RPC calls
+	 */
+	Fast_ipc::Client_channels fast_ipc_channels { };
+
 	Native_thread() { }
 };
 
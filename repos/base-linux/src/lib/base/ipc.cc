@@ -19,12 +19,15 @@
 #include <base/thread.h>
 #include <base/env.h>
 #include <base/sleep.h>
+#include <base/mutex.h>
+#include <util/arg_string.h>
 #include <linux_native_cpu/linux_native_cpu.h>
 
 /* base-internal includes */
 #include <base/internal/native_thread.h>
 #include <base/internal/ipc_server.h>
 #include <base/internal/capability_space_tpl.h>
+#include <base/internal/fast_ipc.h>
 
 /* Linux includes */
 #include <linux_syscalls.h>
@@ -71,8 +74,16 @@ struct Protocol_header
 	/* badges of the transferred capability arguments */
 	unsigned long badges[Msgbuf_base::MAX_CAPS_PER_MSG];
 
+	/*
+	 * A request flagged with SETUP_FAST_CHANNEL carries the reply socket,
+	 * doorbell, and mailbox of a shared-memory channel as sockets 0 to 2
+	 */
+	unsigned long flags;
+
 	enum { INVALID_BADGE = ~1UL };
 
+	enum { SETUP_FAST_CHANNEL = 1 };
+
 	void *msg_start() { return &protocol_word; }
 };
 
@@ -146,6 +157,22 @@ namespace {
 
 			msghdr * msg() { return &_msg; }
 
+			/**
+			 * Return message header for sending the message
+			 *
+			 * A message without socket descriptors omits the control
+			 * message, which spares the kernel the processing of an empty
+			 * SCM_RIGHTS record. This is the common case for replies.
+			 */
+			msghdr * send_msg()
+			{
+				if (_num_sds == 0) {
+					_msg.msg_control    = nullptr;
+					_msg.msg_controllen = 0;
+				}
+				return &_msg;
+			}
+
 			void marshal_socket(Lx_sd sd)
 			{
 				*((int *)CMSG_DATA((cmsghdr *)_cmsg_buf) + _num_sds) = sd.value;
@@ -261,13 +288,14 @@ static inline void lx_reply(Lx_sd reply_socket, Rpc_exception_code exception_cod
 	Protocol_header &header = snd_msgbuf.header<Protocol_header>();
 
 	header.protocol_word = exception_code.value;
+	header.flags         = 0;
 
 	Message msg(header.msg_start(), sizeof(Protocol_header) + snd_msgbuf.data_size());
 
 	/* marshall capabilities to be transferred to the client */
 	insert_sds_into_message(msg, header, snd_msgbuf);
 
-	int const ret = lx_sendmsg(reply_socket, msg.msg(), 0);
+	int const ret = lx_sendmsg(reply_socket, msg.send_msg(), 0);
 
 	/* ignore reply send error caused by disappearing client */
 	if (ret >= 0 || ret == -LX_ECONNREFUSED)
@@ -279,6 +307,488 @@ static inline void lx_reply(Lx_sd reply_socket, Rpc_exception_code exception_cod
 }
 
 
+/**
+ * Receive reply to a call
+ */
+static Rpc_exception_code lx_receive_reply(Lx_sd reply_socket,
+                                           Genode::Msgbuf_base &rcv_msgbuf)
+{
+	Protocol_header &rcv_header = rcv_msgbuf.header<Protocol_header>();
+	rcv_header.protocol_word = 0;
+
+	Message rcv_msg(rcv_header.msg_start(),
+	                sizeof(Protocol_header) + rcv_msgbuf.capacity());
+	rcv_msg.accept_sockets(Message::MAX_SDS_PER_MSG);
+
+	rcv_msgbuf.reset();
+
+	for (;;) {
+		int const recv_ret = lx_recvmsg(reply_socket, rcv_msg.msg(), 0);
+
+		/* system call got interrupted by a signal */
+		if (recv_ret == -LX_EINTR)
+			continue;
+
+		if (recv_ret >= 0)
+			break;
+
+		error(lx_getpid(), ":", lx_gettid(),
+		      " ipc_call failed to receive result (", recv_ret, ")");
+		sleep_forever();
+	}
+
+	extract_sds_from_message(0, rcv_msg, rcv_header, rcv_msgbuf);
+
+	return Rpc_exception_code((int)rcv_header.protocol_word);
+}
+
+
+/***************************************************
+ ** Communication over shared-memory RPC channels **
+ ***************************************************/
+
+using Fast_ipc::Mailbox;
+
+
+/**
+ * List of Unix environment variables, initialized by the startup code
+ */
+extern char **lx_environ;
+
+
+bool Fast_ipc::enabled()
+{
+	enum class State { UNKNOWN, ENABLED, DISABLED };
+
+	static State state = State::UNKNOWN;
+
+	if (state == State::UNKNOWN) {
+		state = State::DISABLED;
+		for (char **curr = lx_environ; curr && *curr; curr++) {
+			Arg arg = Arg_string::find_arg(*curr, "GENODE_RPC_MAILBOX");
+			if (arg.valid() && arg.ulong_value(0))
+				state = State::ENABLED;
+		}
+	}
+
+	return state == State::ENABLED;
+}
+
+
+namespace {
+
+	/**
+	 * Server-side state of a shared-memory channel
+	 */
+	struct Server_channel
+	{
+		Native_thread::Epoll *epoll_ptr = nullptr;   /* nullptr if unused */
+
+		Mailbox *mailbox  = nullptr;
+		Lx_sd    doorbell { -1 };
+		Lx_sd    reply    { -1 };   /* for replies that carry capabilities */
+		int      object   = -1;     /* local socket of the RPC object */
+
+		unsigned long generation = 0;
+		unsigned long last_use   = 0;
+
+		bool processing = false;    /* request dispatched, reply pending */
+	};
+
+
+	/**
+	 * Shared-memory channels served by the entrypoints of the component
+	 *
+	 * The reply capability of a request received via a channel refers to
+	 * the channel by a key that combines the channel index with the
+	 * generation of the channel. Hence, a reply capability that outlives
+	 * its channel is ineffective. The keys never collide with the socket
+	 * descriptors that serve as keys of local RPC objects because the most
+	 * significant bit is set. The registry is global to the component
+	 * because a reply may be issued by a thread other than the entrypoint.
+	 */
+	class Server_channels : Noncopyable
+	{
+		private:
+
+			enum { MAX_CHANNELS = 128, INDEX_BITS = 8 };
+
+			static constexpr addr_t KEY_MARKER =
+				(addr_t)1 << (sizeof(addr_t)*8 - 1);
+
+			static constexpr addr_t GENERATION_MASK =
+				(KEY_MARKER >> (INDEX_BITS + 1)) - 1;
+
+			Mutex _mutex { };
+
+			Server_channel _channels[MAX_CHANNELS] { };
+
+			unsigned long _use_count = 0;
+
+			Rpc_obj_key _key(unsigned index) const
+			{
+				addr_t const generation = _channels[index].generation & GENERATION_MASK;
+
+				return Rpc_obj_key(KEY_MARKER | (generation << INDEX_BITS) | index);
+			}
+
+			Server_channel *_lookup(Rpc_obj_key key)
+			{
+				unsigned const index = key.value() & ((1 << INDEX_BITS) - 1);
+
+				if (index >= MAX_CHANNELS || !_channels[index].epoll_ptr
+				 || _key(index).value() != key.value())
+					return nullptr;
+
+				return &_channels[index];
+			}
+
+			/**
+			 * Return unused channel, evicting an idle channel of 'epoll'
+			 * if needed
+			 */
+			Server_channel *_alloc(Native_thread::Epoll &epoll)
+			{
+				Server_channel *lru_ptr = nullptr;
+
+				for (Server_channel &channel : _channels) {
+
+					if (!channel.epoll_ptr)
+						return &channel;
+
+					if (channel.epoll_ptr != &epoll || channel.processing)
+						continue;
+
+					if (!lru_ptr || channel.last_use < lru_ptr->last_use)
+						lru_ptr = &channel;
+				}
+
+				if (lru_ptr)
+					_release(*lru_ptr);
+
+				return lru_ptr;
+			}
+
+			void _release(Server_channel &channel)
+			{
+				channel.epoll_ptr->remove_doorbell(channel.doorbell);
+
+				/* wake up a client blocking for a reply */
+				channel.mailbox->close();
+
+				lx_munmap(channel.mailbox, Mailbox::SIZE);
+				lx_close(channel.doorbell.value);
+				lx_close(channel.reply.value);
+
+				unsigned long const generation = channel.generation;
+
+				channel = Server_channel();
+				channel.generation = generation + 1;
+			}
+
+		public:
+
+			static bool key_of_channel(Rpc_obj_key key)
+			{
+				return key.valid() && (key.value() & KEY_MARKER);
+			}
+
+			/**
+			 * Register channel set up by a client
+			 *
+			 * \param object  local socket of the invoked RPC object
+			 * \return        true if the channel was accepted, in which
+			 *                case the 'doorbell' is owned by the channel
+			 *
+			 * This method must be called by the polling thread of 'epoll'.
+			 */
+			bool setup(Native_thread::Epoll &epoll, int object,
+			           Lx_sd reply, Lx_sd doorbell, Lx_sd memfd)
+			{
+				/* the mailbox must never shrink while being mapped */
+				int const seals = lx_fcntl_seals(memfd.value, LX_F_GET_SEALS);
+				if (seals < 0 || !(seals & LX_F_SEAL_SHRINK)
+				 || lx_file_size(memfd.value) < Mailbox::SIZE)
+					return false;
+
+				Mutex::Guard guard(_mutex);
+
+				Server_channel * const channel_ptr = _alloc(epoll);
+				if (!channel_ptr)
+					return false;
+
+				Server_channel &channel = *channel_ptr;
+
+				{
+					void * const ptr = lx_mmap(nullptr, Mailbox::SIZE,
+					                           PROT_READ | PROT_WRITE, MAP_SHARED,
+					                           memfd.value, 0);
+					if (((long)ptr < 0) && ((long)ptr > -4095))
+						return false;
+
+					Mailbox &mailbox = *(Mailbox *)ptr;
+
+					int const reply_sd = lx_dup(reply.value);
+
+					if (reply_sd < 0 || !epoll.add_doorbell(doorbell)) {
+						if (reply_sd >= 0)
+							lx_close(reply_sd);
+						lx_munmap(ptr, Mailbox::SIZE);
+						return false;
+					}
+
+					channel.epoll_ptr  = &epoll;
+					channel.mailbox    = &mailbox;
+					channel.doorbell   = doorbell;
+					channel.reply      = Lx_sd { reply_sd };
+					channel.object     = object;
+					channel.last_use   = ++_use_count;
+					channel.processing = false;
+
+					/*
+					 * Tell the client that the channel is accepted. If the
+					 * client messed with the mailbox, the channel is released
+					 * right away, which also closes the doorbell.
+					 */
+					if (!mailbox.transition(Mailbox::SETUP, Mailbox::IDLE))
+						_release(channel);
+
+					return true;
+				}
+			}
+
+			/**
+			 * Obtain request announced via the doorbell 'sd'
+			 *
+			 * \return  false if 'sd' is no doorbell of a channel served by
+			 *          'epoll', true otherwise. A valid request is returned
+			 *          via 'request' only.
+			 */
+			bool receive(Native_thread::Epoll &epoll, Lx_sd sd,
+			             Msgbuf_base &msg, Rpc_request &request)
+			{
+				Mutex::Guard guard(_mutex);
+
+				for (unsigned i = 0; i < MAX_CHANNELS; i++) {
+
+					Server_channel &channel = _channels[i];
+
+					if (channel.epoll_ptr != &epoll || channel.doorbell.value != sd.value)
+						continue;
+
+					Mailbox &mailbox = *channel.mailbox;
+
+					int const state = mailbox.state;
+					memory_barrier();
+
+					/* channel released by the client */
+					if (state == Mailbox::CLOSED) {
+						_release(channel);
+						return true;
+					}
+
+					/* ignore spurious event */
+					if (state != Mailbox::REQUEST || channel.processing)
+						return true;
+
+					msg.reset();
+
+					Protocol_header &header = msg.header<Protocol_header>();
+
+					size_t const size = min((size_t)mailbox.size,
+					                        min(sizeof(mailbox.msg),
+					                            sizeof(Protocol_header) + msg.capacity()));
+
+					Genode::memcpy(header.msg_start(), mailbox.msg, size);
+					header.num_caps = 0;
+
+					channel.processing = true;
+					channel.last_use   = ++_use_count;
+
+					request = Rpc_request(Capability_space::import(Rpc_destination::invalid(),
+					                                               _key(i)),
+					                      channel.object);
+					return true;
+				}
+				return false;
+			}
+
+			/**
+			 * Reply to the request received via the channel with 'key'
+			 */
+			void reply(Rpc_obj_key key, Rpc_exception_code exc, Msgbuf_base &msg)
+			{
+				Mutex::Guard guard(_mutex);
+
+				Server_channel * const channel_ptr = _lookup(key);
+
+				/* the channel vanished or the reply capability is stale */
+				if (!channel_ptr || !channel_ptr->processing)
+					return;
+
+				Server_channel &channel = *channel_ptr;
+				Mailbox        &mailbox = *channel.mailbox;
+
+				channel.processing = false;
+
+				Protocol_header &header = msg.header<Protocol_header>();
+
+				size_t const size = sizeof(Protocol_header) + msg.data_size();
+
+				if (msg.used_caps() == 0 && size <= sizeof(mailbox.msg)) {
+
+					header.protocol_word = exc.value;
+					header.num_caps      = 0;
+					header.flags         = 0;
+
+					Genode::memcpy(mailbox.msg, header.msg_start(), size);
+					mailbox.size = (unsigned)size;
+
+					if (mailbox.transition(Mailbox::REQUEST, Mailbox::REPLY))
+						mailbox.wake();
+					return;
+				}
+
+				/* capabilities can be delegated via the socket path only */
+				lx_reply(channel.reply, exc, msg);
+
+				if (mailbox.transition(Mailbox::REQUEST, Mailbox::SOCKET_REPLY))
+					mailbox.wake();
+			}
+
+			/**
+			 * Release channels to 'object', or all channels if invalid
+			 *
+			 * This method must be called by the polling thread of 'epoll'.
+			 */
+			void release(Native_thread::Epoll &epoll, Lx_sd object)
+			{
+				Mutex::Guard guard(_mutex);
+
+				for (Server_channel &channel : _channels)
+					if (channel.epoll_ptr == &epoll
+					 && (!object.valid() || channel.object == object.value))
+						_release(channel);
+			}
+	};
+
+
+	Server_channels &server_channels()
+	{
+		static Server_channels channels { };
+		return channels;
+	}
+}
+
+
+void Native_thread::Epoll::release_fast_channels(Lx_sd object)
+{
+	server_channels().release(*this, object);
+}
+
+
+/**
+ * Create client-side resources of a shared-memory channel
+ */
+static bool create_fast_channel(Fast_ipc::Client_channel &channel)
+{
+	int const memfd = lx_memfd_create("rpc_mailbox", LX_MFD_CLOEXEC
+	                                               | LX_MFD_ALLOW_SEALING);
+	if (memfd < 0)
+		return false;
+
+	channel.memfd = Lx_sd { memfd };
+
+	int const seals = LX_F_SEAL_SHRINK | LX_F_SEAL_GROW | LX_F_SEAL_SEAL;
+
+	if (lx_ftruncate(memfd, Mailbox::SIZE) != 0
+	 || lx_fcntl_seals(memfd, LX_F_ADD_SEALS, seals) != 0) {
+		channel.close();
+		return false;
+	}
+
+	void * const ptr = lx_mmap(nullptr, Mailbox::SIZE, PROT_READ | PROT_WRITE,
+	                           MAP_SHARED, memfd, 0);
+	if (((long)ptr < 0) && ((long)ptr > -4095)) {
+		channel.close();
+		return false;
+	}
+
+	channel.mailbox = (Mailbox *)ptr;
+	channel.mailbox->state = Mailbox::SETUP;
+
+	int const doorbell = lx_eventfd();
+	if (doorbell < 0) {
+		channel.close();
+		return false;
+	}
+
+	channel.doorbell = Lx_sd { doorbell };
+	channel.reply.construct();
+	return true;
+}
+
+
+/**
+ * Perform call via a shared-memory channel
+ *
+ * \return  false if the server released the channel without processing
+ *          the request
+ */
+static bool fast_call(Fast_ipc::Client_channel &channel,
+                      Msgbuf_base &snd_msgbuf, Msgbuf_base &rcv_msgbuf,
+                      Rpc_exception_code &exc)
+{
+	Mailbox &mailbox = *channel.mailbox;
+
+	Protocol_header &snd_header = snd_msgbuf.header<Protocol_header>();
+
+	size_t const snd_size = sizeof(Protocol_header) + snd_msgbuf.data_size();
+
+	Genode::memcpy(mailbox.msg, snd_header.msg_start(), snd_size);
+	mailbox.size = (unsigned)snd_size;
+
+	/*
+	 * A channel closed by the server, e.g., evicted in favour of another
+	 * client, is set up anew by the next call.
+	 */
+	if (!mailbox.transition(Mailbox::IDLE, Mailbox::REQUEST)) {
+		channel.close();
+		return false;
+	}
+
+	channel.ring_doorbell();
+
+	mailbox.wait_while(Mailbox::REQUEST);
+
+	if (mailbox.transition(Mailbox::SOCKET_REPLY, Mailbox::IDLE)) {
+		exc = lx_receive_reply(channel.reply->local, rcv_msgbuf);
+		return true;
+	}
+
+	if (mailbox.state != Mailbox::REPLY) {
+		channel.close();
+		return false;
+	}
+
+	rcv_msgbuf.reset();
+
+	Protocol_header &rcv_header = rcv_msgbuf.header<Protocol_header>();
+
+	size_t const rcv_size = min((size_t)mailbox.size,
+	                            min(sizeof(mailbox.msg),
+	                                sizeof(Protocol_header) + rcv_msgbuf.capacity()));
+
+	Genode::memcpy(rcv_header.msg_start(), mailbox.msg, rcv_size);
+	rcv_header.num_caps = 0;
+
+	mailbox.transition(Mailbox::REPLY, Mailbox::IDLE);
+
+	exc = Rpc_exception_code((int)rcv_header.protocol_word);
+	return true;
+}
+
+
 /****************
  ** IPC client **
  ****************/
@@ -294,69 +804,114 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 
 	Protocol_header &snd_header = snd_msgbuf.header<Protocol_header>();
 	snd_header.protocol_word = 0;
+	snd_header.flags         = 0;
+
+	size_t const snd_size = sizeof(Protocol_header) + snd_msgbuf.data_size();
+
+	Lx_sd    const dst_socket = Capability_space::ipc_cap_data(dst).dst.socket;
+	uint64_t const recipient  = dst_socket.inode();
 
-	Message snd_msg(snd_header.msg_start(),
-	                sizeof(Protocol_header) + snd_msgbuf.data_size());
+	Thread * const myself_ptr = Thread::myself();
+
+	Native_thread * const nt_ptr = myself_ptr
+		? myself_ptr->with_native_thread(
+			[&] (Native_thread &nt) { return &nt; },
+			[&] () -> Native_thread * { return nullptr; })
+		: nullptr;
 
 	/*
-	 * Create reply channel
+	 * If enabled, capability-free calls of threads equipped with a
+	 * 'Native_thread' are passed via a shared-memory channel to the
+	 * recipient. The channel is set up along with the first call via the
+	 * socket path.
+	 */
+	Fast_ipc::Client_channel *fast_channel_ptr = nullptr;
+
+	if (nt_ptr && snd_msgbuf.used_caps() == 0 && snd_size <= sizeof(Mailbox::msg)
+	 && Fast_ipc::enabled())
+		fast_channel_ptr = nt_ptr->fast_ipc_channels.channel(recipient);
+
+	if (fast_channel_ptr && fast_channel_ptr->active()) {
+
+		Rpc_exception_code exc { Rpc_exception_code::SUCCESS };
+
+		if (fast_call(*fast_channel_ptr, snd_msgbuf, rcv_msgbuf, exc))
+			return exc;
+	}
+
+	Fast_ipc::Client_channel *setup_ptr = nullptr;
+
+	if (fast_channel_ptr && !fast_channel_ptr->refused && !fast_channel_ptr->mailbox) {
+		if (create_fast_channel(*fast_channel_ptr))
+			setup_ptr = fast_channel_ptr;
+		else
+			fast_channel_ptr->refuse();
+	}
+
+	/*
+	 * Select reply channel
 	 *
-	 * The reply channel will be closed when leaving the scope of 'lx_call'.
+	 * Threads equipped with a 'Native_thread' reuse their long-lived reply
+	 * channel for consecutive calls to the same recipient. Otherwise, a
+	 * temporary channel is created, which is closed when leaving the scope
+	 * of 'ipc_call'. The setup of a shared-memory channel uses the reply
+	 * socket pair of the new channel.
 	 */
-	struct Reply_channel : Lx_socketpair
+	struct Temporary_reply_channel : Lx_socketpair
 	{
-		~Reply_channel()
+		~Temporary_reply_channel()
 		{
 			if (local.value  != -1) lx_close(local.value);
 			if (remote.value != -1) lx_close(remote.value);
 		}
-	} reply_channel;
+	};
+
+	Constructible<Temporary_reply_channel> temporary_reply_channel { };
+
+	Lx_socketpair const *reply_channel_ptr = nullptr;
+
+	if (setup_ptr)
+		reply_channel_ptr = &*setup_ptr->reply;
+	else if (nt_ptr)
+		reply_channel_ptr = &nt_ptr->reply_channel.socketpair(recipient);
+
+	if (!reply_channel_ptr) {
+		temporary_reply_channel.construct();
+		reply_channel_ptr = &*temporary_reply_channel;
+	}
+
+	Lx_socketpair const &reply_channel = *reply_channel_ptr;
 
 	/* assemble message */
 
+	Message snd_msg(snd_header.msg_start(), snd_size);
+
 	/* marshal reply capability */
 	snd_msg.marshal_socket(reply_channel.remote);
 
+	/* marshal doorbell and mailbox of a new shared-memory channel */
+	if (setup_ptr) {
+		snd_header.flags = Protocol_header::SETUP_FAST_CHANNEL;
+		snd_msg.marshal_socket(setup_ptr->doorbell);
+		snd_msg.marshal_socket(setup_ptr->memfd);
+	}
+
 	/* marshal capabilities contained in 'snd_msgbuf' */
 	insert_sds_into_message(snd_msg, snd_header, snd_msgbuf);
 
-	Lx_sd const dst_socket = Capability_space::ipc_cap_data(dst).dst.socket;
-
-	int const send_ret = lx_sendmsg(dst_socket, snd_msg.msg(), 0);
+	int const send_ret = lx_sendmsg(dst_socket, snd_msg.send_msg(), 0);
 	if (send_ret < 0) {
 		error(lx_getpid(), ":", lx_gettid(), " lx_sendmsg to sd ", dst_socket,
 		      " failed with ", send_ret, " in lx_call()");
 		sleep_forever();
 	}
 
-	/* receive reply */
-	Protocol_header &rcv_header = rcv_msgbuf.header<Protocol_header>();
-	rcv_header.protocol_word = 0;
-
-	Message rcv_msg(rcv_header.msg_start(),
-	                sizeof(Protocol_header) + rcv_msgbuf.capacity());
-	rcv_msg.accept_sockets(Message::MAX_SDS_PER_MSG);
-
-	rcv_msgbuf.reset();
-
-	for (;;) {
-		int const recv_ret = lx_recvmsg(reply_channel.local, rcv_msg.msg(), 0);
+	Rpc_exception_code const exc = lx_receive_reply(reply_channel.local, rcv_msgbuf);
 
-		/* system call got interrupted by a signal */
-		if (recv_ret == -LX_EINTR)
-			continue;
-
-		if (recv_ret >= 0)
-			break;
+	if (setup_ptr)
+		setup_ptr->complete_setup();
 
-		error(lx_getpid(), ":", lx_gettid(),
-		      " ipc_call failed to receive result (", recv_ret, ")");
-		sleep_forever();
-	}
-
-	extract_sds_from_message(0, rcv_msg, rcv_header, rcv_msgbuf);
-
-	return Rpc_exception_code((int)rcv_header.protocol_word);
+	return exc;
 }
 
 
@@ -364,12 +919,25 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
  ** IPC server **
  ****************/
 
+/**
+ * Send reply to a caller of the socket path or of a shared-memory channel
+ */
+static void reply_to_caller(Native_capability caller, Rpc_exception_code exc,
+                            Msgbuf_base &snd_msg)
+{
+	Capability_space::Ipc_cap_data const data = Capability_space::ipc_cap_data(caller);
+
+	if (!data.dst.socket.valid() && Server_channels::key_of_channel(data.rpc_obj_key))
+		server_channels().reply(data.rpc_obj_key, exc, snd_msg);
+	else
+		lx_reply(data.dst.socket, exc, snd_msg);
+}
+
+
 void Genode::ipc_reply(Native_capability caller, Rpc_exception_code exc,
                        Msgbuf_base &snd_msg)
 {
-	Lx_sd const reply_socket = Capability_space::ipc_cap_data(caller).dst.socket;
-
-	lx_reply(reply_socket, exc, snd_msg);
+	reply_to_caller(caller, exc, snd_msg);
 }
 
 
@@ -380,7 +948,7 @@ Rpc_request Genode::ipc_reply_wait(Reply_capability const &last_caller,
 {
 	/* when first called, there was no request yet */
 	if (last_caller.valid() && exc.value != Rpc_exception_code::INVALID_OBJECT)
-		lx_reply(Capability_space::ipc_cap_data(last_caller).dst.socket, exc, reply_msg);
+		reply_to_caller(last_caller, exc, reply_msg);
 
 	/*
 	 * Block infinitely if called from the main thread. This may happen if the
@@ -398,6 +966,14 @@ Rpc_request Genode::ipc_reply_wait(Reply_capability const &last_caller,
 
 			Lx_sd const selected_sd = nt.epoll.poll();
 
+			/* request announced via the doorbell of a shared-memory channel */
+			Rpc_request fast_request { };
+			if (server_channels().receive(nt.epoll, selected_sd, request_msg, fast_request)) {
+				if (fast_request.caller.valid())
+					return fast_request;
+				continue;
+			}
+
 			Protocol_header &header = request_msg.header<Protocol_header>();
 			Message msg(header.msg_start(), sizeof(Protocol_header) + request_msg.capacity());
 
@@ -416,6 +992,23 @@ Rpc_request Genode::ipc_reply_wait(Reply_capability const &last_caller,
 
 			Lx_sd const reply_socket = msg.socket_at_index(0);
 
+			if (header.flags == Protocol_header::SETUP_FAST_CHANNEL) {
+
+				bool accepted = false;
+
+				if (Fast_ipc::enabled() && header.num_caps == 0 && msg.num_sockets() == 3)
+					accepted = server_channels().setup(nt.epoll, selected_sd.value,
+					                                   reply_socket,
+					                                   msg.socket_at_index(1),
+					                                   msg.socket_at_index(2));
+
+				/* close the sockets not owned by the channel */
+				for (unsigned i = accepted ? 2 : 1; i < msg.num_sockets(); i++)
+					lx_close(msg.socket_at_index(i).value);
+
+				header.num_caps = 0;
+			}
+
 			/* start at offset 1 to skip the reply channel */
 			extract_sds_from_message(1, msg, header, request_msg);
 
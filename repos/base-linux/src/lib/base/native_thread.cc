@@ -30,6 +30,8 @@ Native_thread::Epoll::Epoll()
 
 Native_thread::Epoll::~Epoll()
 {
+	release_fast_channels(Lx_sd::invalid());
+
 	_remove(_control.local);
 
 	lx_close(_control.local.value);
@@ -65,6 +67,21 @@ void Native_thread::Epoll::_remove(Lx_sd sd)
 }
 
 
+bool Native_thread::Epoll::add_doorbell(Lx_sd sd)
+{
+	/*
+	 * The doorbell is an eventfd provided by the client. It is registered
+	 * as edge-triggered because each write by the client raises an event
+	 * anyway. So the counter need not be drained, and a bogus descriptor
+	 * passed by a misbehaving client cannot keep 'poll' busy.
+	 */
+	epoll_event event;
+	event.events = EPOLLIN | EPOLLET;
+	event.data.fd = sd.value;
+	return lx_epoll_ctl(_epoll, EPOLL_CTL_ADD, sd, &event) == 0;
+}
+
+
 Lx_sd Native_thread::Epoll::poll()
 {
 	for (;;) {
@@ -202,5 +219,8 @@ void Native_thread::Epoll::free_rpc_cap(Native_capability cap)
 {
 	int const local_socket = (int)Capability_space::ipc_cap_data(cap).rpc_obj_key.value();
 
-	_exec_control([&] { _remove(Lx_sd{local_socket}); });
+	_exec_control([&] {
+		_remove(Lx_sd{local_socket});
+		release_fast_channels(Lx_sd{local_socket});
+	});
 }
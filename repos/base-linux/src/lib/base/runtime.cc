@@ -23,6 +23,7 @@
 #include <base/internal/native_thread.h>
 #include <base/internal/parent_socket_handle.h>
 #include <base/internal/capability_space_tpl.h>
+#include <base/internal/fast_ipc.h>
 
 using namespace Genode;
 
@@ -178,6 +179,10 @@ Runtime &Genode::init_runtime()
 extern char _binary_seccomp_bpf_policy_bin_start[];
 extern char _binary_seccomp_bpf_policy_bin_end[];
 
+/* policy that additionally permits the shared-memory RPC path */
+extern char _binary_seccomp_bpf_policy_rpc_mailbox_bin_start[];
+extern char _binary_seccomp_bpf_policy_rpc_mailbox_bin_end[];
+
 
 void Genode::binary_ready_hook_for_platform()
 {
@@ -192,12 +197,19 @@ void Genode::binary_ready_hook_for_platform()
 		uint64_t *blks;
 	};
 
-	size_t _binary_seccomp_bpf_policy_bin_size =
-		_binary_seccomp_bpf_policy_bin_end - _binary_seccomp_bpf_policy_bin_start;
+	bool const rpc_mailbox = Fast_ipc::enabled();
+
+	char * const policy_start = rpc_mailbox
+	                          ? _binary_seccomp_bpf_policy_rpc_mailbox_bin_start
+	                          : _binary_seccomp_bpf_policy_bin_start;
+	char * const policy_end   = rpc_mailbox
+	                          ? _binary_seccomp_bpf_policy_rpc_mailbox_bin_end
+	                          : _binary_seccomp_bpf_policy_bin_end;
+
+	size_t const policy_size = policy_end - policy_start;
 
-	for (char* i = _binary_seccomp_bpf_policy_bin_start;
-	     i < &_binary_seccomp_bpf_policy_bin_start[_binary_seccomp_bpf_policy_bin_size -
-	                                               sizeof(uint32_t)]; i++) {
+	for (char* i = policy_start;
+	     i < &policy_start[policy_size - sizeof(uint32_t)]; i++) {
 
 		uint32_t *v = reinterpret_cast<uint32_t *>(i);
 		if (*v == 0xCAFEAFFE) {
@@ -206,9 +218,8 @@ void Genode::binary_ready_hook_for_platform()
 	}
 
 	Bpf_program program {
-		.blk_cnt = (uint16_t)(_binary_seccomp_bpf_policy_bin_size /
-		                      sizeof(uint64_t)),
-		.blks = (uint64_t *)_binary_seccomp_bpf_policy_bin_start
+		.blk_cnt = (uint16_t)(policy_size / sizeof(uint64_t)),
+		.blks = (uint64_t *)policy_start
 	};
 
 	uint64_t flags = SECCOMP_FILTER_FLAG_TSYNC;
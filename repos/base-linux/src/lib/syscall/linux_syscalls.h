@@ -101,6 +101,12 @@ inline int lx_write(int fd, const void *buf, Genode::size_t count)
 }
 
 
+inline int lx_read(int fd, void *buf, Genode::size_t count)
+{
+	return (int)lx_syscall(SYS_read, fd, buf, count);
+}
+
+
 inline int lx_close(int fd)
 {
 	return (int)lx_syscall(SYS_close, fd);
@@ -300,6 +306,72 @@ inline int lx_munmap(void *addr, Genode::size_t length)
 }
 
 
+/******************************************************************
+ ** Functions used by core and the shared-memory path of the IPC **
+ ******************************************************************/
+
+/* defined in linux/memfd.h */
+enum { LX_MFD_CLOEXEC = 0x1U, LX_MFD_ALLOW_SEALING = 0x2U };
+
+/* defined in linux/fcntl.h */
+enum {
+	LX_F_ADD_SEALS   = 1033,
+	LX_F_GET_SEALS   = 1034,
+	LX_F_SEAL_SEAL   = 0x1,
+	LX_F_SEAL_SHRINK = 0x2,
+	LX_F_SEAL_GROW   = 0x4,
+};
+
+
+inline int lx_memfd_create(char const *name, unsigned flags)
+{
+	return (int)lx_syscall(SYS_memfd_create, name, flags);
+}
+
+
+inline int lx_ftruncate(int fd, unsigned long length)
+{
+	return (int)lx_syscall(SYS_ftruncate, fd, length);
+}
+
+
+/**
+ * Add seals to or query the seals of a memfd
+ *
+ * The seccomp policy of non-core components permits 'fcntl' only for
+ * 'LX_F_ADD_SEALS' and 'LX_F_GET_SEALS'.
+ */
+inline int lx_fcntl_seals(int fd, int cmd, int seals = 0)
+{
+#ifdef __NR_fcntl64
+	return (int)lx_syscall(SYS_fcntl64, fd, cmd, seals);
+#else
+	return (int)lx_syscall(SYS_fcntl, fd, cmd, seals);
+#endif /* __NR_fcntl64 */
+}
+
+
+inline Genode::uint64_t lx_file_size(int fd)
+{
+#ifdef __NR_fstat64
+	struct stat64 statbuf { };
+	if (lx_syscall(SYS_fstat64, fd, &statbuf) < 0)
+		return 0;
+#else
+	struct stat statbuf { };
+	if (lx_syscall(SYS_fstat, fd, &statbuf) < 0)
+		return 0;
+#endif /* __NR_fstat64 */
+	return (Genode::uint64_t)statbuf.st_size;
+}
+
+
+inline int lx_eventfd()
+{
+	return (int)lx_syscall(SYS_eventfd2, 0, LX_O_CLOEXEC);
+}
+
+
 /***********************************************************************
  ** Functions used by thread lib and core's cancel-blocking mechanism **
  ***********************************************************************/
@@ -32,6 +32,7 @@ namespace Genode {
 	class Time_source;
 	class Timeout;
 	class Timeout_handler;
+	class Timeout_wheel;
 	class Timeout_scheduler;
 }
 
@@ -85,14 +86,17 @@ struct Genode::Time_source : Interface
  * example, in a Timer-session server. If this is not the case, the classes
  * Periodic_timeout and One_shot_timeout are the better choice.
  */
-class Genode::Timeout : private Noncopyable,
-                        public Genode::List<Timeout>::Element
+class Genode::Timeout : private Noncopyable
 {
 	friend class Timeout_scheduler;
+	friend class Timeout_wheel;
 
 	private:
 
 		Mutex                  _mutex               { };
+		Timeout               *_wheel_next          { nullptr };
+		Timeout               *_wheel_prev          { nullptr };
+		unsigned               _wheel_slot          { ~0U };
 		Timeout_scheduler     &_scheduler;
 		Microseconds           _period              { 0 };
 		Microseconds           _deadline            { Microseconds { 0 } };
@@ -128,6 +132,140 @@ class Genode::Timeout : private Noncopyable,
 };
 
 
+/**
+ * Hierarchical timing wheel of scheduled timeouts
+ *
+ * The wheel consists of 'LEVELS' arrays of 'SLOTS' slots each. The slots of
+ * level 0 span one microsecond each, the slots of each further level span
+ * all slots of the level below. A timeout is filed into the lowest level at
+ * which its deadline can be told apart from the current time of the wheel.
+ * Hence, inserting and removing a timeout takes constant time. When the
+ * wheel advances, the timeouts of the next slot of a higher level are
+ * redistributed to the lower levels, which happens at most 'LEVELS - 1'
+ * times for each timeout. The top level wraps around, so it also takes
+ * deadlines beyond the next carry of the current time. Timeouts beyond the
+ * range of the wheel are kept in an overflow list, which is consulted only
+ * once its earliest deadline comes into range.
+ *
+ * The wheel is not synchronized. It is protected by the mutex of the
+ * timeout scheduler.
+ */
+class Genode::Timeout_wheel : private Noncopyable
+{
+	private:
+
+		enum : unsigned {
+			SLOT_BITS  = 6,
+			SLOTS      = 1 << SLOT_BITS,
+			LEVELS     = 6,
+			RANGE_BITS = SLOT_BITS*LEVELS,
+			TOP_BITS   = SLOT_BITS*(LEVELS - 1),
+			OVERFLOW   = SLOTS*LEVELS,
+			NONE       = ~0U,
+		};
+
+		/*
+		 * Distance from the current time within which any deadline fits
+		 * into the wheel
+		 */
+		static constexpr uint64_t WINDOW_US = (uint64_t)(SLOTS - 1) << TOP_BITS;
+
+		uint64_t  _time                       { 0 };
+		Timeout  *_slots[LEVELS*SLOTS + 1]    { };
+		uint64_t  _occupied[LEVELS]           { };
+		unsigned  _occupied_levels            { 0 };
+
+		/*
+		 * Lower bound of the deadlines in the overflow list
+		 */
+		uint64_t  _overflow_min_us            { ~(uint64_t)0 };
+
+		static unsigned _index(unsigned level, uint64_t time_us) {
+			return (unsigned)(time_us >> (SLOT_BITS*level)) & (SLOTS - 1); }
+
+		/**
+		 * Return level to file a timeout with deadline 'deadline_us'
+		 *
+		 * eturn  'LEVELS' if the deadline is beyond the wheel range
+		 */
+		unsigned _level(uint64_t deadline_us) const;
+
+		/**
+		 * Return time at which slot 'slot' of level 'level' becomes due
+		 */
+		uint64_t _slot_start(unsigned level, unsigned slot) const;
+
+		void _link(Timeout &timeout, unsigned index);
+
+		void _unlink(Timeout &timeout);
+
+		/**
+		 * Return lowest occupied level, or 'LEVELS' if the wheel is empty
+		 */
+		unsigned _first_level() const {
+			return _occupied_levels ? (unsigned)__builtin_ctz(_occupied_levels) : LEVELS; }
+
+		/**
+		 * Return first occupied slot of 'level' at or after the current time
+		 */
+		unsigned _first_slot(unsigned level) const;
+
+		bool _overflow_in_range() const
+		{
+			return _slots[OVERFLOW] && (_overflow_min_us <= _time
+			                         || _overflow_min_us - _time < WINDOW_US);
+		}
+
+		/**
+		 * Move timeouts of the overflow list that came into range
+		 */
+		void _refill_from_overflow();
+
+		Timeout_wheel(Timeout_wheel const &);
+
+		Timeout_wheel &operator = (Timeout_wheel const &);
+
+	public:
+
+		Timeout_wheel() { }
+
+		/**
+		 * Advance current time of the wheel towards 'now_us'
+		 *
+		 * The time does not pass the earliest occupied slot, which is
+		 * left to 'remove_expired'.
+		 */
+		void advance(uint64_t now_us);
+
+		void insert(Timeout &timeout);
+
+		/**
+		 * Remove timeout from the wheel, if contained
+		 */
+		void remove(Timeout &timeout);
+
+		/**
+		 * Return any timeout of the wheel, or nullptr if empty
+		 */
+		Timeout *first();
+
+		/**
+		 * Return earliest deadline of the timeouts
+		 *
+		 * For timeouts in the overflow list, the returned time may be
+		 * earlier than the actual deadline.
+		 */
+		uint64_t next_event_us() const;
+
+		/**
+		 * Remove one timeout whose deadline is not later than 'now_us'
+		 *
+		 * \return  removed timeout, or nullptr if no timeout is due
+		 */
+		Timeout *remove_expired(uint64_t now_us);
+};
+
+
 /**
  * Multiplexes one time source amongst different timeouts
  */
@@ -145,13 +283,13 @@ class Genode::Timeout_scheduler : private Noncopyable,
 		Mutex               _mutex              { };
 		Time_source        &_time_source;
 		Microseconds const  _max_sleep_time     { min(_time_source.max_timeout().value, max_sleep_time_us) };
-		List<Timeout>       _timeouts           { };
+		Timeout_wheel       _timeouts           { };
+		uint64_t            _next_event_us      { ~(uint64_t)0 };
 		Microseconds        _current_time       { 0 };
 		bool                _destructor_called  { false };
 		Microseconds        _rate_limit_period;
 		Microseconds        _rate_limit_deadline;
 
-		void _insert_into_timeouts_list(Timeout &timeout);
 
 		void _set_time_source_timeout();
 
@@ -230,10 +230,11 @@ CXX_LINK_OPT       += $(addprefix $(LD_OPT_PREFIX),$(LD_OPT))
 CXX_LINK_OPT       += $(LD_OPT_NOSTDLIB)
 
 #
-# Genode linker does not support .gnu.hash so there is no point in having it
-# in the ELF files. Tell the linker to only produce SysV hash tables.
+# Genode's dynamic linker prefers the GNU hash table for symbol lookups. The
+# SysV hash table is retained for tools and for lookups of undefined symbols,
+# which are not part of the GNU hash table.
 #
-LD_OPT += --hash-style=sysv
+LD_OPT += --hash-style=both
 
 #
 # Linker script for dynamically linked programs
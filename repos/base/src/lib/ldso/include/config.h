@@ -35,6 +35,13 @@ class Linker::Config : Noncopyable
 		bool const check_ctors  = _config.node().attribute_value("ld_check_ctors", true);
 		bool const generate_xml = _config.node().attribute_value("generate_xml",   false);
 
+		/* number of entries of the symbol-lookup cache, 0 disables the cache */
+		unsigned const symbol_cache = _config.node().attribute_value("ld_symbol_cache", 256U);
+
+		/* memory used for snapshots of relocated RW segments, 0 disables them */
+		size_t const rw_snapshots = _config.node().attribute_value("ld_rw_snapshots",
+		                                                           Number_of_bytes(0));
+
 		Config(Env &env) : _config(env, "config") { }
 
 		using Rom_name = String<100>;
@@ -20,6 +20,8 @@
 
 namespace Linker {
 	struct Hash_table;
+	struct Gnu_hash_table;
+	class  Symbol_hash;
 	struct Dynamic;
 }
 
@@ -53,6 +55,143 @@ struct Linker::Hash_table
 };
 
 
+/**
+ * GNU hash table (DT_GNU_HASH)
+ *
+ * The table starts with a Bloom filter that rejects most lookups of symbols
+ * not defined by the object without touching the hash chains. Only the
+ * symbols starting at 'symoffset' are part of the table. The chain array
+ * stores the hash value of each of those symbols with the least-significant
+ * bit marking the end of a chain.
+ */
+struct Linker::Gnu_hash_table
+{
+	enum { BLOOM_BITS = sizeof(Elf::Addr)*8 };
+
+	uint32_t const *_words() const { return (uint32_t const *)this; }
+
+	uint32_t nbuckets()    const { return _words()[0]; }
+	uint32_t symoffset()   const { return _words()[1]; }
+	uint32_t bloom_size()  const { return _words()[2]; }
+	uint32_t bloom_shift() const { return _words()[3]; }
+
+	Elf::Addr const *bloom()   const { return (Elf::Addr const *)(_words() + 4); }
+	uint32_t  const *buckets() const { return (uint32_t const *)(bloom() + bloom_size()); }
+	uint32_t  const *chains()  const { return buckets() + nbuckets(); }
+
+	/**
+	 * GNU hash function (Bernstein)
+	 */
+	static uint32_t hash(char const *name)
+	{
+		uint32_t h = 5381;
+		for (unsigned char const *p = (unsigned char const *)name; *p; p++)
+			h = (h << 5) + h + *p;
+
+		return h;
+	}
+
+	/**
+	 * Return false if the object definitely lacks a symbol of given hash
+	 */
+	bool may_contain(uint32_t hash) const
+	{
+		if (!nbuckets() || !bloom_size())
+			return false;
+
+		Elf::Addr const word = bloom()[(hash / BLOOM_BITS) % bloom_size()];
+		Elf::Addr const mask = (Elf::Addr(1) << (hash % BLOOM_BITS))
+		                     | (Elf::Addr(1) << ((hash >> bloom_shift()) % BLOOM_BITS));
+
+		return (word & mask) == mask;
+	}
+
+	/**
+	 * Return index of first symbol of the chain for given hash
+	 *
+	 * \return STN_UNDEF if the chain is empty
+	 */
+	unsigned first(uint32_t hash) const
+	{
+		unsigned const sym_index = buckets()[hash % nbuckets()];
+		return sym_index < symoffset() ? (unsigned)STN_UNDEF : sym_index;
+	}
+
+	/**
+	 * Return true if the symbol's hash matches the hash looked for
+	 */
+	bool matches(unsigned sym_index, uint32_t hash) const
+	{
+		return ((chains()[sym_index - symoffset()] ^ hash) >> 1) == 0;
+	}
+
+	/**
+	 * Return true if the symbol is the last one of its chain
+	 */
+	bool last(unsigned sym_index) const
+	{
+		return chains()[sym_index - symoffset()] & 1;
+	}
+
+	/**
+	 * Number of symbol-table entries
+	 *
+	 * The GNU hash table does not state the size of the symbol table.
+	 * It is given by the end of the chain of the highest symbol index.
+	 */
+	unsigned num_symbols() const
+	{
+		unsigned max_index = 0;
+		for (unsigned i = 0; i < nbuckets(); i++)
+			if (buckets()[i] > max_index)
+				max_index = buckets()[i];
+
+		if (max_index < symoffset())
+			return symoffset();
+
+		while (!last(max_index))
+			max_index++;
+
+		return max_index + 1;
+	}
+};
+
+
+/**
+ * Hash values of a symbol name
+ *
+ * The SysV hash is computed on demand only, which is needed for objects
+ * that lack a GNU hash table.
+ */
+class Linker::Symbol_hash
+{
+	private:
+
+		char const *_name;
+
+		uint32_t const _gnu;
+
+		mutable unsigned long _sysv       = 0;
+		mutable bool          _sysv_valid = false;
+
+	public:
+
+		Symbol_hash(char const *name)
+		: _name(name), _gnu(Gnu_hash_table::hash(name)) { }
+
+		uint32_t gnu() const { return _gnu; }
+
+		unsigned long sysv() const
+		{
+			if (!_sysv_valid) {
+				_sysv       = Hash_table::hash(_name);
+				_sysv_valid = true;
+			}
+			return _sysv;
+		}
+};
+
+
 /**
  * .dynamic section entries
  */
@@ -93,7 +232,9 @@ class Linker::Dynamic
 
 		Allocator           *_md_alloc      = nullptr;
 
-		Hash_table          *_hash_table    = nullptr;
+		Hash_table          *_hash_table     = nullptr;
+		Gnu_hash_table      *_gnu_hash_table = nullptr;
+		unsigned             _num_symbols    = 0;
 
 		Elf::Rela           *_reloca        = nullptr;
 		unsigned long        _reloca_size   = 0;
@@ -158,6 +299,7 @@ class Linker::Dynamic
 				case DT_PLTRELSZ: _pltrel_size = d->un.val;                             break;
 				case DT_PLTGOT  : _section<typeof(_pltgot)>(&_pltgot, d);               break;
 				case DT_HASH    : _section<typeof(_hash_table)>(&_hash_table, d);       break;
+				case DT_GNU_HASH: _section<typeof(_gnu_hash_table)>(&_gnu_hash_table, d); break;
 				case DT_RELA    : _section<typeof(_reloca)>(&_reloca, d);               break;
 				case DT_RELASZ  : _reloca_size = d->un.val;                             break;
 				case DT_SYMTAB  : _section<typeof(_symtab)>(&_symtab, d);               break;
@@ -173,6 +315,80 @@ class Linker::Dynamic
 					break;
 				}
 			}
+
+			if (_hash_table)
+				_num_symbols = (unsigned)_hash_table->nchains();
+			else if (_gnu_hash_table)
+				_num_symbols = _gnu_hash_table->num_symbols();
+		}
+
+		/**
+		 * Return symbol if it is a candidate for the symbol looked up
+		 */
+		Elf::Sym const *_match(unsigned sym_index, char const *name) const
+		{
+			Elf::Sym const *sym      = _symtab + sym_index;
+			char const     *sym_name = symbol_name(*sym);
+
+			/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
+			if (sym->type() > STT_FUNC)
+				return nullptr;
+
+			if (sym->st_value == 0)
+				return nullptr;
+
+			/* check for symbol name */
+			if (name[0] != sym_name[0] || strcmp(name, sym_name))
+				return nullptr;
+
+			return sym;
+		}
+
+		Elf::Sym const *_lookup_gnu(char const *name, uint32_t hash) const
+		{
+			Gnu_hash_table const &h = *_gnu_hash_table;
+
+			if (!h.may_contain(hash))
+				return nullptr;
+
+			/* traverse hash chain */
+			for (unsigned sym_index = h.first(hash); sym_index != STN_UNDEF; sym_index++) {
+
+				/* bad object */
+				if (sym_index >= _num_symbols)
+					return nullptr;
+
+				if (h.matches(sym_index, hash))
+					if (Elf::Sym const *sym = _match(sym_index, name))
+						return sym;
+
+				if (h.last(sym_index))
+					break;
+			}
+			return nullptr;
+		}
+
+		Elf::Sym const *_lookup_sysv(char const *name, unsigned long hash) const
+		{
+			Hash_table *h = _hash_table;
+
+			if (!h->nbuckets())
+				return nullptr;
+
+			unsigned sym_index = h->buckets()[hash % h->nbuckets()];
+
+			/* traverse hash chain */
+			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
+			{
+				/* bad object */
+				if (sym_index >= h->nchains())
+					return nullptr;
+
+				if (Elf::Sym const *sym = _match(sym_index, name))
+					return sym;
+			}
+
+			return nullptr;
 		}
 
 	public:
@@ -216,7 +432,7 @@ class Linker::Dynamic
 
 		Elf::Sym const *symbol(unsigned sym_index) const
 		{
-			if (sym_index > _hash_table->nchains())
+			if (sym_index >= _num_symbols)
 				return nullptr;
 
 			return _symtab + sym_index;
@@ -237,43 +453,29 @@ class Linker::Dynamic
 		 * Use DT_HASH table address for linker, assuming that it will always be at
 		 * the beginning of the file
 		 */
-		Elf::Addr link_map_addr() const { return trunc_page((Elf::Addr)_hash_table); }
+		Elf::Addr link_map_addr() const
+		{
+			return trunc_page(_hash_table ? (Elf::Addr)_hash_table
+			                              : (Elf::Addr)_gnu_hash_table);
+		}
 
 		/**
 		 * Lookup symbol name in this ELF
+		 *
+		 * \param undef  true if undefined symbols are of interest
+		 *
+		 * The GNU hash table is preferred. It omits undefined symbols though.
+		 * Hence, lookups for undefined symbols resort to the SysV hash table
+		 * if present.
 		 */
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash,
+		                              bool undef = false) const
 		{
-			Hash_table *h = _hash_table;
-
-			if (!h->buckets())
-				return nullptr;
+			if (_gnu_hash_table && !(undef && _hash_table))
+				return _lookup_gnu(name, hash.gnu());
 
-			unsigned sym_index = h->buckets()[hash % h->nbuckets()];
-
-			/* traverse hash chain */
-			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
-			{
-				/* bad object */
-				if (sym_index > h->nchains())
-					return nullptr;
-
-				Elf::Sym const *sym      = symbol(sym_index);
-				char const     *sym_name = symbol_name(*sym);
-
-				/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
-				if (sym->type() > STT_FUNC)
-					continue;
-
-				if (sym->st_value == 0)
-					continue;
-
-				/* check for symbol name */
-				if (name[0] != sym_name[0] || strcmp(name, sym_name))
-					continue;
-
-				return sym;
-			}
+			if (_hash_table)
+				return _lookup_sysv(name, hash.sysv());
 
 			return nullptr;
 		}
@@ -285,7 +487,7 @@ class Linker::Dynamic
 		{
 			addr_t const reloc_base = _obj.reloc_base();
 
-			for (unsigned i = 0; i < _hash_table->nchains(); i++)
+			for (unsigned i = 0; i < _num_symbols; i++)
 			{
 				Elf::Sym const *sym = symbol(i);
 				if (!sym)
@@ -0,0 +1,239 @@
+/*
+ * \brief  Snapshots of relocated RW segments
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__RW_SNAPSHOT_H_
+#define _INCLUDE__RW_SNAPSHOT_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <util/construct_at.h>
+#include <util/list.h>
+
+/* local includes */
+#include <file.h>
+
+namespace Linker { class Rw_snapshots; }
+
+
+/**
+ * Cache of relocated RW segments of shared objects
+ *
+ * When a shared object is loaded again, e.g., after 'dlclose' or 'execve',
+ * it is usually placed at the same address and resolves its symbols to
+ * the same objects as before. In this case, the RW segments of the former
+ * instance, taken right after relocation and before the execution of any
+ * static constructor, are copied instead of relocating the object anew.
+ *
+ * A snapshot is used only if the object is placed at the same address, with
+ * the same binding mode, and with an unchanged lookup scope. The lookup
+ * scope is represented by a fingerprint of the names and addresses of all
+ * objects that take part in the object's symbol resolution. The ROM modules
+ * of the shared objects are expected not to change during the lifetime of
+ * the component.
+ */
+class Linker::Rw_snapshots : Noncopyable
+{
+	public:
+
+		struct Key
+		{
+			Object::Name name;
+			Elf::Addr    reloc_base;
+			Bind         bind;
+			uint64_t     scope;
+
+			bool operator == (Key const &other) const
+			{
+				return reloc_base == other.reloc_base && bind  == other.bind
+				    && scope      == other.scope      && name  == other.name;
+			}
+		};
+
+		struct Stats { unsigned long restored, captured; };
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Rw_snapshots(Rw_snapshots const &);
+		Rw_snapshots &operator = (Rw_snapshots const &);
+
+		struct Segment { addr_t at; size_t size; };
+
+		struct Snapshot : List<Snapshot>::Element
+		{
+			Key const key;
+
+			Segment  segments[Phdr::MAX_PHDR] { };
+			unsigned num_segments = 0;
+
+			size_t const data_size;
+
+			Snapshot(Key const &key, size_t data_size)
+			: key(key), data_size(data_size) { }
+
+			char *data() { return (char *)(this + 1); }
+
+			size_t alloc_size() const { return sizeof(Snapshot) + data_size; }
+		};
+
+		Allocator &_alloc;
+
+		size_t const _limit;
+		size_t       _used = 0;
+
+		List<Snapshot> _snapshots { };   /* most recently used first */
+
+		Stats _stats { };
+
+		/**
+		 * Call 'fn' with address and size of each RW segment of 'file'
+		 */
+		static void _for_each_rw_segment(File const &file, Elf::Addr reloc_base,
+		                                 auto const &fn)
+		{
+			for (unsigned i = 0; i < file.elf_phdr_count(); i++) {
+				Elf::Phdr const &ph = *file.elf_phdr(i);
+				if (ph.p_type == PT_LOAD && is_rw(ph))
+					fn(Segment { .at = reloc_base + ph.p_vaddr, .size = ph.p_filesz });
+			}
+		}
+
+		void _destroy(Snapshot &snapshot)
+		{
+			_snapshots.remove(&snapshot);
+			_used -= snapshot.alloc_size();
+
+			size_t const size = snapshot.alloc_size();
+			snapshot.~Snapshot();
+			_alloc.free(&snapshot, size);
+		}
+
+		Snapshot *_lookup(Key const &key)
+		{
+			for (Snapshot *s = _snapshots.first(); s; s = s->next())
+				if (s->key.name == key.name)
+					return s;
+
+			return nullptr;
+		}
+
+		Snapshot *_last()
+		{
+			Snapshot *last = _snapshots.first();
+			while (last && last->next())
+				last = last->next();
+			return last;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param limit  maximum amount of memory used for snapshots
+		 */
+		Rw_snapshots(Allocator &alloc, size_t limit)
+		: _alloc(alloc), _limit(limit) { }
+
+		~Rw_snapshots()
+		{
+			while (Snapshot *s = _snapshots.first())
+				_destroy(*s);
+		}
+
+		/**
+		 * Copy snapshot into the RW segments of 'file'
+		 *
+		 * \return true if a matching snapshot was applied
+		 */
+		bool restore(Key const &key, File const &file)
+		{
+			Snapshot *snapshot = _lookup(key);
+			if (!snapshot || !(snapshot->key == key))
+				return false;
+
+			/* check that the segment layout is unchanged */
+			unsigned i = 0;
+			bool     match = true;
+			_for_each_rw_segment(file, key.reloc_base, [&] (Segment const &seg) {
+				Segment const &s = snapshot->segments[i++];
+				match = match && i <= snapshot->num_segments
+				              && s.at == seg.at && s.size == seg.size; });
+
+			if (!match || i != snapshot->num_segments)
+				return false;
+
+			size_t offset = 0;
+			for (i = 0; i < snapshot->num_segments; i++) {
+				Segment const &s = snapshot->segments[i];
+				memcpy((void *)s.at, snapshot->data() + offset, s.size);
+				offset += s.size;
+			}
+
+			/* move to front */
+			_snapshots.remove(snapshot);
+			_snapshots.insert(snapshot);
+
+			_stats.restored++;
+			return true;
+		}
+
+		/**
+		 * Take snapshot of the relocated RW segments of 'file'
+		 */
+		void capture(Key const &key, File const &file)
+		{
+			/* drop outdated snapshot of the same object */
+			if (Snapshot *outdated = _lookup(key))
+				_destroy(*outdated);
+
+			size_t   data_size    = 0;
+			unsigned num_segments = 0;
+			_for_each_rw_segment(file, key.reloc_base, [&] (Segment const &seg) {
+				data_size += seg.size;
+				num_segments++; });
+
+			size_t const alloc_size = sizeof(Snapshot) + data_size;
+			if (!num_segments || alloc_size > _limit)
+				return;
+
+			/* evict least recently used snapshots */
+			while (_used + alloc_size > _limit)
+				if (Snapshot *last = _last())
+					_destroy(*last);
+
+			_alloc.try_alloc(alloc_size).with_result(
+				[&] (Allocator::Allocation &a) {
+					a.deallocate = false;
+
+					Snapshot &snapshot = *construct_at<Snapshot>(a.ptr, key, data_size);
+
+					size_t offset = 0;
+					_for_each_rw_segment(file, key.reloc_base, [&] (Segment const &seg) {
+						snapshot.segments[snapshot.num_segments++] = seg;
+						memcpy(snapshot.data() + offset, (void const *)seg.at, seg.size);
+						offset += seg.size; });
+
+					_snapshots.insert(&snapshot);
+					_used += alloc_size;
+					_stats.captured++;
+				},
+				[&] (Alloc_error) { });
+		}
+
+		Stats stats() const { return _stats; }
+};
+
+#endif /* _INCLUDE__RW_SNAPSHOT_H_ */
@@ -0,0 +1,172 @@
+/*
+ * \brief  Cache of symbol-lookup results
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__SYMBOL_CACHE_H_
+#define _INCLUDE__SYMBOL_CACHE_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <base/mutex.h>
+
+/* local includes */
+#include <dynamic.h>
+
+namespace Linker { class Symbol_cache; }
+
+
+/**
+ * Direct-mapped cache of symbol-lookup results
+ *
+ * The relocations of different objects frequently refer to the same
+ * symbols, each reference requiring a probe of all objects of the lookup
+ * scope. The cache remembers the result per symbol name and scope.
+ *
+ * Cached entries refer to the symbol tables of loaded objects. Hence, the
+ * cache must be flushed whenever an object is loaded or unloaded.
+ */
+class Linker::Symbol_cache : Noncopyable
+{
+	public:
+
+		struct Key
+		{
+			uint32_t          hash;   /* GNU hash of 'name' */
+			char const       *name;
+			Dependency const *scope;  /* first dependency of lookup scope */
+			Dependency const *skip;   /* dependency omitted from lookup */
+			bool              undef;
+		};
+
+		struct Stats { unsigned long hits, misses; };
+
+	private:
+
+		struct Entry
+		{
+			Key             key;
+			Elf::Sym const *sym;
+			Elf::Addr       base;
+
+			bool matches(Key const &other) const
+			{
+				return sym
+				    && key.hash  == other.hash
+				    && key.scope == other.scope
+				    && key.skip  == other.skip
+				    && key.undef == other.undef
+				    && (key.name == other.name || !strcmp(key.name, other.name));
+			}
+		};
+
+		/*
+		 * Noncopyable
+		 */
+		Symbol_cache(Symbol_cache const &);
+		Symbol_cache &operator = (Symbol_cache const &);
+
+		Allocator &_alloc;
+
+		unsigned const _num_entries;   /* power of two */
+		Entry         *_entries = nullptr;
+
+		Mutex _mutex { };
+
+		Stats _stats { };
+
+		static unsigned _power_of_two(unsigned n)
+		{
+			unsigned result = 1;
+			while (result < n)
+				result <<= 1;
+			return result;
+		}
+
+		Entry &_entry(Key const &key)
+		{
+			addr_t const scope = (addr_t)key.scope;
+			return _entries[(key.hash ^ (uint32_t)(scope >> 4)) & (_num_entries - 1)];
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param num_entries  number of cache entries, rounded up to a power
+		 *                     of two
+		 */
+		Symbol_cache(Allocator &alloc, unsigned num_entries)
+		:
+			_alloc(alloc), _num_entries(_power_of_two(num_entries))
+		{
+			_alloc.try_alloc(_num_entries*sizeof(Entry)).with_result(
+				[&] (Allocator::Allocation &a) {
+					a.deallocate = false;
+					_entries = (Entry *)a.ptr; },
+				[&] (Alloc_error) {
+					warning("LD: unable to allocate symbol cache"); });
+
+			flush();
+		}
+
+		~Symbol_cache()
+		{
+			if (_entries)
+				_alloc.free(_entries, _num_entries*sizeof(Entry));
+		}
+
+		/**
+		 * Look up cached symbol
+		 *
+		 * \param base  returned reloc base of the object defining the symbol
+		 *
+		 * \return symbol, or nullptr if not cached
+		 */
+		Elf::Sym const *lookup(Key const &key, Elf::Addr *base)
+		{
+			Mutex::Guard guard(_mutex);
+
+			if (!_entries)
+				return nullptr;
+
+			Entry const &entry = _entry(key);
+			if (!entry.matches(key)) {
+				_stats.misses++;
+				return nullptr;
+			}
+
+			_stats.hits++;
+			*base = entry.base;
+			return entry.sym;
+		}
+
+		void insert(Key const &key, Elf::Sym const *sym, Elf::Addr base)
+		{
+			Mutex::Guard guard(_mutex);
+
+			if (_entries)
+				_entry(key) = { .key = key, .sym = sym, .base = base };
+		}
+
+		void flush()
+		{
+			Mutex::Guard guard(_mutex);
+
+			for (unsigned i = 0; _entries && i < _num_entries; i++)
+				_entries[i] = { .key = { }, .sym = nullptr, .base = 0 };
+		}
+
+		Stats stats() const { return _stats; }
+};
+
+#endif /* _INCLUDE__SYMBOL_CACHE_H_ */
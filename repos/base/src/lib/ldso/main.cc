@@ -29,6 +29,8 @@
 #include <init.h>
 #include <region_map.h>
 #include <config.h>
+#include <symbol_cache.h>
+#include <rw_snapshot.h>
 
 using namespace Linker;
 
@@ -43,11 +45,15 @@ namespace Linker {
 };
 
 static    Binary *binary_ptr = nullptr;
+static    Symbol_cache *symbol_cache_ptr = nullptr;
+static    Rw_snapshots *rw_snapshots_ptr = nullptr;
 static    Parent *parent_ptr = nullptr;
 bool      Linker::verbose  = false;
 Stage     Linker::stage    = STAGE_BINARY;
 Link_map *Link_map::first;
 
+static uint64_t scope_fingerprint(Dependency const &);
+
 
 Linker::Region_map::Constructible_region_map &Linker::Region_map::r()
 {
@@ -126,6 +132,41 @@ class Linker::Elf_object : public Object, private Fifo<Elf_object>::Element
 
 		Dynamic _dyn;
 
+		Rw_snapshots::Key _rw_snapshot_key(Bind bind) const
+		{
+			return { .name       = name(),
+			         .reloc_base = reloc_base(),
+			         .bind       = bind,
+			         .scope      = scope_fingerprint(_dyn.dep()) };
+		}
+
+		bool _rw_snapshots_enabled() const
+		{
+			return rw_snapshots_ptr && !is_binary() && !is_linker();
+		}
+
+		/**
+		 * Apply RW segments of a former instance instead of relocating
+		 */
+		bool _restore_rw_snapshot(Bind bind)
+		{
+			if (!_rw_snapshots_enabled())
+				return false;
+
+			if (!rw_snapshots_ptr->restore(_rw_snapshot_key(bind), *_elf_file))
+				return false;
+
+			/* the GOT refers to the dependency of this instance */
+			_dyn.plt_setup();
+			return true;
+		}
+
+		void _capture_rw_snapshot(Bind bind)
+		{
+			if (_rw_snapshots_enabled())
+				rw_snapshots_ptr->capture(_rw_snapshot_key(bind), *_elf_file);
+		}
+
 	public:
 
 		Elf_object(Dependency const &dep, char const *name,
@@ -170,6 +211,9 @@ class Linker::Elf_object : public Object, private Fifo<Elf_object>::Element
 			with_object_list([&] (Object_list &list) {
 				list.remove(*this); });
 			Init::list()->remove(this);
+
+			if (symbol_cache_ptr)
+				symbol_cache_ptr->flush();
 		}
 
 		/**
@@ -191,9 +235,10 @@ class Linker::Elf_object : public Object, private Fifo<Elf_object>::Element
 			return _dyn.symbol_name(sym);
 		}
 
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash,
+		                              bool undef) const
 		{
-			return _dyn.lookup_symbol(name, hash);
+			return _dyn.lookup_symbol(name, hash, undef);
 		}
 
 		/**
@@ -231,8 +276,19 @@ class Linker::Elf_object : public Object, private Fifo<Elf_object>::Element
 
 		void relocate(Bind bind) override SELF_RELOC
 		{
-			if (!_relocated)
-				_dyn.relocate(bind);
+			/*
+			 * The linker's own object lacks an ELF file and is relocated
+			 * before any global data is accessible.
+			 */
+			if (!_relocated) {
+				if (!_elf_file.constructed())
+					_dyn.relocate(bind);
+
+				else if (!_restore_rw_snapshot(bind)) {
+					_dyn.relocate(bind);
+					_capture_rw_snapshot(bind);
+				}
+			}
 
 			_relocated = true;
 		}
@@ -489,14 +545,42 @@ void genode_exit(int status)
 }
 
 
+/**
+ * Fingerprint of the objects that take part in the symbol resolution of
+ * the object of dependency 'dep'
+ */
+static uint64_t scope_fingerprint(Dependency const &dep)
+{
+	uint64_t hash = 0xcbf29ce484222325ull;
+
+	auto const add = [&] (uint64_t value) {
+		hash = (hash ^ value) * 0x100000001b3ull; };
+
+	auto const add_scope = [&] (Dependency const *curr) {
+		for (; curr; curr = curr->next()) {
+			for (char const *s = curr->obj().name(); *s; s++)
+				add((unsigned char)*s);
+			add(curr->obj().reloc_base());
+		}
+	};
+
+	add_scope(&dep.first());
+
+	/* lookups fall back to the binary's dependencies */
+	if (binary_ptr && &dep.first() != binary_ptr->first_dep())
+		add_scope(binary_ptr->first_dep());
+
+	return hash;
+}
+
+
 /**********************************
  ** Linker object implementation **
  **********************************/
 
 Elf::Addr Linker::Object::_symbol_address(char const *name)
 {
-	unsigned long   hash = Hash_table::hash(name);
-	Elf::Sym const *sym  = dynamic().lookup_symbol(name, hash);
+	Elf::Sym const *sym = dynamic().lookup_symbol(name, Symbol_hash(name));
 
 	if (sym)
 		return reloc_base() + sym->st_value;
@@ -539,6 +623,10 @@ Object &Linker::load(Env &env, Allocator &md_alloc, char const *path,
 	if (result == nullptr)
 		result = new (md_alloc) Elf_object(env, md_alloc, path, dep, keep);
 
+	/* a new object or changed dependencies may alter lookup results */
+	if (symbol_cache_ptr)
+		symbol_cache_ptr->flush();
+
 	return *result;
 }
 
@@ -563,15 +651,25 @@ Elf::Sym const *Linker::lookup_symbol(unsigned sym_index, Dependency const &dep,
 }
 
 
-Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
-                                      Elf::Addr *base, bool undef, bool other)
+/**
+ * Find symbol via name by probing all objects of the lookup scope
+ *
+ * \param defined_by  returned object defining the symbol, or nullptr if the
+ *                    symbol was found outside the given scope
+ */
+static Elf::Sym const *lookup_symbol_uncached(char const *name, Symbol_hash const &hash,
+                                              Dependency const &dep, Elf::Addr *base,
+                                              bool undef, bool other,
+                                              Elf_object const **defined_by)
 {
 	Dependency const *curr        = &dep.first();
-	unsigned long     hash        = Hash_table::hash(name);
 	Elf::Sym   const *weak_symbol = 0;
 	Elf::Addr        weak_base    = 0;
+	Elf_object const *weak_elf    = 0;
 	Elf::Sym   const *symbol      = 0;
 
+	*defined_by = nullptr;
+
 	//TODO: handle vertab and search in object list
 	for (;curr; curr = curr->next()) {
 
@@ -580,7 +678,7 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
 
 		Elf_object const &elf = static_cast<Elf_object const &>(curr->obj());
 
-		if ((symbol = elf.lookup_symbol(name, hash)) && (symbol->st_value || undef)) {
+		if ((symbol = elf.lookup_symbol(name, hash, undef)) && (symbol->st_value || undef)) {
 
 			if (dep.root() && verbose_lookup)
 				log("LD: lookup ", name, " obj_src ", elf.name(),
@@ -591,13 +689,15 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
 				continue;
 
 			if (!symbol->weak() && symbol->st_shndx != SHN_UNDEF) {
-				*base = elf.reloc_base();
+				*base       = elf.reloc_base();
+				*defined_by = &elf;
 				return symbol;
 			}
 
 			if (!weak_symbol) {
 				weak_symbol = symbol;
 				weak_base   = elf.reloc_base();
+				weak_elf    = &elf;
 			}
 		}
 	}
@@ -617,11 +717,49 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
 	if (!weak_symbol)
 		throw Not_found(name);
 
-	*base = weak_base;
+	*base       = weak_base;
+	*defined_by = weak_elf;
 	return weak_symbol;
 }
 
 
+Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
+                                      Elf::Addr *base, bool undef, bool other)
+{
+	Symbol_hash const hash(name);
+	Elf_object const *defined_by = nullptr;
+
+	/*
+	 * The cache is not available while the linker relocates itself. Lookups
+	 * for the linker's own relocations are not part of any root's scope.
+	 */
+	if (!dep.root() || !symbol_cache_ptr)
+		return lookup_symbol_uncached(name, hash, dep, base, undef, other, &defined_by);
+
+	Symbol_cache::Key key { .hash  = hash.gnu(),
+	                        .name  = name,
+	                        .scope = &dep.first(),
+	                        .skip  = other ? &dep : nullptr,
+	                        .undef = undef };
+
+	if (Elf::Sym const *symbol = symbol_cache_ptr->lookup(key, base))
+		return symbol;
+
+	Elf::Sym const *symbol =
+		lookup_symbol_uncached(name, hash, dep, base, undef, other, &defined_by);
+
+	/*
+	 * The name passed by the caller may be short-lived, e.g., for 'dlsym'.
+	 * Refer to the name stored in the defining object instead.
+	 */
+	if (defined_by) {
+		key.name = defined_by->symbol_name(*symbol);
+		symbol_cache_ptr->insert(key, symbol, *base);
+	}
+	return symbol;
+}
+
+
 /********************
  ** Initialization **
  ********************/
@@ -808,6 +946,16 @@ void Component::construct(Genode::Env &env)
 
 	parent_ptr = &env.parent();
 
+	if (config.symbol_cache) {
+		static Symbol_cache symbol_cache { *heap(), config.symbol_cache };
+		symbol_cache_ptr = &symbol_cache;
+	}
+
+	if (config.rw_snapshots) {
+		static Rw_snapshots rw_snapshots { *heap(), config.rw_snapshots };
+		rw_snapshots_ptr = &rw_snapshots;
+	}
+
 	/* load binary and all dependencies */
 	try {
 		static Binary binary { env, *heap(), config, binary_name() };
@@ -832,6 +980,15 @@ void Component::construct(Genode::Env &env)
 				list.for_each([] (Object const &obj) {
 					dump_link_map(obj); });
 			});
+			if (symbol_cache_ptr) {
+				Symbol_cache::Stats const stats = symbol_cache_ptr->stats();
+				log("  symbol cache: ", stats.hits, " hits, ", stats.misses, " misses");
+			}
+			if (rw_snapshots_ptr) {
+				Rw_snapshots::Stats const stats = rw_snapshots_ptr->stats();
+				log("  RW snapshots: ", stats.captured, " captured, ",
+				    stats.restored, " restored");
+			}
 		}
 	} catch (...) {  }
 
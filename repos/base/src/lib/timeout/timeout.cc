@@ -55,6 +55,244 @@ void Timeout::discard() { _scheduler._discard_timeout(*this); }
 bool Timeout::scheduled() { return _handler != nullptr; }
 
 
+/*******************
+ ** Timeout_wheel **
+ *******************/
+
+unsigned Timeout_wheel::_level(uint64_t deadline_us) const
+{
+	uint64_t const diff = deadline_us ^ _time;
+	if (!diff)
+		return 0;
+
+	unsigned const level = (63 - __builtin_clzll(diff)) / SLOT_BITS;
+	if (level < LEVELS)
+		return level;
+
+	/*
+	 * The top level wraps around. Its slots before the current one take the
+	 * deadlines of the next round of the top level.
+	 */
+	bool const next_round = (deadline_us >> RANGE_BITS) == (_time >> RANGE_BITS) + 1
+	                     && _index(LEVELS - 1, deadline_us) < _index(LEVELS - 1, _time);
+
+	return next_round ? LEVELS - 1 : LEVELS;
+}
+
+
+uint64_t Timeout_wheel::_slot_start(unsigned level, unsigned slot) const
+{
+	unsigned const shift = SLOT_BITS*(level + 1);
+	uint64_t       upper = _time & (~(uint64_t)0 << shift);
+
+	/* slot of the next round of the top level */
+	if (slot < _index(level, _time))
+		upper += (uint64_t)1 << shift;
+
+	return upper | ((uint64_t)slot << (SLOT_BITS*level));
+}
+
+
+unsigned Timeout_wheel::_first_slot(unsigned level) const
+{
+	uint64_t const ahead = _occupied[level] & (~(uint64_t)0 << _index(level, _time));
+
+	return (unsigned)__builtin_ctzll(ahead ? ahead : _occupied[level]);
+}
+
+
+void Timeout_wheel::_link(Timeout &timeout, unsigned index)
+{
+	Timeout *&head = _slots[index];
+
+	timeout._wheel_slot = index;
+	timeout._wheel_prev = nullptr;
+	timeout._wheel_next = head;
+	if (head)
+		head->_wheel_prev = &timeout;
+
+	head = &timeout;
+
+	if (index == OVERFLOW) {
+		_overflow_min_us = min(_overflow_min_us, timeout._deadline.value);
+		return;
+	}
+
+	unsigned const level = index / SLOTS;
+	_occupied[level]  |= (uint64_t)1 << (index % SLOTS);
+	_occupied_levels  |= 1U << level;
+}
+
+
+void Timeout_wheel::_unlink(Timeout &timeout)
+{
+	unsigned const index = timeout._wheel_slot;
+
+	if (timeout._wheel_prev)
+		timeout._wheel_prev->_wheel_next = timeout._wheel_next;
+	else
+		_slots[index] = timeout._wheel_next;
+
+	if (timeout._wheel_next)
+		timeout._wheel_next->_wheel_prev = timeout._wheel_prev;
+
+	timeout._wheel_slot = NONE;
+	timeout._wheel_next = nullptr;
+	timeout._wheel_prev = nullptr;
+
+	if (index == OVERFLOW) {
+		if (!_slots[OVERFLOW])
+			_overflow_min_us = ~(uint64_t)0;
+		return;
+	}
+
+	if (_slots[index])
+		return;
+
+	unsigned const level = index / SLOTS;
+	_occupied[level] &= ~((uint64_t)1 << (index % SLOTS));
+	if (!_occupied[level])
+		_occupied_levels &= ~(1U << level);
+}
+
+
+void Timeout_wheel::_refill_from_overflow()
+{
+	/* re-filing the remaining timeouts determines the exact lower bound */
+	Timeout *timeout = _slots[OVERFLOW];
+	_slots[OVERFLOW] = nullptr;
+	_overflow_min_us = ~(uint64_t)0;
+
+	while (timeout) {
+		Timeout *const next = timeout->_wheel_next;
+		insert(*timeout);
+		timeout = next;
+	}
+}
+
+
+void Timeout_wheel::advance(uint64_t now_us)
+{
+	uint64_t time_us = now_us;
+
+	unsigned const level = _first_level();
+	if (level < LEVELS) {
+		uint64_t const start = _slot_start(level, _first_slot(level));
+		if (start <= time_us)
+			time_us = start ? start - 1 : 0;
+	}
+
+	if (time_us > _time)
+		_time = time_us;
+
+	if (_overflow_in_range())
+		_refill_from_overflow();
+}
+
+
+void Timeout_wheel::insert(Timeout &timeout)
+{
+	/* file timeouts that are already due into the current slot */
+	uint64_t const deadline_us = max(timeout._deadline.value, _time);
+
+	unsigned const level = _level(deadline_us);
+	if (level >= LEVELS) {
+		_link(timeout, OVERFLOW);
+		return;
+	}
+	unsigned const slot = (unsigned)(deadline_us >> (SLOT_BITS*level)) & (SLOTS - 1);
+	_link(timeout, level*SLOTS + slot);
+}
+
+
+void Timeout_wheel::remove(Timeout &timeout)
+{
+	if (timeout._wheel_slot != NONE)
+		_unlink(timeout);
+}
+
+
+Timeout *Timeout_wheel::first()
+{
+	unsigned const level = _first_level();
+	if (level == LEVELS)
+		return _slots[OVERFLOW];
+
+	return _slots[level*SLOTS + _first_slot(level)];
+}
+
+
+uint64_t Timeout_wheel::next_event_us() const
+{
+	/*
+	 * Each level covers a time span later than that of the levels below.
+	 * So, the first occupied slot of the lowest occupied level holds the
+	 * earliest deadline within the wheel. At level 0, all timeouts of a
+	 * slot share the same deadline. At higher levels, we have to look at
+	 * each timeout of the slot. This costs no more than redistributing the
+	 * slot, which becomes necessary at the latest when the returned time is
+	 * reached. For the overflow list, the cached lower bound is taken. The
+	 * list is refilled into the wheel long before this time is reached.
+	 */
+	uint64_t const overflow_us = _slots[OVERFLOW] ? _overflow_min_us : ~(uint64_t)0;
+
+	unsigned const level = _first_level();
+	if (level == LEVELS)
+		return overflow_us;
+
+	unsigned const slot = _first_slot(level);
+	if (level == 0)
+		return min(overflow_us, _slot_start(0, slot));
+
+	uint64_t deadline_us = overflow_us;
+	for (Timeout const *timeout = _slots[level*SLOTS + slot]; timeout;
+	     timeout = timeout->_wheel_next)
+		deadline_us = min(deadline_us, timeout->_deadline.value);
+
+	return deadline_us;
+}
+
+
+Timeout *Timeout_wheel::remove_expired(uint64_t now_us)
+{
+	for (;;) {
+
+		if (_overflow_in_range())
+			_refill_from_overflow();
+
+		unsigned const level = _first_level();
+		unsigned const slot  = level < LEVELS ? _first_slot(level) : 0;
+		uint64_t const start = level < LEVELS ? _slot_start(level, slot) : ~(uint64_t)0;
+		if (start > now_us) {
+
+			/*
+			 * No timeout is due until 'now_us'. So, the wheel can advance
+			 * to 'now_us' without moving any timeout. This may bring
+			 * timeouts of the overflow list into range.
+			 */
+			if (now_us <= _time)
+				return nullptr;
+
+			_time = now_us;
+			continue;
+		}
+
+		_time = start;
+
+		if (level == 0) {
+			Timeout &timeout = *_slots[slot];
+			_unlink(timeout);
+			return &timeout;
+		}
+		/* redistribute the timeouts of the slot to the lower levels */
+		while (Timeout *const timeout = _slots[level*SLOTS + slot]) {
+			_unlink(*timeout);
+			insert(*timeout);
+		}
+	}
+}
+
+
 /***********************
  ** Timeout_scheduler **
  ***********************/
@@ -86,17 +324,12 @@ void Timeout_scheduler::handle_timeout(Duration curr_time)
 		/*
 		 * Filter out all pending timeouts to a local list first. The
 		 * processing of pending timeouts can have effects on the '_timeouts'
-		 * list and these would interfere with the filtering if we would do
+		 * wheel and these would interfere with the filtering if we would do
 		 * it all in the same loop.
 		 */
-		while (Timeout *timeout = _timeouts.first()) {
+		while (Timeout *timeout = _timeouts.remove_expired(_current_time.value)) {
 
 			timeout->_mutex.acquire();
-			if (timeout->_deadline.value > _current_time.value) {
-				timeout->_mutex.release();
-				break;
-			}
-			_timeouts.remove(timeout);
 			pending_timeouts.insert(&timeout->_pending_timeouts_le);
 		}
 		/*
@@ -153,9 +386,9 @@ void Timeout_scheduler::handle_timeout(Duration curr_time)
 				if (deadline_us < _current_time.value) {
 					deadline_us = ~(uint64_t)0;
 				}
-				/* re-insert timeout into timeouts list */
+				/* re-insert timeout into timeout wheel */
 				timeout._deadline = Microseconds { deadline_us };
-				_insert_into_timeouts_list(timeout);
+				_timeouts.insert(timeout);
 			}
 			timeout._mutex.release();
 		}
@@ -242,10 +475,11 @@ void Timeout_scheduler::_enable()
 
 void Timeout_scheduler::_set_time_source_timeout()
 {
+	_next_event_us = _timeouts.next_event_us();
 	_set_time_source_timeout(
-		_timeouts.first() ?
-			_timeouts.first()->_deadline.value - _current_time.value :
-			~(uint64_t)0);
+		_next_event_us == ~(uint64_t)0 ? ~(uint64_t)0 :
+		_next_event_us > _current_time.value ?
+			_next_event_us - _current_time.value : 0);
 }
 
 
@@ -297,7 +531,7 @@ void Timeout_scheduler::_schedule_timeout(Timeout         &timeout,
 
 	/* prevent inserting a timeout twice */
 	if (timeout._handler != nullptr) {
-		_timeouts.remove(&timeout);
+		_timeouts.remove(timeout);
 	}
 	/* determine timeout deadline */
 	uint64_t const curr_time_us {
@@ -307,45 +541,24 @@ void Timeout_scheduler::_schedule_timeout(Timeout         &timeout,
 		duration.value <= ~(uint64_t)0 - curr_time_us ?
 			curr_time_us + duration.value : ~(uint64_t)0 };
 
-	/* set up timeout object and insert into timeouts list */
+	/* set up timeout object and insert into timeout wheel */
 	timeout._handler = &handler;
 	timeout._deadline = Microseconds { deadline_us };
 	timeout._period = period;
-	_insert_into_timeouts_list(timeout);
+	_timeouts.advance(curr_time_us);
+	_timeouts.insert(timeout);
 
 	/*
-	 * If the new timeout is the first to trigger, we have to  update the
-	 * time-source timeout.
+	 * If the new timeout triggers before the time-source timeout, we have
+	 * to update the time-source timeout.
 	 */
-	if (_timeouts.first() == &timeout) {
+	if (deadline_us < _next_event_us) {
+		_next_event_us = deadline_us;
 		_set_time_source_timeout(deadline_us - curr_time_us);
 	}
 }
 
 
-void Timeout_scheduler::_insert_into_timeouts_list(Timeout &timeout)
-{
-	/* if timeout list is empty, insert as first element */
-	if (_timeouts.first() == nullptr) {
-		_timeouts.insert(&timeout);
-		return;
-	}
-	/* if timeout has the shortest deadline, insert as first element */
-	if (_timeouts.first()->_deadline.value >= timeout._deadline.value) {
-		_timeouts.insert(&timeout);
-		return;
-	}
-	/* find list element with next shorter deadline and insert behind it */
-	Timeout *curr_timeout { _timeouts.first() };
-	for (;
-	     curr_timeout->next() != nullptr &&
-	     curr_timeout->next()->_deadline.value < timeout._deadline.value;
-	     curr_timeout = curr_timeout->_next);
-
-	_timeouts.insert(&timeout, curr_timeout);
-}
-
-
 void Timeout_scheduler::_discard_timeout(Timeout &timeout)
 {
 	Mutex::Guard const scheduler_mutex { _mutex };
@@ -393,7 +606,7 @@ void Timeout_scheduler::_discard_timeout_unsynchronized(Timeout &timeout)
 		timeout._mutex.acquire();
 		timeout._in_discard_blockade = false;
 	}
-	_timeouts.remove(&timeout);
+	_timeouts.remove(timeout);
 	timeout._handler = nullptr;
 }
 
@@ -0,0 +1,104 @@
+/*
+ * \brief  Benchmark for measuring the RPC round-trip rate
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Session;
+	struct Session_component;
+	struct Main;
+}
+
+
+struct Test::Session : Genode::Session
+{
+	static const char *service_name() { return "Rpc_bench"; }
+
+	GENODE_RPC(Rpc_nop, void, nop);
+	GENODE_RPC(Rpc_add, unsigned, add, unsigned, unsigned);
+	GENODE_RPC_INTERFACE(Rpc_nop, Rpc_add);
+};
+
+
+struct Test::Session_component : Rpc_object<Session, Session_component>
+{
+	void nop() { }
+
+	unsigned add(unsigned a, unsigned b) { return a + b; }
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _rounds = _config.node().attribute_value("rounds", 5u);
+	unsigned const _calls  = _config.node().attribute_value("calls",  100'000u);
+
+	Timer::Connection _timer { _env };
+
+	Rpc_entrypoint _ep { _env.runtime(), "rpc_bench_ep",
+	                     Thread::Stack_size { 16*1024 }, Affinity::Location() };
+
+	Session_component _component { };
+
+	Capability<Session> _cap { _ep.manage(&_component) };
+
+	void _measure(char const *name, auto const &call_fn)
+	{
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (unsigned i = 0; i < _calls; i++)
+			call_fn(i);
+
+		uint64_t const duration_us = max(_timer.elapsed_us() - start_us, 1ULL);
+
+		log(name, ": ", _calls, " calls in ", duration_us, " us -> ",
+		    (_calls*1'000'000ULL)/duration_us, " calls/s");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- RPC benchmark started ---");
+
+		for (unsigned round = 0; round < _rounds; round++) {
+
+			log("round ", round + 1, "/", _rounds);
+
+			_measure("nop", [&] (unsigned) {
+				_cap.call<Session::Rpc_nop>(); });
+
+			unsigned sum = 0;
+			_measure("add", [&] (unsigned i) {
+				sum = _cap.call<Session::Rpc_add>(sum, i); });
+		}
+
+		_ep.dissolve(&_component);
+
+		log("--- RPC benchmark finished ---");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
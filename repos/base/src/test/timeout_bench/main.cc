@@ -0,0 +1,275 @@
+/*
+ * \brief  Benchmark of the timeout scheduler with many concurrent timeouts
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The test drives a timeout scheduler by a virtual time source, so the
+ * measurement covers the bookkeeping of the scheduler only. It schedules,
+ * re-schedules, and discards a large number of timeouts and finally lets
+ * all remaining timeouts expire. It checks that each timeout triggers
+ * exactly once, at its deadline. The round is repeated with a fresh
+ * scheduler whose time starts beyond 2^36 us, and with one whose timeouts
+ * cross a multiple of 2^36 us, which are the range limits of the levels of
+ * the timing wheel.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Virtual_time_source;
+	struct Entry;
+	struct Random;
+	struct Round;
+	struct Main;
+}
+
+
+/**
+ * Time source that advances only on request
+ */
+struct Test::Virtual_time_source : Time_source
+{
+	uint64_t         now_us      { 0 };
+	uint64_t         deadline_us { ~(uint64_t)0 };
+	Timeout_handler *handler_ptr { nullptr };
+
+	void advance_to(uint64_t time_us)
+	{
+		now_us = time_us;
+		if (handler_ptr)
+			handler_ptr->handle_timeout(Duration(Microseconds(now_us)));
+	}
+
+	Duration curr_time() override { return Duration(Microseconds(now_us)); }
+
+	Microseconds max_timeout() const override { return Microseconds(~(uint64_t)0); }
+
+	void set_timeout(Microseconds duration, Timeout_handler &handler) override
+	{
+		handler_ptr = &handler;
+		deadline_us = duration.value <= ~(uint64_t)0 - now_us ?
+		              now_us + duration.value : ~(uint64_t)0;
+	}
+};
+
+
+struct Test::Entry : Timeout_handler
+{
+	Virtual_time_source &_time_source;
+
+	Timeout  timeout;
+	uint64_t deadline_us { ~(uint64_t)0 };
+	unsigned triggered   { 0 };
+	bool     early       { false };
+	bool     late        { false };
+
+	Entry(Virtual_time_source &time_source, Timeout_scheduler &scheduler)
+	: _time_source(time_source), timeout(scheduler) { }
+
+	void schedule(uint64_t duration_us)
+	{
+		deadline_us = _time_source.now_us + duration_us;
+		timeout.schedule_one_shot(Microseconds(duration_us), *this);
+	}
+
+	void discard()
+	{
+		deadline_us = ~(uint64_t)0;
+		timeout.discard();
+	}
+
+	void handle_timeout(Duration) override
+	{
+		triggered++;
+		if (_time_source.now_us < deadline_us)
+			early = true;
+		if (_time_source.now_us > deadline_us)
+			late = true;
+	}
+};
+
+
+/**
+ * Xorshift pseudo-random number generator
+ */
+struct Test::Random
+{
+	uint64_t _state;
+
+	uint64_t next()
+	{
+		_state ^= _state << 13;
+		_state ^= _state >> 7;
+		_state ^= _state << 17;
+		return _state;
+	}
+};
+
+
+/**
+ * Timeouts of one scheduler, which starts at a given time
+ */
+struct Test::Round
+{
+	Allocator &_alloc;
+
+	unsigned const _num_timeouts;
+
+	Virtual_time_source _time_source { };
+
+	Timeout_scheduler _scheduler { _time_source, Microseconds(0) };
+
+	Entry **_entries = nullptr;
+
+	/*
+	 * Noncopyable
+	 */
+	Round(Round const &);
+	Round &operator = (Round const &);
+
+	Round(Allocator &alloc, unsigned num_timeouts, uint64_t start_us)
+	:
+		_alloc(alloc), _num_timeouts(num_timeouts)
+	{
+		_time_source.now_us = start_us;
+
+		_entries = new (_alloc) Entry*[_num_timeouts];
+		for (unsigned i = 0; i < _num_timeouts; i++)
+			_entries[i] = new (_alloc) Entry(_time_source, _scheduler);
+	}
+
+	~Round()
+	{
+		for (unsigned i = 0; i < _num_timeouts; i++)
+			destroy(_alloc, _entries[i]);
+		destroy(_alloc, _entries);
+	}
+
+	Entry &entry(unsigned i) { return *_entries[i]; }
+
+	Virtual_time_source &time_source() { return _time_source; }
+
+	bool check() const
+	{
+		unsigned expected = 0, triggered = 0;
+		bool ok = true;
+		for (unsigned i = 0; i < _num_timeouts; i++) {
+			Entry const &entry = *_entries[i];
+			bool const due = entry.deadline_us != ~(uint64_t)0;
+			expected  += due;
+			triggered += entry.triggered;
+			if (entry.early || entry.late || entry.triggered != (due ? 1U : 0U))
+				ok = false;
+		}
+		if (!ok)
+			error("timeouts triggered: ", triggered, " expected: ", expected);
+
+		return ok;
+	}
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	unsigned const _num_timeouts {
+		_config.node().attribute_value("timeouts", 100000U) };
+
+	uint64_t const _max_duration_us {
+		_config.node().attribute_value("max_duration_us", (uint64_t)60'000'000) };
+
+	Random _random { 0x9e3779b97f4a7c15ULL };
+
+	/*
+	 * Noncopyable
+	 */
+	Main(Main const &);
+	Main &operator = (Main const &);
+
+	uint64_t _random_duration_us() { return 1 + _random.next() % _max_duration_us; }
+
+	void _measure(char const *what, unsigned count, auto const &fn)
+	{
+		uint64_t const start_us = _timer.elapsed_us();
+		fn();
+		uint64_t const duration_us = _timer.elapsed_us() - start_us;
+
+		log(what, ": ", count, " in ", duration_us, " us (",
+		    duration_us ? (uint64_t)count*1000*1000/duration_us : 0, "/s)");
+	}
+
+	bool _run(uint64_t start_us)
+	{
+		log("start at ", start_us, " us");
+
+		Round round { _heap, _num_timeouts, start_us };
+		Virtual_time_source &time_source = round.time_source();
+
+		_measure("schedule", _num_timeouts, [&] {
+			for (unsigned i = 0; i < _num_timeouts; i++)
+				round.entry(i).schedule(_random_duration_us()); });
+
+		_measure("re-schedule", _num_timeouts, [&] {
+			for (unsigned i = 0; i < _num_timeouts; i++)
+				round.entry(i).schedule(_random_duration_us()); });
+
+		_measure("discard", _num_timeouts/2, [&] {
+			for (unsigned i = 0; i < _num_timeouts; i += 2)
+				round.entry(i).discard(); });
+
+		unsigned wakeups = 0;
+		_measure("expire", _num_timeouts - _num_timeouts/2, [&] {
+			uint64_t const end_us = time_source.now_us + _max_duration_us;
+			while (time_source.now_us < end_us) {
+				time_source.advance_to(
+					min(max(time_source.deadline_us, time_source.now_us + 1), end_us));
+				wakeups++;
+			}
+		});
+		log("wakeups: ", wakeups);
+
+		return round.check();
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- timeout-scheduler benchmark started ---");
+
+		uint64_t const wheel_range_us = (uint64_t)1 << 36;
+
+		bool const ok = _run(1000)
+		             && _run(wheel_range_us + 1000)
+		             && _run(2*wheel_range_us - _max_duration_us/2);
+
+		if (!ok) {
+			_env.parent().exit(-1);
+			return;
+		}
+		log("--- timeout-scheduler benchmark finished ---");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -122,6 +122,8 @@ class Tresor_tester::Benchmark : Noncopyable
 		Microseconds const _start_time;
 		Number_of_blocks _num_virt_blks_read { };
 		Number_of_blocks _num_virt_blks_written { };
+		Vbd_node_cache::Stats const _start_node_cache_stats;
+		Vbd_node_cache::Stats _node_cache_stats { _start_node_cache_stats };
 
 		/*
 		 * Noncopyable
@@ -131,9 +133,10 @@ class Tresor_tester::Benchmark : Noncopyable
 
 	public:
 
-		Benchmark(Timer::Connection &timer, Label const &label)
+		Benchmark(Timer::Connection &timer, Label const &label, Vbd_node_cache::Stats const &node_cache_stats)
 		:
-			_timer(timer), _label(label), _start_time(timer.curr_time().trunc_to_plain_us())
+			_timer(timer), _label(label), _start_time(timer.curr_time().trunc_to_plain_us()),
+			_start_node_cache_stats(node_cache_stats)
 		{ }
 
 		~Benchmark()
@@ -165,11 +168,23 @@ class Tresor_tester::Benchmark : Noncopyable
 				log("   Have written ", mibyte_written, " mebibyte in total.");
 				log("   Have written ", mibyte_per_sec_written, " mebibyte per second.");
 			}
+			/* the statistics restart whenever the VBD gets re-constructed */
+			bool const node_cache_stats_valid {
+				_node_cache_stats.hits >= _start_node_cache_stats.hits &&
+				_node_cache_stats.misses >= _start_node_cache_stats.misses };
+
+			uint64_t const node_cache_hits { _node_cache_stats.hits - _start_node_cache_stats.hits };
+			uint64_t const node_cache_misses { _node_cache_stats.misses - _start_node_cache_stats.misses };
+			if (node_cache_stats_valid && node_cache_hits + node_cache_misses)
+				log("   Have hit the VBD node cache ", node_cache_hits, " times and missed it ", node_cache_misses, " times.");
+
 			log("");
 		}
 
 		void raise_num_virt_blks_read() { _num_virt_blks_read++; }
 		void raise_num_virt_blks_written() { _num_virt_blks_written++; }
+
+		void node_cache_stats(Vbd_node_cache::Stats const &stats) { _node_cache_stats = stats; }
 };
 
 struct Tresor_tester::Start_benchmark_node : Noncopyable
@@ -493,6 +508,11 @@ class Tresor_tester::Main : Vfs::Env::User, Client_data_interface, Crypto_key_fi
 			destroy(_heap, &ref);
 		}
 
+		Vbd_node_cache::Stats _node_cache_stats() const
+		{
+			return _vbd.constructed() ? _vbd->node_cache_stats() : Vbd_node_cache::Stats { 0, 0 };
+		}
+
 		void _reset_snap_refs()
 		{
 			while (_snap_refs.first())
@@ -662,7 +682,7 @@ class Tresor_tester::Main : Vfs::Env::User, Client_data_interface, Crypto_key_fi
 				switch(cmd.state) {
 				case Command::INIT:
 
-					_benchmark.construct(_timer, cmd.start_benchmark_node->label);
+					_benchmark.construct(_timer, cmd.start_benchmark_node->label, _node_cache_stats());
 					_mark_command_complete(cmd, true);
 					progress = true;
 					break;
@@ -676,6 +696,7 @@ class Tresor_tester::Main : Vfs::Env::User, Client_data_interface, Crypto_key_fi
 				switch(cmd.state) {
 				case Command::INIT:
 
+					_benchmark->node_cache_stats(_node_cache_stats());
 					_benchmark.destruct();
 					_mark_command_complete(cmd, true);
 					progress = true;
@@ -21,7 +21,93 @@
 #include <tresor/client_data_interface.h>
 #include <tresor/crypto.h>
 
-namespace Tresor { class Virtual_block_device; }
+namespace Tresor {
+
+	class Vbd_node_cache;
+	class Virtual_block_device;
+}
+
+/**
+ * Cache of inner type-1 node blocks that already passed the hash check
+ *
+ * An entry is keyed by the PBA, generation, and hash recorded in the parent
+ * node (or snapshot) of the block. As a lookup must match the hash as well,
+ * a block that was rewritten in place can never produce a stale hit. When
+ * the cache is full, the least recently used entry gets replaced.
+ */
+class Tresor::Vbd_node_cache : Noncopyable
+{
+	public:
+
+		enum { NUM_ENTRIES = 32 };
+
+		struct Stats
+		{
+			uint64_t hits;
+			uint64_t misses;
+		};
+
+	private:
+
+		struct Entry
+		{
+			Type_1_node       key      { };
+			Type_1_node_block blk      { };
+			uint64_t          last_use { 0 };   /* 0 if unused */
+		};
+
+		Entry    _entries[NUM_ENTRIES] { };
+		uint64_t _use_count { 0 };
+		Stats    _stats     { 0, 0 };
+
+		static bool _matches(Type_1_node const &a, Type_1_node const &b) {
+			return a.pba == b.pba && a.gen == b.gen && a.hash == b.hash; }
+
+	public:
+
+		/**
+		 * Copy cached block of 'node' to 'blk'
+		 *
+		 * \return false if the block is not cached
+		 */
+		bool lookup(Type_1_node const &node, Type_1_node_block &blk)
+		{
+			for (Entry &entry : _entries) {
+				if (entry.last_use && _matches(entry.key, node)) {
+					entry.last_use = ++_use_count;
+					blk = entry.blk;
+					_stats.hits++;
+					return true;
+				}
+			}
+			_stats.misses++;
+			return false;
+		}
+
+		void insert(Type_1_node const &node, Type_1_node_block const &blk)
+		{
+			Entry *victim = &_entries[0];
+			for (Entry &entry : _entries) {
+				if (entry.last_use && entry.key.pba == node.pba) {
+					victim = &entry;
+					break;
+				}
+				if (entry.last_use < victim->last_use)
+					victim = &entry;
+			}
+			victim->key      = node;
+			victim->blk      = blk;
+			victim->last_use = ++_use_count;
+		}
+
+		void invalidate()
+		{
+			for (Entry &entry : _entries)
+				entry.last_use = 0;
+		}
+
+		Stats stats() const { return _stats; }
+};
 
 class Tresor::Virtual_block_device : Noncopyable
 {
@@ -32,9 +118,25 @@ class Tresor::Virtual_block_device : Noncopyable
 		class Write_vba;
 		class Extend_tree;
 
+	private:
+
+		Vbd_node_cache _node_cache { };
+
+	public:
+
 		template <typename REQUEST, typename... ARGS>
 		bool execute(REQUEST &req, ARGS &&... args) { return req.execute(args...); }
 
+		bool execute(Read_vba &, Client_data_interface &, Block_io &, Crypto &);
+
+		bool execute(Write_vba &, Client_data_interface &, Block_io &, Free_tree &, Meta_tree &, Crypto &);
+
+		bool execute(Rekey_vba &, Block_io &, Crypto &, Free_tree &, Meta_tree &);
+
+		bool execute(Extend_tree &, Block_io &, Free_tree &, Meta_tree &);
+
+		Vbd_node_cache::Stats node_cache_stats() const { return _node_cache.stats(); }
+
 		static constexpr char const *name() { return "vbd"; }
 };
 
@@ -129,7 +231,8 @@ class Tresor::Virtual_block_device::Read_vba : Noncopyable
 
 	private:
 
-		enum State { INIT, COMPLETE, READ_BLK, READ_BLK_SUCCEEDED, DECRYPT_BLOCK, DECRYPT_BLOCK_SUCCEEDED };
+		enum State {
+			INIT, COMPLETE, READ_BLK, READ_BLK_SUCCEEDED, READ_BLK_CACHED, DECRYPT_BLOCK, DECRYPT_BLOCK_SUCCEEDED };
 
 		using Helper = Request_helper<Read_vba, State>;
 
@@ -143,8 +246,14 @@ class Tresor::Virtual_block_device::Read_vba : Noncopyable
 		Generatable_request<Helper, State, Block_io::Read> _read_block { };
 		Generatable_request<Helper, State, Crypto::Decrypt> _decrypt_block { };
 
+		Type_1_node _parent_node();
+
 		bool _check_and_decode_read_blk(bool &);
 
+		void _read_inner_blk(Vbd_node_cache &, bool &);
+
+		void _handle_decoded_blk(Vbd_node_cache &, bool &);
+
 	public:
 
 		Read_vba(Attr const &attr) : _helper(*this), _attr(attr) { }
@@ -153,7 +262,7 @@ class Tresor::Virtual_block_device::Read_vba : Noncopyable
 
 		void print(Output &out) const { Genode::print(out, "read vba"); }
 
-		bool execute(Client_data_interface &, Block_io &, Crypto &);
+		bool execute(Client_data_interface &, Block_io &, Crypto &, Vbd_node_cache &);
 
 		bool complete() const { return _helper.complete(); }
 		bool success() const { return _helper.success(); }
@@ -219,6 +328,8 @@ class Tresor::Virtual_block_device::Write_vba : Noncopyable
 
 		void _generate_write_blk_req(bool &);
 
+		Type_1_node _parent_node();
+
 	public:
 
 		Write_vba(Attr const &attr) : _helper(*this), _attr(attr) { }
@@ -227,7 +338,7 @@ class Tresor::Virtual_block_device::Write_vba : Noncopyable
 
 		void print(Output &out) const { Genode::print(out, "write vba"); }
 
-		bool execute(Client_data_interface &, Block_io &, Free_tree &, Meta_tree &, Crypto &);
+		bool execute(Client_data_interface &, Block_io &, Free_tree &, Meta_tree &, Crypto &, Vbd_node_cache &);
 
 		bool complete() const { return _helper.complete(); }
 		bool success() const { return _helper.success(); }
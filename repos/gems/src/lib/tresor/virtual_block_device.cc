@@ -17,6 +17,15 @@
 
 using namespace Tresor;
 
+Type_1_node Virtual_block_device::Read_vba::_parent_node()
+{
+	if (_lvl < _attr.in_snap.max_level)
+		return _t1_blks.node(_attr.in_vba, _lvl + 1, _attr.in_vbd_degree);
+
+	return { _attr.in_snap.pba, _attr.in_snap.gen, _attr.in_snap.hash };
+}
+
+
 bool Virtual_block_device::Read_vba::_check_and_decode_read_blk(bool &progress)
 {
 	Hash const *node_hash_ptr;
@@ -44,49 +53,71 @@ bool Virtual_block_device::Read_vba::_check_and_decode_read_blk(bool &progress)
 }
 
 
-bool Virtual_block_device::Read_vba::execute(Client_data_interface &client_data, Block_io &block_io, Crypto &crypto)
+void Virtual_block_device::Read_vba::_read_inner_blk(Vbd_node_cache &node_cache, bool &progress)
+{
+	if (node_cache.lookup(_parent_node(), _t1_blks.items[_lvl])) {
+		_helper.state = READ_BLK_CACHED;
+		progress = true;
+	} else
+		_read_block.generate(_helper, READ_BLK, READ_BLK_SUCCEEDED, progress, _new_pbas.pbas[_lvl], _blk);
+}
+
+
+void Virtual_block_device::Read_vba::_handle_decoded_blk(Vbd_node_cache &node_cache, bool &progress)
+{
+	if (!_lvl) {
+		if (VERBOSE_READ_VBA)
+			log("    ", Branch_lvl_prefix("ciphertext: "), _blk, " ", hash(_blk));
+
+		_decrypt_block.generate(
+			_helper, DECRYPT_BLOCK, DECRYPT_BLOCK_SUCCEEDED, progress, _attr.in_key_id, _new_pbas.pbas[_lvl], _blk);
+		return;
+	}
+	Type_1_node &node { _t1_blks.node(_attr.in_vba, _lvl, _attr.in_vbd_degree) };
+	if (VERBOSE_READ_VBA)
+		log("    ", Branch_lvl_prefix("lvl ", _lvl, " node ", tree_node_index(_attr.in_vba, _lvl, _attr.in_vbd_degree), ": "), node);
+
+	_lvl--;
+	_new_pbas.pbas[_lvl] = node.pba;
+	if (_lvl)
+		_read_inner_blk(node_cache, progress);
+	else
+		if (node.gen == INITIAL_GENERATION) {
+			bzero(&_blk, BLOCK_SIZE);
+			_helper.state = DECRYPT_BLOCK_SUCCEEDED;
+			progress = true;
+		} else
+			_read_block.generate(_helper, READ_BLK, READ_BLK_SUCCEEDED, progress, _new_pbas.pbas[_lvl], _blk);
+}
+
+
+bool Virtual_block_device::Read_vba::execute(Client_data_interface &client_data, Block_io &block_io, Crypto &crypto,
+                                             Vbd_node_cache &node_cache)
 {
 	bool progress = false;
 	switch (_helper.state) {
 	case INIT:
 
 		_lvl = _attr.in_snap.max_level;
-		_read_block.generate(_helper, READ_BLK, READ_BLK_SUCCEEDED, progress, _attr.in_snap.pba, _blk);
+		_new_pbas.pbas[_lvl] = _attr.in_snap.pba;
+		_read_inner_blk(node_cache, progress);
 		if (VERBOSE_READ_VBA)
 			log("  load branch:\n    ", Branch_lvl_prefix("root: "), _attr.in_snap);
 		break;
 
 	case READ_BLK: progress |= _read_block.execute(block_io); break;
 	case READ_BLK_SUCCEEDED:
-	{
-		if (!_check_and_decode_read_blk(progress))
-			break;
-
-		if (!_lvl) {
-			if (VERBOSE_READ_VBA)
-				log("    ", Branch_lvl_prefix("ciphertext: "), _blk, " ", hash(_blk));
 
-			_decrypt_block.generate(
-				_helper, DECRYPT_BLOCK, DECRYPT_BLOCK_SUCCEEDED, progress, _attr.in_key_id, _new_pbas.pbas[_lvl], _blk);
+		if (!_check_and_decode_read_blk(progress))
 			break;
-		}
-		Type_1_node &node { _t1_blks.node(_attr.in_vba, _lvl, _attr.in_vbd_degree) };
-		if (VERBOSE_READ_VBA)
-			log("    ", Branch_lvl_prefix("lvl ", _lvl, " node ", tree_node_index(_attr.in_vba, _lvl, _attr.in_vbd_degree), ": "), node);
 
-		_lvl--;
-		_new_pbas.pbas[_lvl] = node.pba;
 		if (_lvl)
-			_read_block.generate(_helper, READ_BLK, READ_BLK_SUCCEEDED, progress, _new_pbas.pbas[_lvl], _blk);
-		else
-			if (node.gen == INITIAL_GENERATION) {
-				bzero(&_blk, BLOCK_SIZE);
-				_helper.state = DECRYPT_BLOCK_SUCCEEDED;
-				progress = true;
-			} else
-				_read_block.generate(_helper, READ_BLK, READ_BLK_SUCCEEDED, progress, _new_pbas.pbas[_lvl], _blk);
+			node_cache.insert(_parent_node(), _t1_blks.items[_lvl]);
+
+		_handle_decoded_blk(node_cache, progress);
 		break;
-	}
+
+	case READ_BLK_CACHED: _handle_decoded_blk(node_cache, progress); break;
 	case DECRYPT_BLOCK: progress |= _decrypt_block.execute(crypto); break;
 	case DECRYPT_BLOCK_SUCCEEDED:
 
@@ -421,7 +452,17 @@ void Virtual_block_device::Write_vba::_set_new_pbas_and_num_blks_for_alloc()
 }
 
 
-bool Virtual_block_device::Write_vba::execute(Client_data_interface &client_data, Block_io &block_io, Free_tree &free_tree, Meta_tree &meta_tree, Crypto &crypto)
+Type_1_node Virtual_block_device::Write_vba::_parent_node()
+{
+	if (_lvl < _attr.in_out_snap.max_level)
+		return _t1_blks.node(_attr.in_vba, _lvl + 1, _attr.in_vbd_degree);
+
+	return { _attr.in_out_snap.pba, _attr.in_out_snap.gen, _attr.in_out_snap.hash };
+}
+
+
+bool Virtual_block_device::Write_vba::execute(Client_data_interface &client_data, Block_io &block_io, Free_tree &free_tree, Meta_tree &meta_tree, Crypto &crypto,
+                                              Vbd_node_cache &node_cache)
 {
 	bool progress = false;
 	switch (_helper.state) {
@@ -481,6 +522,8 @@ bool Virtual_block_device::Write_vba::execute(Client_data_interface &client_data
 
 		if (!_lvl)
 			_update_nodes_of_branch_of_written_vba();
+		else
+			node_cache.insert(_parent_node(), _t1_blks.items[_lvl]);
 
 		if (_lvl < _attr.in_out_snap.max_level) {
 			_lvl++;
@@ -774,3 +817,41 @@ void Virtual_block_device::Extend_tree::_generate_ft_alloc_req_for_resizing(Tree
 		snap.max_level, _vba, _attr.in_vbd_degree, _attr.in_vbd_highest_vba, _attr.in_rekeying,
 		_attr.in_prev_key_id, 0, _attr.in_rekeying_vba, Free_tree::Allocate_pbas::NON_REKEYING);
 }
+
+
+bool Virtual_block_device::execute(Read_vba &req, Client_data_interface &client_data, Block_io &block_io, Crypto &crypto)
+{
+	return req.execute(client_data, block_io, crypto, _node_cache);
+}
+
+
+bool Virtual_block_device::execute(Write_vba &req, Client_data_interface &client_data, Block_io &block_io,
+                                   Free_tree &free_tree, Meta_tree &meta_tree, Crypto &crypto)
+{
+	return req.execute(client_data, block_io, free_tree, meta_tree, crypto, _node_cache);
+}
+
+
+/*
+ * Rekeying and extending the tree relocate inner nodes wholesale. Cached
+ * blocks would merely occupy entries without ever being hit again.
+ */
+
+bool Virtual_block_device::execute(Rekey_vba &req, Block_io &block_io, Crypto &crypto, Free_tree &free_tree, Meta_tree &meta_tree)
+{
+	bool const progress = req.execute(block_io, crypto, free_tree, meta_tree);
+	if (req.complete())
+		_node_cache.invalidate();
+
+	return progress;
+}
+
+
+bool Virtual_block_device::execute(Extend_tree &req, Block_io &block_io, Free_tree &free_tree, Meta_tree &meta_tree)
+{
+	bool const progress = req.execute(block_io, free_tree, meta_tree);
+	if (req.complete())
+		_node_cache.invalidate();
+
+	return progress;
+}
@@ -20,7 +20,7 @@
 
 namespace Tresor { class Splitter; }
 
-struct Tresor::Splitter : Noncopyable
+class Tresor::Splitter : Noncopyable
 {
 	public:
 
@@ -36,6 +36,7 @@ struct Tresor::Splitter : Noncopyable
 					Generation const in_gen;
 					char *const in_buf_start;
 					size_t const in_buf_num_bytes;
+					Request_tag const in_tag;
 				};
 
 				struct Execute_attr
@@ -68,7 +69,7 @@ struct Tresor::Splitter : Noncopyable
 					Number_of_blocks num_blocks =
 						target_state == READ_MIDDLE_VBAS ? _num_remaining_bytes() / BLOCK_SIZE : 1;
 
-					_read_vbas.construct(Superblock_control::Read_vbas::Attr{_curr_vba(), num_blocks, 0, 0});
+					_read_vbas.construct(Superblock_control::Read_vbas::Attr{_curr_vba(), num_blocks, 0, _attr.in_tag});
 					_helper.state = target_state;
 					progress = true;
 				}
@@ -178,6 +179,7 @@ struct Tresor::Splitter : Noncopyable
 					Generation const in_gen;
 					char const *const in_buf_start;
 					size_t const in_buf_num_bytes;
+					Request_tag const in_tag;
 				};
 
 				struct Execute_attr
@@ -229,10 +231,10 @@ struct Tresor::Splitter : Noncopyable
 
 					switch (target_state) {
 					case READ_FIRST_VBA:
-					case READ_LAST_VBA: _read_vbas.construct(Superblock_control::Read_vbas::Attr{_curr_vba(), num_blocks, 0, 0}); break;
+					case READ_LAST_VBA: _read_vbas.construct(Superblock_control::Read_vbas::Attr{_curr_vba(), num_blocks, 0, _attr.in_tag}); break;
 					case WRITE_FIRST_VBA:
 					case WRITE_MIDDLE_VBAS:
-					case WRITE_LAST_VBA: _write_vbas.construct(Superblock_control::Write_vbas::Attr{_curr_vba(), num_blocks, 0, 0}); break;
+					case WRITE_LAST_VBA: _write_vbas.construct(Superblock_control::Write_vbas::Attr{_curr_vba(), num_blocks, 0, _attr.in_tag}); break;
 					default: ASSERT_NEVER_REACHED;
 					}
 					_helper.state = target_state;
@@ -350,57 +352,18 @@ struct Tresor::Splitter : Noncopyable
 				bool success() const { return _helper.success(); }
 		};
 
-	private:
-
-		Read *_read_ptr { };
-		Write *_write_ptr { };
-
 	public:
 
-		bool execute(Read &req, Read::Execute_attr const &attr)
-		{
-			if (!_read_ptr && !_write_ptr)
-				_read_ptr = &req;
-
-			if (_read_ptr != &req)
-				return false;
+		/*
+		 * The requests of the splitter do not share any state. Several of
+		 * them may thus be executed concurrently as long as the caller
+		 * keeps writes from running alongside other requests. The client
+		 * data of a request is addressed via the tag of the request.
+		 */
 
-			bool progress = req.execute(attr);
-			if (req.complete())
-				_read_ptr = nullptr;
-
-			return progress;
-		}
-
-		bool execute(Write &req, Write::Execute_attr const &attr)
-		{
-			if (!_write_ptr && !_write_ptr)
-				_write_ptr = &req;
+		bool execute(Read &req, Read::Execute_attr const &attr) { return req.execute(attr); }
 
-			if (_write_ptr != &req)
-				return false;
-
-			bool progress = req.execute(attr);
-			if (req.complete())
-				_write_ptr = nullptr;
-
-			return progress;
-		}
-
-		Block const &source_buffer(Virtual_block_address vba)
-		{
-			ASSERT(_write_ptr);
-			return _write_ptr->source_buffer(vba);
-		}
-
-		Block &destination_buffer(Virtual_block_address vba)
-		{
-			if (_read_ptr)
-				return _read_ptr->destination_buffer(vba);
-			if (_write_ptr)
-				return _write_ptr->destination_buffer();
-			ASSERT_NEVER_REACHED;
-		}
+		bool execute(Write &req, Write::Execute_attr const &attr) { return req.execute(attr); }
 
 		static constexpr char const *name() { return "sb_control"; }
 };
@@ -84,6 +84,10 @@ class Vfs_tresor::Data_operation : private Noncopyable
 
 		State _state { INIT };
 		bool const _verbose;
+		Request_tag const _tag;
+		uint64_t &_num_requests;
+		uint64_t _request_id { };
+		Vfs_handle const *_handle_ptr { };
 		Generation _generation { };
 		Vfs::file_size _seek { };
 		bool _success { };
@@ -100,9 +104,32 @@ class Vfs_tresor::Data_operation : private Noncopyable
 			return last_byte > last_file_byte;
 		}
 
+		/*
+		 * Noncopyable
+		 */
+		Data_operation(Data_operation const &) = delete;
+		Data_operation &operator = (Data_operation const &) = delete;
+
+		void _requested(State state)
+		{
+			_state = state;
+			_request_id = ++_num_requests;
+		}
+
 	public:
 
-		Data_operation(bool verbose) : _verbose(verbose) { }
+		/**
+		 * Constructor
+		 *
+		 * \param tag           identifies the operation towards the
+		 *                      'Client_data_interface'
+		 * \param num_requests  counter shared by all data operations, used
+		 *                      for keeping the order of requests
+		 */
+		Data_operation(bool verbose, Request_tag tag, uint64_t &num_requests)
+		:
+			_verbose(verbose), _tag(tag), _num_requests(num_requests)
+		{ }
 
 		Result write(Vfs::file_size seek, Const_byte_range_ptr const &src)
 		{
@@ -111,7 +138,7 @@ class Vfs_tresor::Data_operation : private Noncopyable
 
 				_seek = seek;
 				_src.construct(src.start, src.num_bytes);
-				_state = WRITE_REQUESTED;
+				_requested(WRITE_REQUESTED);
 				if (_verbose)
 					log("write (seek ", _seek, " num_bytes ", _src->num_bytes, ") requested");
 				return PENDING;
@@ -137,7 +164,7 @@ class Vfs_tresor::Data_operation : private Noncopyable
 
 				_seek = seek;
 				_dst.construct(dst.start, dst.num_bytes);
-				_state = READ_REQUESTED;
+				_requested(READ_REQUESTED);
 				if (_verbose)
 					log("read (seek ", _seek, " num_bytes ", _dst->num_bytes, ") requested");
 				return PENDING;
@@ -161,7 +188,7 @@ class Vfs_tresor::Data_operation : private Noncopyable
 			switch (_state) {
 			case INIT:
 
-				_state = SYNC_REQUESTED;
+				_requested(SYNC_REQUESTED);
 				if (_verbose)
 					log("sync requested");
 				return PENDING;
@@ -183,6 +210,66 @@ class Vfs_tresor::Data_operation : private Noncopyable
 
 		bool requested() const { return _state == WRITE_REQUESTED || _state == READ_REQUESTED || _state == SYNC_REQUESTED; }
 
+		bool in_progress() const
+		{
+			return _state == WRITE_STARTED || _state == WRITE || _state == READ_STARTED || _state == READ ||
+			       _state == SYNC_STARTED || _state == SYNC;
+		}
+
+		/**
+		 * Return whether the operation modifies the superblock or the trees
+		 *
+		 * Such an operation must not run alongside any other operation.
+		 */
+		bool exclusive() const
+		{
+			return _state == WRITE_REQUESTED || _state == WRITE_STARTED || _state == WRITE ||
+			       _state == SYNC_REQUESTED || _state == SYNC_STARTED || _state == SYNC;
+		}
+
+		uint64_t request_id() const { return _request_id; }
+
+		bool idle() const { return _state == INIT; }
+
+		bool owned() const { return _handle_ptr; }
+
+		bool owned_by(Vfs_handle const &handle) const { return _handle_ptr == &handle; }
+
+		bool free() const { return !_handle_ptr && _state == INIT; }
+
+		void acquire(Vfs_handle const &handle) { _handle_ptr = &handle; }
+
+		/**
+		 * Detach operation from its VFS handle
+		 *
+		 * A request that was not started yet is dropped. A request in
+		 * progress is finished and its result discarded.
+		 */
+		void release()
+		{
+			_handle_ptr = nullptr;
+			if (requested() || complete()) {
+				_src.destruct();
+				_dst.destruct();
+				_state = INIT;
+			}
+		}
+
+		Block const &source_buffer(Virtual_block_address vba)
+		{
+			ASSERT(_write.constructed());
+			return _write->source_buffer(vba);
+		}
+
+		Block &destination_buffer(Virtual_block_address vba)
+		{
+			if (_read.constructed())
+				return _read->destination_buffer(vba);
+			if (_write.constructed())
+				return _write->destination_buffer();
+			ASSERT_NEVER_REACHED;
+		}
+
 		void start()
 		{
 			switch (_state) {
@@ -207,7 +294,7 @@ class Vfs_tresor::Data_operation : private Noncopyable
 						log("write (seek ", _seek, " num_bytes ", _src->num_bytes, ") failed: range violation");
 					break;
 				}
-				_write.construct(Splitter::Write::Attr{_seek, _generation, _src->start, _src->num_bytes});
+				_write.construct(Splitter::Write::Attr{_seek, _generation, _src->start, _src->num_bytes, _tag});
 				_state = WRITE;
 				progress = true;
 				if (_verbose)
@@ -240,7 +327,7 @@ class Vfs_tresor::Data_operation : private Noncopyable
 						log("read (seek ", _seek, " num_bytes ", _dst->num_bytes, ") failed: range violation");
 					break;
 				}
-				_read.construct(Splitter::Read::Attr{_seek, _generation, _dst->start, _dst->num_bytes});
+				_read.construct(Splitter::Read::Attr{_seek, _generation, _dst->start, _dst->num_bytes, _tag});
 				_state = READ;
 				progress = true;
 				if (_verbose)
@@ -558,6 +645,9 @@ class Vfs_tresor::Plugin : private Noncopyable, private Client_data_interface, p
 
 		enum { MAX_NUM_COMMANDS = 16 };
 
+		/* number of data requests that may be in progress at a time */
+		enum { MAX_NUM_DATA_OPERATIONS = 8 };
+
 		struct Crypto_key
 		{
 			Key_id const key_id;
@@ -592,7 +682,8 @@ class Vfs_tresor::Plugin : private Noncopyable, private Client_data_interface, p
 		Constructible<Crypto_key> _crypto_keys[2] { };
 		Superblock_control::Initialize *_init_sb_control_ptr { };
 		Superblock::State _sb_state { Superblock::INVALID };
-		Data_operation _data_operation { _verbose };
+		uint64_t _num_data_requests { 0 };
+		Constructible<Data_operation> _data_operations[MAX_NUM_DATA_OPERATIONS] { };
 		Rekey_operation _rekey_operation { _verbose };
 		Extend_operation _extend_operation { _verbose };
 		Deinitialize_operation _deinit_operation { _verbose };
@@ -612,6 +703,87 @@ class Vfs_tresor::Plugin : private Noncopyable, private Client_data_interface, p
 			ASSERT_NEVER_REACHED;
 		}
 
+		void _for_each_data_operation(auto const &fn)
+		{
+			for (Constructible<Data_operation> &op : _data_operations)
+				fn(*op);
+		}
+
+		bool _data_operations_requested()
+		{
+			bool result = false;
+			_for_each_data_operation([&] (Data_operation &op) { result |= op.requested(); });
+			return result;
+		}
+
+		bool _data_operations_in_progress()
+		{
+			bool result = false;
+			_for_each_data_operation([&] (Data_operation &op) { result |= op.in_progress(); });
+			return result;
+		}
+
+		/**
+		 * Start requested data operations in the order of their request
+		 *
+		 * Reads proceed concurrently, so that the back-end block I/O of one
+		 * read overlaps with the decryption of another. Writes and syncs
+		 * modify the superblock and the trees. Such an operation starts only
+		 * after all preceding operations completed and defers all succeeding
+		 * operations until it completed itself.
+		 */
+		bool _start_data_operations()
+		{
+			bool progress = false;
+			while (true) {
+				Data_operation *oldest_ptr { };
+				bool exclusive_in_progress = false;
+				_for_each_data_operation([&] (Data_operation &op) {
+					exclusive_in_progress |= op.in_progress() && op.exclusive();
+					if (op.requested() && (!oldest_ptr || op.request_id() < oldest_ptr->request_id()))
+						oldest_ptr = &op;
+				});
+				if (!oldest_ptr || exclusive_in_progress)
+					break;
+
+				if (oldest_ptr->exclusive() && _data_operations_in_progress())
+					break;
+
+				oldest_ptr->start();
+				progress = true;
+			}
+			return progress;
+		}
+
+		Data_operation &_data_operation(Request_tag tag)
+		{
+			ASSERT(tag && tag <= MAX_NUM_DATA_OPERATIONS);
+			return *_data_operations[tag - 1];
+		}
+
+		/**
+		 * Return data operation of VFS handle or allocate a free one
+		 */
+		Data_operation *_data_operation(Vfs_handle const &handle)
+		{
+			Data_operation *result_ptr { };
+			_for_each_data_operation([&] (Data_operation &op) {
+				if (op.owned_by(handle))
+					result_ptr = &op; });
+
+			if (result_ptr)
+				return result_ptr;
+
+			_for_each_data_operation([&] (Data_operation &op) {
+				if (!result_ptr && op.free())
+					result_ptr = &op; });
+
+			if (result_ptr)
+				result_ptr->acquire(handle);
+
+			return result_ptr;
+		}
+
 		bool _try_start_operation()
 		{
 			if (_deinit_operation.requested()) {
@@ -619,8 +791,8 @@ class Vfs_tresor::Plugin : private Noncopyable, private Client_data_interface, p
 				_state = DEINITIALIZE_OPERATION;
 				return true;
 			}
-			if (_data_operation.requested()) {
-				_data_operation.start();
+			if (_data_operations_requested()) {
+				_start_data_operations();
 				_state = DATA_OPERATION;
 				return true;
 			}
@@ -675,8 +847,21 @@ class Vfs_tresor::Plugin : private Noncopyable, private Client_data_interface, p
 
 			case DATA_OPERATION:
 
-				progress |= _data_operation.execute({_splitter, _sb_control, *this, _vbd, _free_tree, _meta_tree, _block_io, _crypto, _trust_anchor}) ;
-				if (_data_operation.complete()) {
+				_for_each_data_operation([&] (Data_operation &op) {
+					progress |= op.execute({_splitter, _sb_control, *this, _vbd, _free_tree, _meta_tree, _block_io, _crypto, _trust_anchor});
+
+					/* drop result of an operation whose handle got closed */
+					if (op.complete() && !op.owned())
+						op.release();
+				});
+				/*
+				 * A paused extend or rekey operation resumes as soon as the
+				 * data operations in progress are done.
+				 */
+				if (!_extend_operation.paused() && !_rekey_operation.paused())
+					progress |= _start_data_operations();
+
+				if (!_data_operations_in_progress()) {
 					if (!_try_resume_operation())
 						if (!_try_start_operation())
 							_state = NO_OPERATION;
@@ -702,8 +887,8 @@ class Vfs_tresor::Plugin : private Noncopyable, private Client_data_interface, p
 					progress = true;
 				}
 				if (_extend_operation.paused()) {
-					if (_data_operation.requested()) {
-						_data_operation.start();
+					if (_data_operations_requested()) {
+						_start_data_operations();
 						_state = DATA_OPERATION;
 					} else
 						_extend_operation.resume();
@@ -720,8 +905,8 @@ class Vfs_tresor::Plugin : private Noncopyable, private Client_data_interface, p
 					progress = true;
 				}
 				if (_rekey_operation.paused()) {
-					if (_data_operation.requested()) {
-						_data_operation.start();
+					if (_data_operations_requested()) {
+						_start_data_operations();
 						_state = DATA_OPERATION;
 					} else
 						_rekey_operation.resume();
@@ -779,12 +964,12 @@ class Vfs_tresor::Plugin : private Noncopyable, private Client_data_interface, p
 
 		void obtain_data(Obtain_data_attr const &attr) override
 		{
-			attr.out_blk = _splitter.source_buffer(attr.in_vba);
+			attr.out_blk = _data_operation(attr.in_req_tag).source_buffer(attr.in_vba);
 		}
 
 		void supply_data(Supply_data_attr const &attr) override
 		{
-			_splitter.destination_buffer(attr.in_vba) = attr.in_blk;
+			_data_operation(attr.in_req_tag).destination_buffer(attr.in_vba) = attr.in_blk;
 		}
 
 	public:
@@ -800,6 +985,9 @@ class Vfs_tresor::Plugin : private Noncopyable, private Client_data_interface, p
 			_init_sb_control_ptr = new (_vfs_env.alloc()) Superblock_control::Initialize({_sb_state});
 			if (_verbose)
 				log("initialize started");
+
+			for (unsigned idx = 0; idx < MAX_NUM_DATA_OPERATIONS; idx++)
+				_data_operations[idx].construct(_verbose, idx + 1, _num_data_requests);
 		}
 
 		template <typename FUNC>
@@ -810,14 +998,31 @@ class Vfs_tresor::Plugin : private Noncopyable, private Client_data_interface, p
 				func(_data_file_size());
 		}
 
+		/**
+		 * Call 'func' with the data operation of 'handle'
+		 *
+		 * If all data operations are occupied by other handles, 'func' is
+		 * not called.
+		 */
 		template <typename FUNC>
-		void with_data_operation(FUNC && func)
+		void with_data_operation(Vfs_handle const &handle, FUNC && func)
 		{
 			_execute();
-			func(_data_operation);
+			if (Data_operation *op_ptr = _data_operation(handle)) {
+				func(*op_ptr);
+				if (op_ptr->idle())
+					op_ptr->release();
+			}
 			_execute();
 		}
 
+		void release_data_operation(Vfs_handle const &handle)
+		{
+			_for_each_data_operation([&] (Data_operation &op) {
+				if (op.owned_by(handle))
+					op.release(); });
+		}
+
 		template <typename FUNC>
 		void with_rekey_operation(FUNC && func)
 		{
@@ -900,6 +1105,8 @@ class Vfs_tresor::Data_file_system : private Noncopyable, public Single_file_sys
 					Single_vfs_handle(dir_service, file_io_service, alloc, 0), _plugin(plugin)
 				{ }
 
+				~Vfs_handle() { _plugin.release_data_operation(*this); }
+
 				/***********************
 				 ** Single_vfs_handle **
 				 ***********************/
@@ -908,7 +1115,7 @@ class Vfs_tresor::Data_file_system : private Noncopyable, public Single_file_sys
 				{
 					out_count = 0;
 					Read_result result = READ_QUEUED;
-					_plugin.with_data_operation([&] (Data_operation &data_operation) {
+					_plugin.with_data_operation(*this, [&] (Data_operation &data_operation) {
 
 						switch (data_operation.read(seek(), dst)) {
 						case Data_operation::PENDING: break;
@@ -928,7 +1135,7 @@ class Vfs_tresor::Data_file_system : private Noncopyable, public Single_file_sys
 				{
 					out_count = 0;
 					Write_result result = WRITE_ERR_WOULD_BLOCK;
-					_plugin.with_data_operation([&] (Data_operation &data_operation) {
+					_plugin.with_data_operation(*this, [&] (Data_operation &data_operation) {
 
 						switch (data_operation.write(seek(), src)) {
 						case Data_operation::PENDING: break;
@@ -947,7 +1154,7 @@ class Vfs_tresor::Data_file_system : private Noncopyable, public Single_file_sys
 				Sync_result sync() override
 				{
 					Sync_result result = SYNC_QUEUED;
-					_plugin.with_data_operation([&] (Data_operation &data_operation) {
+					_plugin.with_data_operation(*this, [&] (Data_operation &data_operation) {
 
 						switch (data_operation.sync()) {
 						case Data_operation::PENDING: break;
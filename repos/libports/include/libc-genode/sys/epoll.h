@@ -0,0 +1,75 @@
+/*
+ * \brief  Linux-compatible epoll interface
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The epoll functions are implemented on top of the libc's kqueue. With
+ * EPOLLET, the current state of a file descriptor is reported once after
+ * EPOLL_CTL_ADD or EPOLL_CTL_MOD, after new data became available, and
+ * after a non-blocking write that returned early once the file descriptor
+ * became writeable again. EPOLLERR, EPOLLHUP, and EPOLLRDHUP are never
+ * reported.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__LIBC_GENODE__SYS__EPOLL_H_
+#define _INCLUDE__LIBC_GENODE__SYS__EPOLL_H_
+
+#include <sys/cdefs.h>
+#include <sys/types.h>
+#include <sys/signal.h>
+#include <fcntl.h>
+#include <stdint.h>
+
+#define EPOLLIN        0x00000001
+#define EPOLLPRI       0x00000002
+#define EPOLLOUT       0x00000004
+#define EPOLLERR       0x00000008
+#define EPOLLHUP       0x00000010
+#define EPOLLRDNORM    0x00000040
+#define EPOLLRDBAND    0x00000080
+#define EPOLLWRNORM    0x00000100
+#define EPOLLWRBAND    0x00000200
+#define EPOLLMSG       0x00000400
+#define EPOLLRDHUP     0x00002000
+#define EPOLLEXCLUSIVE 0x10000000
+#define EPOLLWAKEUP    0x20000000
+#define EPOLLONESHOT   0x40000000
+#define EPOLLET        0x80000000
+
+#define EPOLL_CTL_ADD 1
+#define EPOLL_CTL_DEL 2
+#define EPOLL_CTL_MOD 3
+
+#define EPOLL_CLOEXEC O_CLOEXEC
+
+typedef union epoll_data {
+	void     *ptr;
+	int       fd;
+	uint32_t  u32;
+	uint64_t  u64;
+} epoll_data_t;
+
+struct epoll_event {
+	uint32_t     events;
+	epoll_data_t data;
+};
+
+__BEGIN_DECLS
+
+int epoll_create(int size);
+int epoll_create1(int flags);
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event);
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout);
+int epoll_pwait(int epfd, struct epoll_event *events, int maxevents, int timeout,
+                const sigset_t *sigmask);
+
+__END_DECLS
+
+#endif /* _INCLUDE__LIBC_GENODE__SYS__EPOLL_H_ */
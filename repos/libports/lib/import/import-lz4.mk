@@ -1,2 +1 @@
-LZ4_DIR := $(call select_from_ports,lz4)
-INC_DIR += $(LZ4_DIR)/include/lz4
+INC_DIR += $(call select_from_ports,lz4)/include/lz4
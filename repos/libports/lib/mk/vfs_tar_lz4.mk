@@ -0,0 +1,11 @@
+SRC_CC = vfs.cc
+
+VFS_DIR := $(call select_from_repositories,src/lib/vfs)
+
+INC_DIR += $(VFS_DIR)
+
+LIBS += lz4
+
+vpath %.cc $(REP_DIR)/src/lib/vfs/tar_lz4
+
+SHARED_LIB = yes
@@ -0,0 +1,13 @@
+content: include lib/symbols/lz4 LICENSE
+
+PORT_DIR := $(call port_dir,$(REP_DIR)/ports/lz4)
+
+include:
+	mkdir -p $@
+	cp -r $(PORT_DIR)/include/lz4/* $@/
+
+lib/symbols/lz4:
+	$(mirror_from_rep_dir)
+
+LICENSE:
+	cp $(PORT_DIR)/src/lib/lz4/lib/LICENSE $@
@@ -0,0 +1,13 @@
+content: src/lib/lz4 lib/mk/lz4.mk LICENSE
+
+PORT_DIR := $(call port_dir,$(REP_DIR)/ports/lz4)
+
+src/lib/lz4:
+	mkdir -p $@
+	cp -r $(PORT_DIR)/src/lib/lz4/* $@
+
+lib/mk/lz4.mk:
+	$(mirror_from_rep_dir)
+
+LICENSE:
+	cp $(PORT_DIR)/src/lib/lz4/lib/LICENSE $@
@@ -0,0 +1,2 @@
+SRC_DIR := src/test/libc_epoll
+include $(GENODE_DIR)/repos/base/recipes/src/content.inc
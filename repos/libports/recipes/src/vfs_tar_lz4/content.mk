@@ -0,0 +1,15 @@
+MIRROR_FROM_REP_DIR := lib/mk/vfs_tar_lz4.mk src/lib/vfs/tar_lz4
+
+MIRROR_FROM_OS := src/lib/vfs/tar_file_system.h
+
+content: $(MIRROR_FROM_REP_DIR) $(MIRROR_FROM_OS) LICENSE
+
+$(MIRROR_FROM_REP_DIR):
+	$(mirror_from_rep_dir)
+
+$(MIRROR_FROM_OS):
+	mkdir -p $(dir $@)
+	cp -r $(GENODE_DIR)/repos/os/$@ $@
+
+LICENSE:
+	cp $(GENODE_DIR)/LICENSE $@
@@ -22,6 +22,7 @@
 #include <base/allocator.h>
 #include <base/id_space.h>
 #include <util/bit_allocator.h>
+#include <util/list.h>
 #include <vfs/vfs_handle.h>
 
 /* libc includes */
@@ -187,6 +188,106 @@ struct Libc::File_descriptor
 	bool cloexec  = 0;  /* for 'fcntl' */
 	bool modified = false;
 
+	/**
+	 * Interface for observing the readiness of the file descriptor
+	 *
+	 * The observer methods are called with '_observers_mutex' held. They
+	 * must neither register nor unregister observers.
+	 */
+	struct Ready_observer : Genode::Interface, Genode::List<Ready_observer>::Element
+	{
+		/**
+		 * Respond to a read-ready response, called during I/O signal dispatch
+		 */
+		virtual void read_ready(File_descriptor &) = 0;
+
+		/**
+		 * Respond to a non-blocking write that could not be completed
+		 */
+		virtual void write_blocked(File_descriptor &) = 0;
+
+		/**
+		 * Respond to the destruction of the file descriptor
+		 *
+		 * The observer is unregistered already.
+		 */
+		virtual void closed(File_descriptor &) = 0;
+	};
+
+	Genode::Mutex                _observers_mutex { };
+	Genode::List<Ready_observer> _observers       { };
+
+	/*
+	 * File descriptor that shares the readiness of this one, e.g., the
+	 * socket file descriptor of a socket-fs data file
+	 */
+	File_descriptor *ready_parent = nullptr;
+
+	void add_ready_observer(Ready_observer &observer)
+	{
+		Genode::Mutex::Guard guard(_observers_mutex);
+		_observers.insert(&observer);
+	}
+
+	void remove_ready_observer(Ready_observer &observer)
+	{
+		Genode::Mutex::Guard guard(_observers_mutex);
+		_observers.remove(&observer);
+	}
+
+	void notify_read_ready()
+	{
+		{
+			Genode::Mutex::Guard guard(_observers_mutex);
+			for (Ready_observer *o = _observers.first(); o; o = o->next())
+				o->read_ready(*this);
+		}
+
+		if (ready_parent)
+			ready_parent->notify_read_ready();
+	}
+
+	void notify_write_blocked()
+	{
+		{
+			Genode::Mutex::Guard guard(_observers_mutex);
+			for (Ready_observer *o = _observers.first(); o; o = o->next())
+				o->write_blocked(*this);
+		}
+
+		if (ready_parent)
+			ready_parent->notify_write_blocked();
+	}
+
+	/**
+	 * Read-ready response handler of the VFS handle of the file descriptor
+	 *
+	 * Read-ready responses are reported to the observers of the file
+	 * descriptor before being passed on to the libc kernel.
+	 */
+	struct Read_ready_handler : Vfs::Read_ready_response_handler
+	{
+		File_descriptor &_fd;
+
+		Vfs::Read_ready_response_handler *_next = nullptr;
+
+		Read_ready_handler(File_descriptor &fd) : _fd(fd) { }
+
+		void read_ready_response() override
+		{
+			_fd.notify_read_ready();
+
+			if (_next)
+				_next->read_ready_response();
+		}
+	} _read_ready_handler { *this };
+
+	Vfs::Read_ready_response_handler &read_ready_handler(Vfs::Read_ready_response_handler &next)
+	{
+		_read_ready_handler._next = &next;
+		return _read_ready_handler;
+	}
+
 	File_descriptor(Id_space &id_space, Plugin &plugin, Plugin_context &context,
 	                Id_space::Id id)
 	: _elem(*this, id_space, id), plugin(&plugin), context(&context) { }
@@ -194,6 +295,12 @@ struct Libc::File_descriptor
 	~File_descriptor()
 	{
 		_close_aio_handles();
+
+		Genode::Mutex::Guard guard(_observers_mutex);
+		while (Ready_observer *o = _observers.first()) {
+			_observers.remove(o);
+			o->closed(*this);
+		}
 	}
 
 	void path(char const *newpath);
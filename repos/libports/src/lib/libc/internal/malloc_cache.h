@@ -0,0 +1,106 @@
+/*
+ * \brief  Per-thread cache of small malloc blocks
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIBC__INTERNAL__MALLOC_CACHE_H_
+#define _LIBC__INTERNAL__MALLOC_CACHE_H_
+
+/* Genode includes */
+#include <util/noncopyable.h>
+
+/* libc-internal includes */
+#include <internal/types.h>
+
+namespace Libc {
+
+	struct Pthread;
+	struct Malloc_cache;
+
+	/**
+	 * Return cached blocks of 'Pthread' to the shared slab allocators
+	 *
+	 * The cache of the thread stays disabled afterwards.
+	 */
+	void release_malloc_cache(Pthread &);
+}
+
+
+/**
+ * Free lists of slab blocks owned by one thread
+ *
+ * The cache holds raw slab blocks, i.e., the memory returned by the slab
+ * allocator of the size class before the malloc meta data is placed. The
+ * cache is filled and drained in batches by 'Libc::Malloc' while holding
+ * the global malloc mutex. All other accesses happen by the owning thread
+ * only.
+ */
+struct Libc::Malloc_cache : Noncopyable
+{
+	enum {
+		SLAB_START  = 5,  /* 32 bytes (log2) */
+		SLAB_STOP   = 11, /* 2048 bytes (log2) */
+		NUM_CLASSES = (SLAB_STOP - SLAB_START) + 1,
+		BIN_BYTES   = 8*1024,
+		MIN_BLOCKS  = 4,
+	};
+
+	struct Block { Block *next; };
+
+	struct Bin
+	{
+		Block    *head  = nullptr;
+		unsigned  count = 0;
+
+		void push(void *ptr)
+		{
+			Block *block = (Block *)ptr;
+			block->next = head;
+			head = block;
+			count++;
+		}
+
+		void *pop()
+		{
+			Block *block = head;
+			if (block) {
+				head = block->next;
+				count--;
+			}
+			return block;
+		}
+	};
+
+	Bin bins[NUM_CLASSES] { };
+
+	bool enabled = true;
+
+	/* malloc instance the cached blocks belong to, see 'Libc::Malloc' */
+	unsigned generation = 0;
+
+	Malloc_cache() { }
+
+	/**
+	 * Maximum number of blocks cached for size class 'log2'
+	 */
+	static unsigned capacity(unsigned log2)
+	{
+		unsigned const blocks = BIN_BYTES >> log2;
+		return blocks < (unsigned)MIN_BLOCKS ? (unsigned)MIN_BLOCKS : blocks;
+	}
+
+	/**
+	 * Number of blocks moved at once between the cache and the slabs
+	 */
+	static unsigned batch(unsigned log2) { return capacity(log2)/2; }
+};
+
+#endif /* _LIBC__INTERNAL__MALLOC_CACHE_H_ */
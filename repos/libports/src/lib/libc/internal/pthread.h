@@ -28,6 +28,7 @@
 
 /* libc-internal includes */
 #include <internal/types.h>
+#include <internal/malloc_cache.h>
 #include <internal/monitor.h>
 #include <internal/timer.h>
 
@@ -183,6 +184,9 @@ struct Libc::Pthread : Noncopyable
 
 		int thread_local_errno = 0;
 
+		/* small blocks cached by 'malloc' for this thread */
+		Malloc_cache malloc_cache { };
+
 		/**
 		 * Constructor for threads created via 'pthread_create'
 		 */
@@ -217,6 +221,8 @@ struct Libc::Pthread : Noncopyable
 		 */
 		Pthread(Thread &existing_thread, void *stack_address);
 
+		~Pthread() { release_malloc_cache(*this); }
+
 		static void init_tls_support();
 
 		void start() { _thread.start(); }
@@ -234,6 +240,7 @@ struct Libc::Pthread : Noncopyable
 		void exit(void *retval) __attribute__((noreturn))
 		{
 			while (cleanup_pop(1)) { }
+			release_malloc_cache(*this);
 			_retval = retval;
 			cancel();
 
@@ -77,10 +77,19 @@ class Libc::Vfs_plugin final : public Plugin
 			void            * const start;
 			Vfs::Vfs_handle * const reference_handle;
 
+			/* VFS dataspace attached for a read-only private mapping */
+			Dataspace_capability const ds;
+			Absolute_path        const ds_path;
+
 			Mmap_entry(Registry<Mmap_entry> &registry, void *start,
 			           Vfs::Vfs_handle *reference_handle)
 			: Registry<Mmap_entry>::Element(registry, *this), start(start),
-			  reference_handle(reference_handle) { }
+			  reference_handle(reference_handle), ds(), ds_path() { }
+
+			Mmap_entry(Registry<Mmap_entry> &registry, void *start,
+			           Dataspace_capability ds, char const *ds_path)
+			: Registry<Mmap_entry>::Element(registry, *this), start(start),
+			  reference_handle(nullptr), ds(ds), ds_path(ds_path) { }
 		};
 
 		File_descriptor_allocator        &_fd_alloc;
@@ -130,6 +139,13 @@ class Libc::Vfs_plugin final : public Plugin
 		 */
 		void _vfs_write_mtime(Vfs::Vfs_handle&);
 
+		/**
+		 * Attach the VFS dataspace of a file for a read-only private mapping
+		 *
+		 * \return local address, or nullptr if the file must be copied
+		 */
+		void *_mmap_readonly_dataspace(::size_t, File_descriptor *, ::off_t);
+
 		struct Ioctl_result
 		{
 			bool handled;
@@ -13,6 +13,7 @@
 
 /* Libc includes */
 #include <sys/event.h>
+#include <sys/epoll.h>
 #include <errno.h>
 #include <assert.h>
 
@@ -27,17 +28,12 @@
 /* Genode includes */
 #include <base/mutex.h>
 #include <util/avl_tree.h>
+#include <util/fifo.h>
 #include <util/register.h>
 
 using namespace Libc;
 
-namespace Libc {
-	class Kqueue;
-
-	bool read_ready_from_kernel(File_descriptor *);
-	void notify_read_ready_from_kernel(File_descriptor *);
-	bool write_ready_from_kernel(File_descriptor *);
-}
+namespace Libc { class Kqueue; }
 
 namespace { using Fn = Libc::Monitor::Function_result; }
 
@@ -86,6 +82,23 @@ static consteval int pos(int flag)
 
 /*
  * Kqueue backend implementation
+ *
+ * Each kqueue keeps a list of elements that need to be checked on the next
+ * collection of events, the ready list. An element enters the ready list
+ * when it is added or enabled, when its file descriptor reports a read-ready
+ * response, or when its file descriptor is closed. Elements that are ready
+ * remain on the ready list (level-triggered). Elements that are not ready
+ * leave the list until their file descriptor reports a read-ready response.
+ * As the VFS does not report write readiness, elements monitoring write
+ * readiness remain on the ready list. Hence, the costs of collecting events
+ * depend on the number of file descriptors with I/O activity instead of the
+ * number of registered elements.
+ *
+ * Edge-triggered epoll elements (EPOLLET) are reported only after an edge,
+ * i.e., after they were added or modified, after a read-ready response of
+ * their file descriptor, or once a non-blocking write that could not be
+ * completed is followed by write readiness. Only in the latter case, they
+ * remain on the ready list until the file descriptor becomes writeable.
  */
 
 struct Libc::Kqueue
@@ -102,6 +115,12 @@ struct Libc::Kqueue
 		EVFILT_READ |
 		EVFILT_WRITE;
 
+	/*
+	 * Filter of elements registered via the epoll compatibility layer,
+	 * which does not collide with the EVFILT_* values
+	 */
+	static constexpr short FILTER_EPOLL = 1;
+
 	struct Kqueue_flags : Genode::Register<32> {
 		struct Add     : Bitfield<    pos(EV_ADD), 1> { };
 		struct Delete  : Bitfield< pos(EV_DELETE), 1> { };
@@ -113,8 +132,56 @@ struct Libc::Kqueue
 
 	struct Kqueue_elements;
 
-	struct Kqueue_element : kevent, public Avl_node<Kqueue_element>
+	struct Kqueue_element : kevent, public Avl_node<Kqueue_element>,
+	                        File_descriptor::Ready_observer
 	{
+		Kqueue &_kqueue;
+
+		/* nullptr once the file descriptor got closed */
+		File_descriptor *fd;
+
+		/* poll(2) events monitored by the element */
+		short poll_events;
+
+		/* state of elements registered via 'epoll_ctl' */
+		uint32_t     epoll_events { 0 };
+		epoll_data_t epoll_data   { };
+
+		/* edge of an EPOLLET element, protected by '_ready_mutex' */
+		bool epoll_edge        { false };
+		bool epoll_out_blocked { false };
+
+		Fifo_element<Kqueue_element> ready_elem { *this };
+
+		static short _filter_poll_events(short filter)
+		{
+			switch (filter) {
+			case EVFILT_READ:  return POLLIN;
+			case EVFILT_WRITE: return POLLOUT;
+			}
+			return 0;
+		}
+
+		Kqueue_element(Kqueue &kqueue, struct kevent const &k, File_descriptor &fd)
+		:
+			kevent(k), _kqueue(kqueue), fd(&fd),
+			poll_events(_filter_poll_events(k.filter))
+		{ }
+
+		bool disabled() const { return Kqueue_flags::Disable::get(flags); }
+
+		void enable()
+		{
+			Kqueue_flags::Disable::clear((Kqueue_flags::access_t &)flags);
+			Kqueue_flags::Enable::set((Kqueue_flags::access_t &)flags);
+		}
+
+		void disable()
+		{
+			Kqueue_flags::Enable::clear((Kqueue_flags::access_t &)flags);
+			Kqueue_flags::Disable::set((Kqueue_flags::access_t &)flags);
+		}
+
 		Kqueue_element *find_by_kevent(struct kevent const &k)
 		{
 			if (*this == k) return this;
@@ -145,6 +212,25 @@ struct Libc::Kqueue
 
 			return true;
 		}
+
+		/*********************************************
+		 ** File_descriptor::Ready_observer interface **
+		 *********************************************/
+
+		void read_ready(File_descriptor &) override
+		{
+			_kqueue._mark_edge(*this);
+		}
+
+		void write_blocked(File_descriptor &) override
+		{
+			_kqueue._mark_write_blocked(*this);
+		}
+
+		void closed(File_descriptor &) override
+		{
+			_kqueue._mark_closed(*this);
+		}
 	};
 
 	struct Kqueue_elements : Avl_tree<Kqueue_element>
@@ -187,42 +273,103 @@ struct Libc::Kqueue
 	Kqueue_elements    _requests;
 
 	/*
-	 * Collect invalid elements for deletion.
-	 * This needs to be done out of band because otherwise the reshuffling of the AVL tree
-	 * might lead to missed valid events.
+	 * The ready list is modified during I/O signal dispatch. Hence, it is
+	 * protected by a dedicated mutex, which is never held while calling
+	 * into a plugin.
 	 */
-	struct Kqueue_element_container : Fifo<Kqueue_element_container>::Element
+	Mutex                               _ready_mutex { };
+	Fifo<Fifo_element<Kqueue_element> > _ready       { };
+
+	void _mark_ready(Kqueue_element &ele)
 	{
-		Kqueue_element const &ele;
-		Kqueue_element_container(Kqueue_element const &e) : ele(e)
-		{ }
-	};
+		Mutex::Guard guard(_ready_mutex);
 
-	Fifo<Kqueue_element_container> _delete_queue;
+		if (!ele.ready_elem.enqueued())
+			_ready.enqueue(ele.ready_elem);
+	}
 
-	void _queue_for_deletion(Kqueue_element &ele)
+	void _mark_edge(Kqueue_element &ele)
 	{
-		Kqueue_element_container &c = *new (_alloc) Kqueue_element_container(ele);
-		_delete_queue.enqueue(c);
+		Mutex::Guard guard(_ready_mutex);
+
+		ele.epoll_edge = true;
+
+		if (!ele.ready_elem.enqueued())
+			_ready.enqueue(ele.ready_elem);
+	}
+
+	void _mark_write_blocked(Kqueue_element &ele)
+	{
+		Mutex::Guard guard(_ready_mutex);
+
+		ele.epoll_out_blocked = true;
+
+		if (!ele.ready_elem.enqueued())
+			_ready.enqueue(ele.ready_elem);
 	}
 
 	/*
-	 * This may be called only when we can safely reshuffle the AVL tree
+	 * kqueue(2): "Calling close() on a file  descriptor will remove any
+	 * kevents that reference the descriptor."
+	 *
+	 * The element is removed on the next collection of events.
 	 */
-	void _delete_elements()
+	void _mark_closed(Kqueue_element &ele)
 	{
-		auto cancel_fn = [&](Kqueue_element_container& c) {
-			/* At this point we are sure that we can reshuffle the AVL tree. */
-			Kqueue_element * non_const_ptr = &(const_cast<Kqueue_element &>(c.ele));
-			_requests.remove(non_const_ptr);
-			destroy(_alloc, non_const_ptr);
-			destroy(_alloc, &c);
-		};
+		Mutex::Guard guard(_ready_mutex);
+
+		ele.fd = nullptr;
+
+		if (!ele.ready_elem.enqueued())
+			_ready.enqueue(ele.ready_elem);
+	}
+
+	/*
+	 * Observe file descriptor 'fd', which may have replaced a closed file
+	 * descriptor with the same number
+	 */
+	void _attach(Kqueue_element &ele, File_descriptor &fd)
+	{
+		if (ele.fd == &fd)
+			return;
+
+		if (ele.fd)
+			ele.fd->remove_ready_observer(ele);
 
 		{
-			Mutex::Guard guard(_requests_mutex);
-			_delete_queue.dequeue_all(cancel_fn);
+			Mutex::Guard guard(_ready_mutex);
+			ele.fd = &fd;
 		}
+
+		fd.add_ready_observer(ele);
+	}
+
+	/*
+	 * This may be called only with '_requests_mutex' held
+	 */
+	void _destroy(Kqueue_element &ele)
+	{
+		if (ele.fd)
+			ele.fd->remove_ready_observer(ele);
+
+		{
+			Mutex::Guard guard(_ready_mutex);
+			_ready.remove(ele.ready_elem);
+		}
+
+		_requests.remove(&ele);
+		destroy(_alloc, &ele);
+	}
+
+	/*
+	 * This may be called only with '_requests_mutex' held
+	 */
+	Kqueue_element &_create(struct kevent const &k, File_descriptor &fd)
+	{
+		Kqueue_element &ele = *new (_alloc) Kqueue_element(*this, k, fd);
+		_requests.insert(&ele);
+		fd.add_ready_observer(ele);
+		return ele;
 	}
 
 	int _add_event(struct kevent const& k)
@@ -232,11 +379,27 @@ struct Libc::Kqueue
 			return EINVAL;
 		}
 
-		Kqueue_element *ele = new (_alloc) Kqueue_element(k);
-		{
-			Mutex::Guard guard(_requests_mutex);
-			_requests.insert(ele);
-		}
+		File_descriptor *fd = libc_fd_to_fd(k.ident, "kevent");
+		if (!fd)
+			return EBADF;
+
+		Mutex::Guard guard(_requests_mutex);
+
+		/* kqueue(2): "Re-adding an existing event will modify the parameters" */
+		auto match_fn = [&](Kqueue_element &ele) {
+			static_cast<struct kevent &>(ele) = k;
+			_attach(ele, *fd);
+			return &ele;
+		};
+
+		auto no_match_fn = [&]() {
+			return &_create(k, *fd);
+		};
+
+		Kqueue_element &ele = *_requests.with_element(k, match_fn, no_match_fn);
+
+		if (!ele.disabled())
+			_mark_ready(ele);
 
 		return 0;
 	}
@@ -246,10 +409,7 @@ struct Libc::Kqueue
 		Mutex::Guard guard(_requests_mutex);
 
 		auto match_fn = [&](Kqueue_element &ele) {
-			/* Since we know we won't match another element, we can safely remove the element here. */
-			_requests.remove(&ele);
-			destroy(_alloc, &ele);
-
+			_destroy(ele);
 			return 0;
 		};
 
@@ -263,9 +423,11 @@ struct Libc::Kqueue
 
 	int _enable_event(struct kevent const& k)
 	{
+		Mutex::Guard guard(_requests_mutex);
+
 		auto match_fn = [&](Kqueue_element &ele) {
-			Kqueue_flags::Disable::clear((Kqueue_flags::access_t &)ele.flags);
-			Kqueue_flags::Enable::set((Kqueue_flags::access_t &)ele.flags);
+			ele.enable();
+			_mark_ready(ele);
 			return 0;
 		};
 
@@ -279,9 +441,11 @@ struct Libc::Kqueue
 
 	int _disable_event(struct kevent const& k)
 	{
+		Mutex::Guard guard(_requests_mutex);
+
+		/* the element is dropped from the ready list on the next collection */
 		auto match_fn = [&](Kqueue_element &ele) {
-			Kqueue_flags::Enable::clear((Kqueue_flags::access_t &)ele.flags);
-			Kqueue_flags::Disable::set((Kqueue_flags::access_t &)ele.flags);
+			ele.disable();
 			return 0;
 		};
 
@@ -293,14 +457,139 @@ struct Libc::Kqueue
 		return _requests.with_element(k, match_fn, no_match_fn);
 	}
 
+	/**
+	 * Query poll(2) events of the element's file descriptor
+	 */
+	static short _poll(Kqueue_element const &ele, File_descriptor &fd)
+	{
+		if (!fd.plugin || !fd.plugin->supports_poll())
+			return 0;
+
+		short revents = 0;
+		Plugin::Pollfd pollfd { .fdo = &fd, .events = ele.poll_events, .revents = &revents };
+
+		return (fd.plugin->poll(&pollfd, 1) > 0) ? revents : 0;
+	}
+
+	/**
+	 * Check the elements on the ready list
+	 *
+	 * Each element is checked at most once. This may be called only with
+	 * '_requests_mutex' held.
+	 *
+	 * \param fn  called with the element and its ready poll(2) events
+	 *
+	 * \return number of reported events
+	 */
+	int _check_ready_elements(int max_events, auto const &fn)
+	{
+		unsigned num_pending = 0;
+		{
+			Mutex::Guard guard(_ready_mutex);
+			_ready.for_each([&] (Fifo_element<Kqueue_element> const &) {
+				num_pending++; });
+		}
+
+		int num_events = 0;
+
+		for (; num_pending && num_events < max_events; num_pending--) {
+
+			Kqueue_element  *ele_ptr     = nullptr;
+			File_descriptor *fd          = nullptr;
+			bool             edge        = false;
+			bool             out_blocked = false;
+			{
+				Mutex::Guard guard(_ready_mutex);
+				_ready.dequeue([&] (Fifo_element<Kqueue_element> &e) {
+					ele_ptr     = &e.object();
+					fd          = ele_ptr->fd;
+					edge        = ele_ptr->epoll_edge;
+					out_blocked = ele_ptr->epoll_out_blocked;
+					ele_ptr->epoll_edge = false; });
+			}
+
+			if (!ele_ptr)
+				break;
+
+			Kqueue_element &ele = *ele_ptr;
+
+			if (!fd) {
+				_destroy(ele);
+				continue;
+			}
+
+			if (ele.disabled())
+				continue;
+
+			/*
+			 * Right now we do not support tracking newly available read data
+			 * via the clear flag, as that would entail tracking the
+			 * availability of new data across file system implementations.
+			 * For the case that a kqueue client sets EV_CLEAR and does not
+			 * read the available data after receiving a kevent, this will
+			 * lead to extraneous kevents for the already existing data.
+			 *
+			 * If the element is not read-ready, checking it implicitly
+			 * requests a read-ready response of its file descriptor.
+			 */
+			short const revents = _poll(ele, *fd);
+
+			bool const edge_triggered = ele.epoll_events & EPOLLET;
+			bool const writeable      = revents & POLLOUT;
+
+			/*
+			 * An EPOLLET element waits for write readiness only after a
+			 * blocked write and only if it monitors write readiness
+			 */
+			out_blocked = out_blocked && (ele.poll_events & POLLOUT);
+
+			if (edge_triggered && (writeable || !out_blocked)) {
+				Mutex::Guard guard(_ready_mutex);
+				ele.epoll_out_blocked = false;
+			}
+
+			bool const report = edge_triggered
+			                  ? revents && (edge || (out_blocked && writeable))
+			                  : revents != 0;
+
+			if (report) {
+				fn(ele, revents);
+				num_events++;
+
+				/* Delete oneshot event */
+				if (Kqueue_flags::Oneshot::get(ele.flags)) {
+					_destroy(ele);
+					continue;
+				}
+
+				/* epoll(7): EPOLLONESHOT disables the element until EPOLL_CTL_MOD */
+				if (ele.epoll_events & EPOLLONESHOT) {
+					ele.disable();
+					continue;
+				}
+			}
+
+			if (edge_triggered) {
+				if (out_blocked && !writeable)
+					_mark_ready(ele);
+				continue;
+			}
+
+			if (revents || (ele.poll_events & POLLOUT))
+				_mark_ready(ele);
+		}
+
+		return num_events;
+	}
+
 	Kqueue(Genode::Allocator &alloc) : _alloc(alloc)
 	{ }
 
 	~Kqueue()
 	{
-		auto destroy_fn = [&] (Kqueue_element &e) {
-			_requests.remove(&e);
-			destroy(_alloc, &e); };
+		Mutex::Guard guard(_requests_mutex);
+
+		auto destroy_fn = [&] (Kqueue_element &e) { _destroy(e); };
 		while (_requests.with_any_element(destroy_fn));
 	}
 
@@ -343,30 +632,23 @@ struct Libc::Kqueue
 		return num_errors;
 	}
 
-	int collect_completed_events(struct kevent * eventlist, int nevents, const struct timespec *timeout)
+	/**
+	 * Collect events from the ready list
+	 *
+	 * Event collection mode depending on 'timeout_ms'
+	 *
+	 * - timeout_ms == 0 ... block infinitely for events
+	 * - timeout_ms  > 0 ... block for events but don't return later than
+	 *                       timeout
+	 * - 'poll' is true  ... poll for events and return immediately
+	 *
+	 * \param fn  called with the element and its ready poll(2) events
+	 */
+	int _collect(int max_events, bool poll, uint64_t timeout_ms, auto const &fn)
 	{
-		if (nevents == 0)
+		if (max_events == 0)
 			return 0;
 
-		/*
-		 * event collection mode depending ont 'timeout'
-		 *
-		 * - timeout pointer == nullptr ... block infinitely for events
-		 * - timeout value   == 0       ... poll for events and return
-		 *                                  immediately
-		 * - timeout value   != 0       ... block for events but don't return
-		 *                                  later than timeout
-		 */
-		enum class Mode { INFINITE, POLL, TIMEOUT };
-
-		Mode     mode       =  Mode::INFINITE;
-		uint64_t timeout_ms = 0;
-
-		if (timeout) {
-			timeout_ms = timeout->tv_sec * 1000 + timeout->tv_nsec / 1000000;
-			mode       = (timeout_ms == 0) ? Mode::POLL : Mode::TIMEOUT;
-		}
-
 		int num_events { 0 };
 
 		auto monitor_fn = [&] ()
@@ -378,74 +660,16 @@ struct Libc::Kqueue
 			 * the event no longer holds, the kevent is removed from the kqueue and is
 			 * not returned."
 			 *
-			 * Since we need to check the condition on retrieval anyway, we *only* check
-			 * the condition on retrieval and not asynchronously.
+			 * Since we need to check the condition on retrieval anyway, we
+			 * check the condition on retrieval only. Read-ready responses
+			 * merely select the elements to check.
 			 */
-			auto check_fn = [&](Kqueue_element &ele) {
-				File_descriptor *fd = libc_fd_to_fd(ele.ident, "kevent_collect");
-
-				/*
-				 * kqueue(2): "Calling close() on a file  descriptor will remove any
-				 * kevents that reference the descriptor."
-				 *
-				 * Instead of removing the kqueue entry from close(), we collect
-				 * invalid entries for deletion here.
-				 */
-				if (!fd || !fd->plugin || !fd->context) {
-					_queue_for_deletion(ele);
-					return true;
-				}
-
-				/*
-				 *  If an event is disabled, ignore it.
-				 */
-				if (Kqueue_flags::Disable::get(ele.flags))
-					return true;
-
-				/*
-				 * Right now we do not support tracking newly available read data via
-				 * the clear flag, as that would entail tracking the availability of new
-				 * data across file system implementations. For the case that a kqueue
-				 * client sets EV_CLEAR and does not read the available data after receiving
-				 * a kevent, this will lead to extraneous kevents for the already existing data.
-				 */
-				switch (ele.filter) {
-				case EVFILT_READ:
-					if (Libc::read_ready_from_kernel(fd)) {
-						eventlist[num_events] = ele;
-						eventlist[num_events].flags = 0;
-						num_events++;
-					} else {
-						Libc::notify_read_ready_from_kernel(fd);
-					}
-					break;
-				case EVFILT_WRITE:
-					if (Libc::write_ready_from_kernel(fd)) {
-						eventlist[num_events] = ele;
-						eventlist[num_events].flags = 0;
-						num_events++;
-					}
-					break;
-				default:
-					assert(false && "Element with unknown filter inserted");
-				}
-
-				/* Delete oneshot event */
-				if (Kqueue_flags::Oneshot::get(ele.flags))
-					_queue_for_deletion(ele);
-
-				return num_events < nevents;
-			};
-
 			{
 				Mutex::Guard guard(_requests_mutex);
-				_requests.with_all_elements(check_fn);
-
+				num_events = _check_ready_elements(max_events, fn);
 			}
 
-			_delete_elements();
-
-			if (mode != Mode::POLL && num_events == 0)
+			if (!poll && num_events == 0)
 				return Monitor::Function_result::INCOMPLETE;
 
 			return Monitor::Function_result::COMPLETE;
@@ -459,6 +683,156 @@ struct Libc::Kqueue
 
 		return num_events;
 	}
+
+	int collect_completed_events(struct kevent * eventlist, int nevents, const struct timespec *timeout)
+	{
+		/*
+		 * event collection mode depending ont 'timeout'
+		 *
+		 * - timeout pointer == nullptr ... block infinitely for events
+		 * - timeout value   == 0       ... poll for events and return
+		 *                                  immediately
+		 * - timeout value   != 0       ... block for events but don't return
+		 *                                  later than timeout
+		 */
+		uint64_t timeout_ms = 0;
+		bool     poll       = false;
+
+		if (timeout) {
+			timeout_ms = timeout->tv_sec * 1000 + timeout->tv_nsec / 1000000;
+			poll       = (timeout_ms == 0);
+		}
+
+		int num_events { 0 };
+
+		return _collect(nevents, poll, timeout_ms,
+			[&] (Kqueue_element const &ele, short) {
+				eventlist[num_events] = ele;
+				eventlist[num_events].flags = 0;
+				num_events++; });
+	}
+
+
+	/*************************************
+	 ** epoll compatibility layer       **
+	 *************************************/
+
+	static short _epoll_poll_events(uint32_t epoll_events)
+	{
+		short events = 0;
+
+		if (epoll_events & (EPOLLIN | EPOLLRDNORM)) events |= POLLIN;
+		if (epoll_events & EPOLLPRI)                events |= POLLPRI;
+		if (epoll_events & (EPOLLOUT | EPOLLWRNORM)) events |= POLLOUT;
+
+		return events;
+	}
+
+	static uint32_t _epoll_events(short revents, uint32_t requested)
+	{
+		uint32_t events = 0;
+
+		if (revents & (POLLIN | POLLPRI | POLLRDNORM | POLLRDBAND))
+			events |= EPOLLIN | EPOLLRDNORM;
+		if (revents & POLLPRI)
+			events |= EPOLLPRI;
+		if (revents & (POLLOUT | POLLWRNORM | POLLWRBAND))
+			events |= EPOLLOUT | EPOLLWRNORM;
+
+		return events & (requested | EPOLLERR | EPOLLHUP);
+	}
+
+	/**
+	 * Apply 'event' and mark the element ready, which makes an EPOLLET
+	 * element report its current state once
+	 */
+	void _apply_epoll_event(Kqueue_element &ele, struct epoll_event const &event)
+	{
+		ele.epoll_events = event.events;
+		ele.epoll_data   = event.data;
+		ele.poll_events  = _epoll_poll_events(event.events);
+		ele.enable();
+
+		{
+			Mutex::Guard guard(_ready_mutex);
+			ele.epoll_out_blocked = false;
+		}
+		_mark_edge(ele);
+	}
+
+	int epoll_ctl(int op, int libc_fd, struct epoll_event *event)
+	{
+		if (op != EPOLL_CTL_DEL && !event)
+			return EFAULT;
+
+		File_descriptor *fd = libc_fd_to_fd(libc_fd, "epoll_ctl");
+		if (!fd)
+			return EBADF;
+
+		if (fd->context == reinterpret_cast<Plugin_context *>(this))
+			return EINVAL;
+
+		struct kevent k;
+		EV_SET(&k, libc_fd, FILTER_EPOLL, 0, 0, 0, nullptr);
+
+		Mutex::Guard guard(_requests_mutex);
+
+		switch (op) {
+		case EPOLL_CTL_ADD:
+
+			return _requests.with_element(k,
+				[&] (Kqueue_element &ele) {
+					if (ele.fd == fd)
+						return EEXIST;
+
+					/* entry of a closed file descriptor with the same number */
+					_attach(ele, *fd);
+					_apply_epoll_event(ele, *event);
+					return 0;
+				},
+				[&] {
+					Kqueue_element &ele = _create(k, *fd);
+					_apply_epoll_event(ele, *event);
+					return 0;
+				});
+
+		case EPOLL_CTL_MOD:
+
+			return _requests.with_element(k,
+				[&] (Kqueue_element &ele) {
+					if (ele.fd != fd)
+						return ENOENT;
+
+					_apply_epoll_event(ele, *event);
+					return 0;
+				},
+				[&] { return ENOENT; });
+
+		case EPOLL_CTL_DEL:
+
+			return _requests.with_element(k,
+				[&] (Kqueue_element &ele) {
+					bool const registered = (ele.fd == fd);
+					_destroy(ele);
+					return registered ? 0 : ENOENT;
+				},
+				[&] { return ENOENT; });
+		}
+
+		return EINVAL;
+	}
+
+	int epoll_wait(struct epoll_event *events, int maxevents, int timeout_ms)
+	{
+		int num_events { 0 };
+
+		return _collect(maxevents, timeout_ms == 0,
+		                timeout_ms < 0 ? 0 : uint64_t(timeout_ms),
+			[&] (Kqueue_element const &ele, short revents) {
+				events[num_events].events = _epoll_events(revents, ele.epoll_events);
+				events[num_events].data   = ele.epoll_data;
+				num_events++; });
+	}
 };
 
 
@@ -501,7 +875,7 @@ int Libc::Kqueue_plugin::close(File_descriptor *fd)
 		return -1;
 
 	if (fd->context)
-		_alloc.free(fd->context, sizeof(Kqueue));
+		destroy(_alloc, reinterpret_cast<Kqueue *>(fd->context));
 
 
 	file_descriptor_allocator()->free(fd);
@@ -516,7 +890,7 @@ kevent(int libc_fd, const struct kevent *changelist, int nchanges,
 {
 	File_descriptor *fd = libc_fd_to_fd(libc_fd, "kevent");
 
-	if (fd->plugin != kqueue_plugin()) {
+	if (!fd || fd->plugin != kqueue_plugin()) {
 		error("File descriptor not reqistered to kqueue plugin");
 		return Errno(EBADF);
 	}
@@ -563,3 +937,89 @@ int kqueue(void)
 {
 	return kqueue_plugin()->create_kqueue();
 }
+
+
+/*
+ * epoll compatibility layer
+ *
+ * An epoll instance is a kqueue, whose elements are registered per file
+ * descriptor via 'epoll_ctl'. EPOLLET elements are reported on edges only,
+ * see the description of 'Kqueue'.
+ */
+
+static Kqueue *epoll_kqueue(int epfd)
+{
+	File_descriptor *fd = libc_fd_to_fd(epfd, "epoll");
+
+	if (!fd || fd->plugin != kqueue_plugin())
+		return nullptr;
+
+	return reinterpret_cast<Libc::Kqueue *>(fd->context);
+}
+
+
+extern "C"
+int epoll_create1(int flags)
+{
+	if (flags & ~EPOLL_CLOEXEC)
+		return Errno(EINVAL);
+
+	int const libc_fd = kqueue_plugin()->create_kqueue();
+
+	if (flags & EPOLL_CLOEXEC)
+		if (File_descriptor *fd = libc_fd_to_fd(libc_fd, "epoll_create1"))
+			fd->cloexec = true;
+
+	return libc_fd;
+}
+
+
+extern "C"
+int epoll_create(int size)
+{
+	if (size <= 0)
+		return Errno(EINVAL);
+
+	return epoll_create1(0);
+}
+
+
+extern "C"
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event)
+{
+	Kqueue *kq = epoll_kqueue(epfd);
+	if (!kq)
+		return Errno(EBADF);
+
+	int const err = kq->epoll_ctl(op, fd, event);
+
+	return err ? Errno(err) : 0;
+}
+
+
+extern "C"
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout)
+{
+	if (maxevents <= 0 || !events)
+		return Errno(EINVAL);
+
+	Kqueue *kq = epoll_kqueue(epfd);
+	if (!kq)
+		return Errno(EBADF);
+
+	return kq->epoll_wait(events, maxevents, timeout);
+}
+
+
+extern "C"
+int epoll_pwait(int epfd, struct epoll_event *events, int maxevents, int timeout,
+                const sigset_t *sigmask)
+{
+	static bool warned = false;
+	if (sigmask && !warned) {
+		warning("epoll_pwait: signal mask ignored");
+		warned = true;
+	}
+
+	return epoll_wait(epfd, events, maxevents, timeout);
+}
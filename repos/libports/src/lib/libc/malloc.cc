@@ -30,6 +30,7 @@ extern "C" {
 #include <internal/init.h>
 #include <internal/clone_session.h>
 #include <internal/errno.h>
+#include <internal/pthread.h>
 
 
 namespace Libc {
@@ -52,7 +53,7 @@ class Libc::Slab_alloc : public Slab
 
 	public:
 
-		Slab_alloc(size_t object_size, Allocator &backing_store)
+		Slab_alloc(size_t object_size, Genode::Allocator &backing_store)
 		:
 			Slab(object_size, _calculate_block_size(object_size), 0, &backing_store),
 			_object_size(object_size)
@@ -80,9 +81,9 @@ class Libc::Malloc
 		using addr_t = Genode::addr_t;
 
 		enum {
-			SLAB_START    = 5,  /* 32 bytes (log2) */
-			SLAB_STOP     = 11, /* 2048 bytes (log2) */
-			NUM_SLABS     = (SLAB_STOP - SLAB_START) + 1,
+			SLAB_START    = Malloc_cache::SLAB_START,
+			SLAB_STOP     = Malloc_cache::SLAB_STOP,
+			NUM_SLABS     = Malloc_cache::NUM_CLASSES,
 			DEFAULT_ALIGN = 16
 		};
 
@@ -119,12 +120,86 @@ class Libc::Malloc
 			return sizeof(Metadata) + (align - 1);
 		}
 
-		Allocator &_backing_store; /* back-end allocator */
+		Genode::Allocator &_backing_store; /* back-end allocator */
 
 		Constructible<Slab_alloc> _slabs[NUM_SLABS]; /* slab allocators */
 
 		Mutex _mutex;
 
+		/*
+		 * Identity of this instance as seen by the per-thread caches
+		 *
+		 * The malloc object is re-constructed on 'execve'. Caches that
+		 * still refer to an earlier instance hold stale blocks and are
+		 * discarded.
+		 */
+		unsigned const _generation;
+
+		/**
+		 * Return cache of the calling thread, or nullptr if not available
+		 *
+		 * Threads not created via 'pthread_create', e.g., entrypoints,
+		 * have no 'Pthread' object and use the shared slabs only.
+		 */
+		Malloc_cache *_cache()
+		{
+			Pthread * const myself = Pthread::myself();
+			if (!myself || !myself->malloc_cache.enabled)
+				return nullptr;
+
+			Malloc_cache &cache = myself->malloc_cache;
+			if (cache.generation != _generation) {
+				for (Malloc_cache::Bin &bin : cache.bins)
+					bin = { };
+				cache.generation = _generation;
+			}
+			return &cache;
+		}
+
+		void *_slab_alloc(unsigned msb)
+		{
+			Slab_alloc &slab = *_slabs[msb - SLAB_START];
+
+			Malloc_cache * const cache = _cache();
+			if (!cache) {
+				Mutex::Guard guard(_mutex);
+				return slab.alloc();
+			}
+
+			Malloc_cache::Bin &bin = cache->bins[msb - SLAB_START];
+			if (!bin.head) {
+				Mutex::Guard guard(_mutex);
+				for (unsigned i = 0; i < Malloc_cache::batch(msb); i++) {
+					void * const ptr = slab.alloc();
+					if (!ptr)
+						break;
+					bin.push(ptr);
+				}
+			}
+			return bin.pop();
+		}
+
+		void _slab_free(unsigned msb, void *ptr)
+		{
+			Slab_alloc &slab = *_slabs[msb - SLAB_START];
+
+			Malloc_cache * const cache = _cache();
+			if (!cache) {
+				Mutex::Guard guard(_mutex);
+				slab.dealloc(ptr);
+				return;
+			}
+
+			Malloc_cache::Bin &bin = cache->bins[msb - SLAB_START];
+			bin.push(ptr);
+
+			if (bin.count > Malloc_cache::capacity(msb)) {
+				Mutex::Guard guard(_mutex);
+				for (unsigned i = 0; i < Malloc_cache::batch(msb); i++)
+					slab.dealloc(bin.pop());
+			}
+		}
+
 		unsigned _slab_log2(size_t size) const
 		{
 			uint8_t msb = Genode::log2(size, 0u);
@@ -142,7 +217,9 @@ class Libc::Malloc
 
 	public:
 
-		Malloc(Allocator &backing_store) : _backing_store(backing_store)
+		Malloc(Genode::Allocator &backing_store, unsigned generation)
+		:
+			_backing_store(backing_store), _generation(generation)
 		{
 			for (unsigned i = SLAB_START; i <= SLAB_STOP; i++)
 				_slabs[i - SLAB_START].construct(1U << i, backing_store);
@@ -150,27 +227,28 @@ class Libc::Malloc
 
 		~Malloc() { warning(__func__, " unexpectedly called"); }
 
+		unsigned generation() const { return _generation; }
+
 		/**
 		 * Allocator interface
 		 */
 
 		void * alloc(size_t size, size_t align = DEFAULT_ALIGN)
 		{
-			Mutex::Guard guard(_mutex);
-
 			size_t   const real_size = size + _room(align);
 			unsigned const msb       = _slab_log2(real_size);
 
 			void *alloc_addr = nullptr;
 
 			/* use backing store if requested memory is larger than largest slab */
-			if (msb > SLAB_STOP)
+			if (msb > SLAB_STOP) {
+				Mutex::Guard guard(_mutex);
 				_backing_store.try_alloc(real_size).with_result(
 					[&] (Range_allocator::Allocation &a) {
 						a.deallocate = false; alloc_addr = a.ptr; },
 					[&] (Alloc_error) { });
-			else
-				alloc_addr = _slabs[msb - SLAB_START]->alloc();
+			} else
+				alloc_addr = _slab_alloc(msb);
 
 			if (!alloc_addr) return nullptr;
 
@@ -210,8 +288,6 @@ class Libc::Malloc
 
 		void free(void *ptr)
 		{
-			Mutex::Guard lock_guard(_mutex);
-
 			Metadata *md = (Metadata *)ptr - 1;
 
 			size_t   const  real_size  = md->size;
@@ -224,9 +300,30 @@ class Libc::Malloc
 				      " - corrupted allocation");
 
 			if (msb > SLAB_STOP) {
+				Mutex::Guard guard(_mutex);
 				_backing_store.free(alloc_addr, real_size);
 			} else {
-				_slabs[msb - SLAB_START]->dealloc(alloc_addr);
+				_slab_free(msb, alloc_addr);
+			}
+		}
+
+		/**
+		 * Return all blocks cached by 'pthread' to the slabs
+		 */
+		void release_cache(Pthread &pthread)
+		{
+			Malloc_cache &cache = pthread.malloc_cache;
+			cache.enabled = false;
+
+			if (cache.generation != _generation)
+				return;
+
+			Mutex::Guard guard(_mutex);
+
+			for (unsigned i = 0; i < NUM_SLABS; i++) {
+				Malloc_cache::Bin &bin = cache.bins[i];
+				while (void * const ptr = bin.pop())
+					_slabs[i]->dealloc(ptr);
 			}
 		}
 };
@@ -289,7 +386,7 @@ static long _malloc_obj[(sizeof(Malloc) + sizeof(long))/sizeof(long)];
 
 void Libc::init_malloc(Genode::Allocator &heap)
 {
-	mallocator = construct_at<Malloc>(_malloc_obj, heap);
+	mallocator = construct_at<Malloc>(_malloc_obj, heap, 1U);
 }
 
 
@@ -302,5 +399,14 @@ void Libc::init_malloc_cloned(Clone_connection &clone_connection)
 
 void Libc::reinit_malloc(Genode::Allocator &heap)
 {
-	construct_at<Libc::Malloc>(_malloc_obj, heap);
+	unsigned const generation = mallocator->generation() + 1;
+
+	construct_at<Libc::Malloc>(_malloc_obj, heap, generation);
+}
+
+
+void Libc::release_malloc_cache(Pthread &pthread)
+{
+	if (mallocator)
+		mallocator->release_cache(pthread);
 }
@@ -264,6 +264,16 @@ struct Libc::Socket_fs::Context : Plugin_context
 			_fd_apply([flags] (int fd) { fcntl(fd, F_SETFL, flags); });
 		}
 
+		/**
+		 * Report read-ready responses of the socket files to socket 'fd'
+		 */
+		void ready_parent(File_descriptor &fd)
+		{
+			for (unsigned i = 0; i < Fd::MAX; ++i)
+				if (_fd[i].file)
+					_fd[i].file->ready_parent = &fd;
+		}
+
 		int data_fd()    { return _fd[Fd::DATA].num; }
 		int peek_fd()    { return _fd[Fd::PEEK].num; }
 		int connect_fd() { return _fd[Fd::CONNECT].num; }
@@ -708,6 +718,8 @@ extern "C" int socket_fs_accept(int libc_fd, sockaddr *addr, socklen_t *addrlen)
 		return Errno(EMFILE);
 	}
 
+	accept_context->ready_parent(*accept_fd);
+
 	if (addr && addrlen) {
 		Socket_fs::Remote_functor func(*accept_context, false);
 		int ret = read_sockaddr_in(func, (sockaddr_in *)addr, addrlen);
@@ -1342,6 +1354,8 @@ extern "C" int socket_fs_socket(int domain, int type, int protocol)
 		return Errno(EMFILE);
 	}
 
+	context->ready_parent(*fd);
+
 	return fd->libc_fd;
 }
 
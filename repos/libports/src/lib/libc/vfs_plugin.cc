@@ -260,7 +260,7 @@ Libc::File_descriptor *Libc::Vfs_plugin::open_from_kernel(const char *path, int
 			return nullptr;
 		}
 
-		handle->handler(&_response_handler);
+		handle->handler(&fd->read_ready_handler(_response_handler));
 		fd->flags = flags & O_ACCMODE;
 
 		return fd;
@@ -330,7 +330,7 @@ Libc::File_descriptor *Libc::Vfs_plugin::open_from_kernel(const char *path, int
 		return nullptr;
 	}
 
-	handle->handler(&_response_handler);
+	handle->handler(&fd->read_ready_handler(_response_handler));
 	fd->flags = flags & (O_ACCMODE|O_NONBLOCK|O_APPEND);
 
 	if (flags & O_TRUNC)
@@ -382,7 +382,7 @@ Libc::File_descriptor *Libc::Vfs_plugin::open(char const *path, int flags)
 					return Fn::COMPLETE;
 				}
 
-				handle->handler(&_response_handler);
+				handle->handler(&fd->read_ready_handler(_response_handler));
 				fd->flags = flags & O_ACCMODE;
 
 				return Fn::COMPLETE;
@@ -461,7 +461,7 @@ Libc::File_descriptor *Libc::Vfs_plugin::open(char const *path, int flags)
 				return Fn::COMPLETE;
 			}
 
-			handle->handler(&_response_handler);
+			handle->handler(&fd->read_ready_handler(_response_handler));
 			fd->flags = flags & (O_ACCMODE|O_NONBLOCK|O_APPEND);
 
 			return Fn::COMPLETE;
@@ -590,7 +590,7 @@ int Libc::Vfs_plugin::dup2(File_descriptor *fd,
 		}
 
 		handle->seek(vfs_handle(fd)->seek());
-		handle->handler(&_response_handler);
+		handle->handler(&new_fd->read_ready_handler(_response_handler));
 
 		new_fd->context = vfs_context(handle);
 		new_fd->flags = fd->flags;
@@ -620,7 +620,6 @@ Libc::File_descriptor *Libc::Vfs_plugin::dup(File_descriptor *fd)
 		}
 
 		handle->seek(vfs_handle(fd)->seek());
-		handle->handler(&_response_handler);
 
 		File_descriptor * const new_fd = _fd_alloc.alloc(this, vfs_context(handle));
 
@@ -630,6 +629,7 @@ Libc::File_descriptor *Libc::Vfs_plugin::dup(File_descriptor *fd)
 			return Fn::COMPLETE;
 		}
 
+		handle->handler(&new_fd->read_ready_handler(_response_handler));
 		new_fd->flags = fd->flags;
 		new_fd->path(fd->fd_path);
 
@@ -794,6 +794,11 @@ ssize_t Libc::Vfs_plugin::write(File_descriptor *fd, const void *buf,
 			out_result = handle->fs().write(handle, src, out_count);
 			return Fn::COMPLETE;
 		});
+
+		/* let edge-triggered epoll users wait for write readiness */
+		if (out_result == Result::WRITE_ERR_WOULD_BLOCK
+		 || (out_result == Result::WRITE_OK && out_count < count))
+			fd->notify_write_blocked();
 	} else {
 		Vfs::file_size const initial_seek { handle->seek() };
 
@@ -2303,6 +2308,73 @@ int Libc::Vfs_plugin::rename(char const *from_path, char const *to_path)
 }
 
 
+void *Libc::Vfs_plugin::_mmap_readonly_dataspace(::size_t length,
+                                                  File_descriptor *fd,
+                                                  ::off_t offset)
+{
+	if (!fd->fd_path || offset != 0)
+		return nullptr;
+
+	/*
+	 * File systems other than rom hand out a dataspace with a copy of the
+	 * whole file. Use it only if the mapping covers the whole file anyway,
+	 * so mapping a small window of a large file keeps costing no more
+	 * than the window.
+	 */
+	using Stat_result = Vfs::Directory_service::Stat_result;
+
+	Vfs::Directory_service::Stat stat { };
+	Stat_result                  stat_result { Stat_result::STAT_ERR_NO_ENTRY };
+
+	monitor().monitor([&] {
+		stat_result = _root_fs.stat(fd->fd_path, stat);
+		return Fn::COMPLETE;
+	});
+
+	if (stat_result != Stat_result::STAT_OK || stat.size == 0 || length < stat.size)
+		return nullptr;
+
+	Genode::Dataspace_capability ds_cap;
+
+	monitor().monitor([&] {
+		ds_cap = _root_fs.dataspace(fd->fd_path);
+		return Fn::COMPLETE;
+	});
+
+	if (!ds_cap.valid())
+		return nullptr;
+
+	/*
+	 * The attachment fails if the range exceeds the dataspace, e.g., if
+	 * the mapping reaches beyond the end of the file by more than the
+	 * page-granular dataspace size.
+	 */
+	void * const addr = local_rm().attach(ds_cap, {
+		.size       = length,
+		.offset     = addr_t(offset),
+		.use_at     = { },
+		.at         = { },
+		.executable = { },
+		.writeable  = false
+	}).convert<void *>(
+		[&] (Env::Local_rm::Attachment &a) { a.deallocate = false; return a.ptr; },
+		[&] (Env::Local_rm::Error)         { return nullptr; }
+	);
+
+	if (!addr) {
+		monitor().monitor([&] {
+			_root_fs.release(fd->fd_path, ds_cap);
+			return Fn::COMPLETE;
+		});
+		return nullptr;
+	}
+
+	new (_alloc) Mmap_entry(_mmap_registry, addr, ds_cap, fd->fd_path);
+
+	return addr;
+}
+
+
 void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags,
                              File_descriptor *fd, ::off_t offset)
 {
@@ -2323,9 +2395,16 @@ void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags
 	if (flags & MAP_PRIVATE) {
 
 		/*
-		 * XXX attempt to obtain memory mapping via
-		 *     'Vfs::Directory_service::dataspace'.
+		 * A read-only private mapping cannot be told apart from a shared
+		 * mapping of the file content. Attach the dataspace provided by
+		 * the VFS if the mapping covers the whole file and resort to a
+		 * copy of the file content otherwise.
 		 */
+		if (prot == PROT_READ) {
+			addr = _mmap_readonly_dataspace(length, fd, offset);
+			if (addr)
+				return addr;
+		}
 
 		addr = mem_alloc()->alloc(length, AT_PAGE);
 		if (addr == (void *)-1) {
@@ -2436,23 +2515,34 @@ int Libc::Vfs_plugin::munmap(void *addr, ::size_t)
 	if (size_at_result == Size_at_error::MISMATCHING_ADDR)
 		return Errno(EINVAL);
 
-	/* shared mapping */
+	/* shared mapping or read-only private mapping of a VFS dataspace */
 
-	Vfs::Vfs_handle *reference_handle = nullptr;
+	bool                  found            = false;
+	Vfs::Vfs_handle      *reference_handle = nullptr;
+	Dataspace_capability  ds_cap { };
+	Absolute_path         ds_path { };
 
 	_mmap_registry.for_each([&] (Mmap_entry &entry) {
 		if (entry.start == addr) {
+			found            = true;
 			reference_handle = entry.reference_handle;
+			ds_cap           = entry.ds;
+			ds_path          = entry.ds_path;
 			destroy(_alloc, &entry);
 			local_rm().detach(addr_t(addr));
 		}
 	});
 
-	if (!reference_handle)
+	if (!found)
 		return Errno(EINVAL);
 
 	monitor().monitor([&] {
-		reference_handle->close();
+		if (reference_handle)
+			reference_handle->close();
+
+		if (ds_cap.valid())
+			_root_fs.release(ds_path.string(), ds_cap);
+
 		return Fn::COMPLETE;
 	});
 
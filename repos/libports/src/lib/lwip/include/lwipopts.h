@@ -58,6 +58,7 @@ extern "C" {
 
 /* checksum calculation for outgoing packets can be disabled if the hardware supports it */
 #define LWIP_CHECKSUM_ON_COPY       1  /* calculate checksum during memcpy */
+#define LWIP_SUPPORT_CUSTOM_PBUF    1  /* zero-copy reception of Nic packets */
 
 /*********************
  ** Memory settings **
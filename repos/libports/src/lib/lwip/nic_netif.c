@@ -48,6 +48,7 @@ struct genode_netif_handle
 	ip_addr_t                   gateway;
 	ip_addr_t                   nameserver;
 	struct genode_nic_client   *nic_handle;
+	unsigned                    retained_rx_packets;
 };
 
 
@@ -219,9 +220,10 @@ struct genode_netif_handle *lwip_genode_netif_init(char const *label)
 	if (handle->nic_handle == NULL)
 		return NULL;
 
-	handle->netif              = net;
-	handle->address_valid      = false;
-	handle->address_configured = false;
+	handle->netif               = net;
+	handle->address_valid       = false;
+	handle->address_configured  = false;
+	handle->retained_rx_packets = 0;
 
 	net = netif_add(net, &v4dummy, &v4dummy, &v4dummy,
 	                handle, nic_netif_init, ethernet_input);
@@ -363,41 +365,101 @@ void lwip_genode_netif_link_state(struct genode_netif_handle *handle)
 }
 
 
+/*
+ * Received packets are handed to lwIP as custom pbufs that refer to the
+ * packet-stream buffer. The packet is acknowledged to the NIC server once
+ * lwIP frees the pbuf. The number of retained packets is limited to keep
+ * the server's RX buffer from running dry, e.g., if the application does not
+ * consume received TCP data. Beyond the limit, packets are copied.
+ */
+enum { MAX_RETAINED_RX_PACKETS = 512 };
+
+
+struct nic_netif_rx_pbuf
+{
+	struct pbuf_custom                 custom;  /* must be first member */
+	struct genode_netif_handle        *handle;
+	struct genode_nic_client_rx_packet packet;
+};
+
+
+static void nic_netif_rx_pbuf_free(struct pbuf *p)
+{
+	struct nic_netif_rx_pbuf   *rx_pbuf = (struct nic_netif_rx_pbuf *)p;
+	struct genode_netif_handle *handle  = rx_pbuf->handle;
+
+	genode_nic_client_rx_release(handle->nic_handle, rx_pbuf->packet);
+	handle->retained_rx_packets--;
+	mem_free(rx_pbuf);
+
+	lwip_genode_socket_schedule_peer();
+}
+
+
 struct genode_nic_client_rx_context
 {
-	struct netif *netif;
+	struct genode_netif_handle *handle;
 };
 
 
 static genode_nic_client_rx_result_t
 netif_rx_one_packet(struct genode_nic_client_rx_context *ctx,
-                    char const *ptr, unsigned long len)
+                    char *ptr, unsigned long len,
+                    struct genode_nic_client_rx_packet packet)
 {
+	struct genode_netif_handle *handle  = ctx->handle;
+	struct nic_netif_rx_pbuf   *rx_pbuf = NULL;
+	struct pbuf                *p       = NULL;
 	err_t err;
-	struct pbuf  *p = pbuf_alloc(PBUF_RAW, len, PBUF_RAM);
-	if (!p) return GENODE_NIC_CLIENT_RX_REJECTED;
 
-	LINK_STATS_INC(link.recv);
+	if (len > 0xffff) return GENODE_NIC_CLIENT_RX_REJECTED;
+
+	if (handle->retained_rx_packets < MAX_RETAINED_RX_PACKETS)
+		rx_pbuf = mem_malloc(sizeof(struct nic_netif_rx_pbuf));
+
+	if (rx_pbuf) {
+		rx_pbuf->custom.custom_free_function = nic_netif_rx_pbuf_free;
+		rx_pbuf->handle = handle;
+		rx_pbuf->packet = packet;
+
+		p = pbuf_alloced_custom(PBUF_RAW, (u16_t)len, PBUF_REF, &rx_pbuf->custom,
+		                        ptr, (u16_t)len);
+		if (!p) {
+			mem_free(rx_pbuf);
+			return GENODE_NIC_CLIENT_RX_REJECTED;
+		}
+		handle->retained_rx_packets++;
+
+	} else {
+		p = pbuf_alloc(PBUF_RAW, (u16_t)len, PBUF_RAM);
+		if (!p) return GENODE_NIC_CLIENT_RX_REJECTED;
 
-	memcpy(p->payload, ptr, len);
+		memcpy(p->payload, ptr, len);
+	}
 
-	if ((err = ctx->netif->input(p, ctx->netif)) != ERR_OK) {
+	LINK_STATS_INC(link.recv);
+
+	if ((err = handle->netif->input(p, handle->netif)) != ERR_OK) {
 		lwip_printf("error: forwarding Nic packet to lwIP (%d)", err);
-		return GENODE_NIC_CLIENT_RX_RETRY;
+		pbuf_free(p);
 	}
 
-	return GENODE_NIC_CLIENT_RX_ACCEPTED;
+	/* a retained packet is released by 'nic_netif_rx_pbuf_free' */
+	return rx_pbuf ? GENODE_NIC_CLIENT_RX_RETAINED
+	               : GENODE_NIC_CLIENT_RX_ACCEPTED;
 }
 
 
 void lwip_genode_netif_rx(struct genode_netif_handle *handle)
 {
-	struct genode_nic_client_rx_context ctx = { .netif = handle->netif };
+	struct genode_nic_client_rx_context ctx;
 	bool progress = false;
 
 	if (!handle) return;
 
-	while (genode_nic_client_rx(handle->nic_handle, netif_rx_one_packet, &ctx))
+	ctx.handle = handle;
+
+	while (genode_nic_client_rx_retainable(handle->nic_handle, netif_rx_one_packet, &ctx))
 		progress = true;
 
 	if (progress) lwip_genode_socket_schedule_peer();
@@ -0,0 +1,435 @@
+/*
+ * \brief  VFS plugin for LZ4-compressed tar archives
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <vfs/file_system_factory.h>
+
+/* VFS includes */
+#include <tar_file_system.h>
+
+/* LZ4 includes */
+#include <lz4.h>
+
+namespace Vfs_tar_lz4 {
+
+	using namespace Genode;
+	using namespace Genode::Vfs;
+
+	class Lz4_archive;
+	class File_system;
+}
+
+
+/**
+ * Tar archive compressed in the LZ4 frame format
+ *
+ * The archive must be compressed with independent blocks, which is the
+ * default of the 'lz4' command-line tool. At construction time, the
+ * block headers of all frames are scanned, which yields an index of the
+ * compressed blocks. Archive content is then decompressed on demand, one
+ * block at a time. Recently used blocks are kept in a small cache.
+ *
+ * As the block headers do not state the decompressed size of a block,
+ * all but the last block of a frame are expected to be of the maximum
+ * block size, as produced by the reference implementation.
+ */
+class Vfs_tar_lz4::Lz4_archive : public Vfs_tar::Archive
+{
+	private:
+
+		enum : uint32_t {
+			FRAME_MAGIC          = 0x184d2204,
+			SKIPPABLE_MAGIC      = 0x184d2a50,
+			SKIPPABLE_MAGIC_MASK = 0xfffffff0,
+			BLOCK_STORED         = 0x80000000,
+		};
+
+		struct Block
+		{
+			file_size offset;      /* within the decompressed archive */
+			size_t    size;        /* decompressed size */
+			size_t    src_offset;  /* of the block data within the ROM */
+			size_t    src_size;
+			size_t    max_size;
+			bool      stored;      /* block data is not compressed */
+			bool      last;        /* last block of its frame */
+			file_size frame_size;  /* content size of the frame, 0 if unknown */
+		};
+
+		struct Cache_slot
+		{
+			Block const  *block;
+			char         *data;
+			unsigned long last_use;
+		};
+
+		using Rom_name = String<64>;
+
+		Allocator             &_alloc;
+		Rom_name         const _rom_name;
+		Attached_rom_dataspace _rom;
+
+		Block     *_blocks     { nullptr };
+		unsigned   _num_blocks { 0 };
+		size_t     _max_size   { 0 };
+		file_size  _size       { 0 };
+
+		Cache_slot   *_slots     { nullptr };
+		unsigned      _num_slots { 0 };
+		unsigned long _use_count { 0 };
+
+		/*
+		 * Noncopyable
+		 */
+		Lz4_archive(Lz4_archive const &);
+		Lz4_archive &operator = (Lz4_archive const &);
+
+		char const *_src() const { return _rom.local_addr<char const>(); }
+
+		bool _read_le(size_t offset, unsigned num_bytes, uint64_t &value) const
+		{
+			if (offset + num_bytes > _rom.size())
+				return false;
+
+			value = 0;
+			for (unsigned i = 0; i < num_bytes; i++)
+				value |= uint64_t(uint8_t(_src()[offset + i])) << (8*i);
+
+			return true;
+		}
+
+		/**
+		 * Call 'fn' for each data block of the archive
+		 *
+		 * The 'offset' and 'size' of the blocks are not yet known.
+		 *
+		 * \return false if the archive is malformed
+		 */
+		bool _for_each_block(auto const &fn) const
+		{
+			size_t pos = 0;
+			while (pos + 4 <= _rom.size()) {
+
+				uint64_t magic = 0;
+				(void)_read_le(pos, 4, magic);
+
+				if ((magic & SKIPPABLE_MAGIC_MASK) == SKIPPABLE_MAGIC) {
+					uint64_t len = 0;
+					if (!_read_le(pos + 4, 4, len))
+						return false;
+					pos += 8 + size_t(len);
+					continue;
+				}
+
+				if (magic != FRAME_MAGIC) {
+					error(_rom_name, ": no LZ4 frame at offset ", pos);
+					return false;
+				}
+				pos += 4;
+
+				uint64_t flg = 0, bd = 0;
+				if (!_read_le(pos, 1, flg) || !_read_le(pos + 1, 1, bd))
+					return false;
+				pos += 2;
+
+				bool const independent    = flg & (1 << 5);
+				bool const block_checksum = flg & (1 << 4);
+				bool const content_size   = flg & (1 << 3);
+				bool const content_check  = flg & (1 << 2);
+				bool const dictionary     = flg & (1 << 0);
+
+				if ((flg >> 6) != 1 || dictionary) {
+					error(_rom_name, ": unsupported LZ4 frame at offset ", pos);
+					return false;
+				}
+				if (!independent) {
+					error(_rom_name, ": LZ4 blocks must be independent");
+					return false;
+				}
+
+				unsigned const max_size_id = unsigned(bd >> 4) & 7;
+				if (max_size_id < 4) {
+					error(_rom_name, ": invalid LZ4 block size");
+					return false;
+				}
+				size_t const max_size = 1ul << (8 + 2*max_size_id);
+
+				uint64_t frame_size = 0;
+				if (content_size) {
+					if (!_read_le(pos, 8, frame_size))
+						return false;
+					pos += 8;
+				}
+
+				/* header checksum */
+				pos += 1;
+
+				for (;;) {
+
+					uint64_t word = 0;
+					if (!_read_le(pos, 4, word))
+						return false;
+					pos += 4;
+
+					/* end mark */
+					if (word == 0)
+						break;
+
+					size_t const src_size = size_t(word & ~BLOCK_STORED);
+					if (src_size > max_size || pos + src_size > _rom.size()) {
+						error(_rom_name, ": malformed LZ4 block at offset ", pos);
+						return false;
+					}
+
+					size_t const next = pos + src_size + (block_checksum ? 4 : 0);
+
+					uint64_t next_word = 0;
+					if (!_read_le(next, 4, next_word))
+						return false;
+
+					fn(Block { .offset     = 0,
+					           .size       = 0,
+					           .src_offset = pos,
+					           .src_size   = src_size,
+					           .max_size   = max_size,
+					           .stored     = (word & BLOCK_STORED) != 0,
+					           .last       = (next_word == 0),
+					           .frame_size = frame_size });
+					pos = next;
+				}
+
+				if (content_check)
+					pos += 4;
+			}
+			return true;
+		}
+
+		/**
+		 * Decompress block into 'dst' of '_max_size' bytes
+		 *
+		 * \return decompressed size, or -1 on error
+		 */
+		long _decompress(Block const &block, char *dst) const
+		{
+			char const *src = _src() + block.src_offset;
+
+			if (block.stored) {
+				memcpy(dst, src, block.src_size);
+				return long(block.src_size);
+			}
+
+			int const result = LZ4_decompress_safe(src, dst, int(block.src_size),
+			                                       int(block.max_size));
+			return result < 0 ? -1 : long(result);
+		}
+
+		/**
+		 * Determine offset and decompressed size of each block
+		 */
+		bool _layout_blocks()
+		{
+			file_size offset     = 0;
+			file_size frame_used = 0;
+
+			for (unsigned i = 0; i < _num_blocks; i++) {
+
+				Block &block = _blocks[i];
+
+				if (block.stored)
+					block.size = block.src_size;
+				else if (!block.last)
+					block.size = block.max_size;
+				else if (block.frame_size)
+					block.size = size_t(block.frame_size - frame_used);
+				else {
+					/* decompress last block of frame to learn its size */
+					long const size = _decompress(block, _slots[0].data);
+					if (size < 0)
+						return false;
+					block.size = size_t(size);
+					_slots[0].block = &block;
+				}
+
+				if (block.size > block.max_size) {
+					error(_rom_name, ": LZ4 frame size mismatch");
+					return false;
+				}
+
+				block.offset = offset;
+				offset      += block.size;
+				frame_used   = block.last ? 0 : frame_used + block.size;
+			}
+			_size = offset;
+			return true;
+		}
+
+		Block const *_block_at(file_size offset) const
+		{
+			if (offset >= _size)
+				return nullptr;
+
+			unsigned lo = 0, hi = _num_blocks;
+			while (hi - lo > 1) {
+				unsigned const mid = lo + (hi - lo)/2;
+				if (_blocks[mid].offset <= offset)
+					lo = mid;
+				else
+					hi = mid;
+			}
+			return &_blocks[lo];
+		}
+
+		char const *_data(Block const &block)
+		{
+			_use_count++;
+
+			Cache_slot *victim = &_slots[0];
+			for (unsigned i = 0; i < _num_slots; i++) {
+				Cache_slot &slot = _slots[i];
+				if (slot.block == &block) {
+					slot.last_use = _use_count;
+					return slot.data;
+				}
+				if (slot.last_use < victim->last_use)
+					victim = &slot;
+			}
+
+			victim->block = nullptr;
+
+			long const size = _decompress(block, victim->data);
+			if (size != long(block.size)) {
+				error(_rom_name, ": failed to decompress LZ4 block at offset ",
+				      block.src_offset);
+				return nullptr;
+			}
+
+			victim->block    = &block;
+			victim->last_use = _use_count;
+			return victim->data;
+		}
+
+		void _free()
+		{
+			for (unsigned i = 0; _slots && i < _num_slots; i++)
+				if (_slots[i].data)
+					_alloc.free(_slots[i].data, _max_size);
+
+			if (_slots)
+				_alloc.free(_slots, _num_slots*sizeof(Cache_slot));
+
+			if (_blocks)
+				_alloc.free(_blocks, _num_blocks*sizeof(Block));
+
+			_slots  = nullptr;
+			_blocks = nullptr;
+			_num_slots = _num_blocks = 0;
+			_size   = 0;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * A malformed archive is reported and appears as empty.
+		 */
+		Lz4_archive(Genode::Env &env, Allocator &alloc, Genode::Node const &config)
+		:
+			_alloc(alloc),
+			_rom_name(config.attribute_value("name", Rom_name())),
+			_rom(env, _rom_name.string())
+		{
+			unsigned num_blocks = 0;
+			size_t   max_size   = 0;
+			bool const valid = _for_each_block([&] (Block const &block) {
+				num_blocks++;
+				max_size = max(max_size, block.max_size); });
+
+			if (!valid || !num_blocks)
+				return;
+
+			_blocks = (Block *)_alloc.alloc(num_blocks*sizeof(Block));
+			(void)_for_each_block([&] (Block const &block) {
+				_blocks[_num_blocks++] = block; });
+
+			_max_size  = max_size;
+			_num_slots = max(config.attribute_value("cache", 4U), 1U);
+			_slots     = (Cache_slot *)_alloc.alloc(_num_slots*sizeof(Cache_slot));
+
+			for (unsigned i = 0; i < _num_slots; i++)
+				_slots[i] = { .block = nullptr, .data = nullptr, .last_use = 0 };
+
+			for (unsigned i = 0; i < _num_slots; i++)
+				_slots[i].data = (char *)_alloc.alloc(_max_size);
+
+			if (!_layout_blocks())
+				_free();
+		}
+
+		~Lz4_archive() { _free(); }
+
+		file_size size() const override { return _size; }
+
+		size_t read(file_size offset, Byte_range_ptr const &dst) override
+		{
+			size_t count = 0;
+			while (count < dst.num_bytes) {
+
+				Block const *block = _block_at(offset + count);
+				if (!block)
+					break;
+
+				char const *data = _data(*block);
+				if (!data)
+					break;
+
+				size_t const block_offset = size_t(offset + count - block->offset);
+				size_t const n = min(dst.num_bytes - count, block->size - block_offset);
+
+				memcpy(dst.start + count, data + block_offset, n);
+				count += n;
+			}
+			return count;
+		}
+};
+
+
+class Vfs_tar_lz4::File_system : private Lz4_archive, public Vfs_tar::File_system
+{
+	public:
+
+		File_system(Vfs::Env &env, Genode::Node const &config)
+		:
+			Lz4_archive(env.env(), env.alloc(), config),
+			Vfs_tar::File_system(env, config, *this)
+		{ }
+
+		char const *type() override { return "tar_lz4"; }
+};
+
+
+extern "C" Genode::Vfs::File_system_factory *vfs_file_system_factory(void)
+{
+	using namespace Genode;
+
+	struct Factory : Vfs::File_system_factory
+	{
+		Vfs::File_system *create(Vfs::Env &env, Node const &node) override
+		{
+			return new (env.alloc()) Vfs_tar_lz4::File_system(env, node);
+		}
+	};
+
+	static Factory factory;
+	return &factory;
+}
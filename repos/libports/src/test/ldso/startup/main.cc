@@ -0,0 +1,85 @@
+/*
+ * \brief  Benchmark for the start-up time of dynamically linked programs
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The benchmark repeatedly loads the shared libraries listed in its
+ * configuration with immediate binding. Hence, each round comprises the
+ * loading of the library and its dependencies and the resolution of all
+ * symbol references, which dominates the start-up time of large
+ * dynamically linked programs.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/shared_object.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	using Rom_name = String<64>;
+
+	bool _measure(Rom_name const &rom, unsigned rounds)
+	{
+		uint64_t const start_us = _timer.elapsed_us();
+
+		try {
+			for (unsigned i = 0; i < rounds; i++)
+				Shared_object object(_env, _heap, rom.string(),
+				                     Shared_object::BIND_NOW,
+				                     Shared_object::DONT_KEEP);
+		}
+		catch (...) {
+			error("failed to load ", rom);
+			return false;
+		}
+
+		uint64_t const duration_us = _timer.elapsed_us() - start_us;
+
+		log(rom, ": ", duration_us/rounds, " us per load (", rounds, " rounds)");
+		return true;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		Node const &config = _config.node();
+
+		unsigned const rounds = max(config.attribute_value("rounds", 10U), 1U);
+
+		bool ok = true;
+		config.for_each_sub_node("library", [&] (Node const &library) {
+			if (ok)
+				ok = _measure(library.attribute_value("rom", Rom_name()), rounds); });
+
+		log("--- ldso start-up benchmark finished ---");
+		_env.parent().exit(ok ? 0 : -1);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
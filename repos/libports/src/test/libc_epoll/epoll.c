@@ -0,0 +1,330 @@
+/*
+ * \brief  epoll test
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/epoll.h>
+
+
+/*
+ * Wait for events and check the number of events and the reported data
+ */
+static int expect(char const *name, int ep, int timeout, int num, uint64_t u64,
+                  uint32_t events)
+{
+	struct epoll_event result[4];
+
+	memset(result, 0, sizeof(result));
+
+	int const ret = epoll_wait(ep, result, 4, timeout);
+	if (ret == -1) {
+		printf("%s: epoll_wait failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	if (ret != num) {
+		printf("%s: got %d events, expected %d\n", name, ret, num);
+		return -1;
+	}
+
+	if (num && (result[0].data.u64 != u64 || result[0].events != events)) {
+		printf("%s: unexpected event data=%llu events=0x%x\n", name,
+		       (unsigned long long)result[0].data.u64, result[0].events);
+		return -1;
+	}
+
+	return 0;
+}
+
+
+static int add(int ep, int op, int fd, uint32_t events, uint64_t u64)
+{
+	struct epoll_event event;
+
+	event.events   = events;
+	event.data.u64 = u64;
+
+	return epoll_ctl(ep, op, fd, &event);
+}
+
+
+/*
+ * Test read readiness of a pipe
+ */
+static int test_read(void)
+{
+	char const *name = "Read test";
+	int ret = 0;
+	int fds[2];
+	char c = 'x';
+
+	int const ep = epoll_create1(EPOLL_CLOEXEC);
+	if (ep == -1 || pipe(fds) == -1) {
+		printf("%s: setup failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	if (add(ep, EPOLL_CTL_ADD, fds[0], EPOLLIN, 42)) {
+		printf("%s: epoll_ctl failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	/* nothing to read yet */
+	ret += expect(name, ep, 10, 0, 0, 0);
+
+	/* written data is reported via the read-ready response of the pipe */
+	if (write(fds[1], &c, 1) != 1)
+		ret--;
+	ret += expect(name, ep, -1, 1, 42, EPOLLIN);
+
+	/* level-triggered until consumed */
+	ret += expect(name, ep, 0, 1, 42, EPOLLIN);
+
+	if (read(fds[0], &c, 1) != 1)
+		ret--;
+	ret += expect(name, ep, 10, 0, 0, 0);
+
+	close(fds[0]);
+	close(fds[1]);
+	close(ep);
+
+	if (!ret)
+		printf("%s: Test successful.\n", name);
+
+	return ret;
+}
+
+
+/*
+ * Test write readiness and modification of the monitored events
+ */
+static int test_modify(void)
+{
+	char const *name = "Modify test";
+	int ret = 0;
+	int fds[2];
+
+	int const ep = epoll_create(1);
+	if (ep == -1 || pipe(fds) == -1) {
+		printf("%s: setup failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	if (add(ep, EPOLL_CTL_ADD, fds[1], EPOLLIN, 1)) {
+		printf("%s: epoll_ctl failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	ret += expect(name, ep, 10, 0, 0, 0);
+
+	if (add(ep, EPOLL_CTL_MOD, fds[1], EPOLLOUT, 2)) {
+		printf("%s: EPOLL_CTL_MOD failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	ret += expect(name, ep, -1, 1, 2, EPOLLOUT);
+
+	if (epoll_ctl(ep, EPOLL_CTL_DEL, fds[1], NULL)) {
+		printf("%s: EPOLL_CTL_DEL failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	ret += expect(name, ep, 10, 0, 0, 0);
+
+	close(fds[0]);
+	close(fds[1]);
+	close(ep);
+
+	if (!ret)
+		printf("%s: Test successful.\n", name);
+
+	return ret;
+}
+
+
+/*
+ * Test EPOLLONESHOT and re-arming via EPOLL_CTL_MOD
+ */
+static int test_oneshot(void)
+{
+	char const *name = "Oneshot test";
+	int ret = 0;
+	int fds[2];
+
+	int const ep = epoll_create1(0);
+	if (ep == -1 || pipe(fds) == -1) {
+		printf("%s: setup failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	if (add(ep, EPOLL_CTL_ADD, fds[1], EPOLLOUT | EPOLLONESHOT, 7)) {
+		printf("%s: epoll_ctl failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	ret += expect(name, ep, -1, 1, 7, EPOLLOUT);
+	ret += expect(name, ep, 10, 0, 0, 0);
+
+	if (add(ep, EPOLL_CTL_MOD, fds[1], EPOLLOUT | EPOLLONESHOT, 8)) {
+		printf("%s: EPOLL_CTL_MOD failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	ret += expect(name, ep, -1, 1, 8, EPOLLOUT);
+
+	close(fds[0]);
+	close(fds[1]);
+	close(ep);
+
+	if (!ret)
+		printf("%s: Test successful.\n", name);
+
+	return ret;
+}
+
+
+/*
+ * Test EPOLLET, which must not report unchanged readiness again
+ */
+static int test_edge(void)
+{
+	char const *name = "Edge test";
+	int ret = 0;
+	int fds[2];
+	char c = 'x';
+
+	int const ep = epoll_create1(0);
+	if (ep == -1 || pipe(fds) == -1) {
+		printf("%s: setup failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	/* a writeable pipe is reported once, then epoll_wait blocks */
+	if (add(ep, EPOLL_CTL_ADD, fds[1], EPOLLOUT | EPOLLET, 3)) {
+		printf("%s: epoll_ctl failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	ret += expect(name, ep, -1, 1, 3, EPOLLOUT);
+	ret += expect(name, ep, 100, 0, 0, 0);
+
+	/* EPOLL_CTL_MOD reports the current state again */
+	if (add(ep, EPOLL_CTL_MOD, fds[1], EPOLLOUT | EPOLLET, 4)) {
+		printf("%s: EPOLL_CTL_MOD failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	ret += expect(name, ep, -1, 1, 4, EPOLLOUT);
+	ret += expect(name, ep, 10, 0, 0, 0);
+
+	if (epoll_ctl(ep, EPOLL_CTL_DEL, fds[1], NULL)) {
+		printf("%s: EPOLL_CTL_DEL failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	/* new data is reported once, even if it is not consumed */
+	if (add(ep, EPOLL_CTL_ADD, fds[0], EPOLLIN | EPOLLET, 5)) {
+		printf("%s: epoll_ctl failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	ret += expect(name, ep, 10, 0, 0, 0);
+
+	if (write(fds[1], &c, 1) != 1)
+		ret--;
+	ret += expect(name, ep, -1, 1, 5, EPOLLIN);
+	ret += expect(name, ep, 100, 0, 0, 0);
+
+	close(fds[0]);
+	close(fds[1]);
+	close(ep);
+
+	if (!ret)
+		printf("%s: Test successful.\n", name);
+
+	return ret;
+}
+
+
+/*
+ * Test error conditions and implicit removal on close
+ */
+static int test_errors(void)
+{
+	char const *name = "Error test";
+	int ret = 0;
+	int fds[2];
+
+	int const ep = epoll_create1(0);
+	if (ep == -1 || pipe(fds) == -1) {
+		printf("%s: setup failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	if (add(ep, EPOLL_CTL_MOD, fds[1], EPOLLOUT, 0) != -1 || errno != ENOENT) {
+		printf("%s: EPOLL_CTL_MOD of unregistered fd succeeded\n", name);
+		ret--;
+	}
+
+	if (add(ep, EPOLL_CTL_ADD, fds[1], EPOLLOUT, 0)) {
+		printf("%s: epoll_ctl failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	if (add(ep, EPOLL_CTL_ADD, fds[1], EPOLLOUT, 0) != -1 || errno != EEXIST) {
+		printf("%s: duplicate EPOLL_CTL_ADD succeeded\n", name);
+		ret--;
+	}
+
+	if (add(ep, EPOLL_CTL_ADD, ep, EPOLLIN, 0) != -1 || errno != EINVAL) {
+		printf("%s: adding epoll fd to itself succeeded\n", name);
+		ret--;
+	}
+
+	if (epoll_wait(ep, NULL, 0, 0) != -1 || errno != EINVAL) {
+		printf("%s: epoll_wait with zero maxevents succeeded\n", name);
+		ret--;
+	}
+
+	/* closing the file descriptor removes it from the epoll instance */
+	close(fds[1]);
+	ret += expect(name, ep, 10, 0, 0, 0);
+
+	close(fds[0]);
+	close(ep);
+
+	if (!ret)
+		printf("%s: Test successful.\n", name);
+
+	return ret;
+}
+
+
+int main(int argc, char **argv)
+{
+	int retval = 0;
+
+	retval += test_read();
+	retval += test_modify();
+	retval += test_oneshot();
+	retval += test_edge();
+	retval += test_errors();
+
+	if (!retval)
+		printf("--- test succeeded ---\n");
+
+	return retval;
+}
@@ -0,0 +1,5 @@
+TARGET   = test-libc_epoll
+SRC_C    = epoll.c
+LIBS     = posix
+
+CC_CXX_WARN_STRICT =
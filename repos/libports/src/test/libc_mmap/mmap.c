@@ -0,0 +1,135 @@
+/*
+ * \brief  Test for read-only private file mappings
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/*
+ * A read-only private mapping of a whole file is attached from the
+ * dataspace of the VFS, a mapping of a part of the file is a copy. The
+ * repeated mapping of the whole file exceeds the RAM quota of the test
+ * unless each munmap releases the VFS dataspace.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+
+enum { PAGE = 4096, FILE_SIZE = 256*PAGE + 123, ROUNDS = 64 };
+
+static char const *path = "/tmp/data";
+
+
+static unsigned char pattern(size_t offset)
+{
+	return (unsigned char)(offset*7 + offset/PAGE);
+}
+
+
+static int create_file(void)
+{
+	static unsigned char buf[PAGE];
+
+	int const fd = open(path, O_CREAT | O_WRONLY | O_TRUNC, 0644);
+	if (fd == -1) {
+		printf("open for writing failed: %s\n", strerror(errno));
+		return -1;
+	}
+
+	for (size_t offset = 0; offset < FILE_SIZE; ) {
+		size_t const len = FILE_SIZE - offset < PAGE ? FILE_SIZE - offset : PAGE;
+
+		for (size_t i = 0; i < len; i++)
+			buf[i] = pattern(offset + i);
+
+		if (write(fd, buf, len) != (ssize_t)len) {
+			printf("write failed: %s\n", strerror(errno));
+			close(fd);
+			return -1;
+		}
+		offset += len;
+	}
+
+	close(fd);
+	return 0;
+}
+
+
+/*
+ * Map 'length' bytes at 'offset', check the content, and unmap
+ */
+static int check_mapping(char const *name, size_t length, off_t offset)
+{
+	int const fd = open(path, O_RDONLY);
+	if (fd == -1) {
+		printf("%s: open failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	unsigned char const * const ptr =
+		mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, offset);
+
+	close(fd);
+
+	if (ptr == MAP_FAILED) {
+		printf("%s: mmap failed: %s\n", name, strerror(errno));
+		return -1;
+	}
+
+	int ret = 0;
+
+	size_t const valid = (size_t)offset + length > FILE_SIZE
+	                   ? FILE_SIZE - (size_t)offset : length;
+
+	for (size_t i = 0; i < valid; i++)
+		if (ptr[i] != pattern((size_t)offset + i)) {
+			printf("%s: unexpected content at offset %zu\n", name,
+			       (size_t)offset + i);
+			ret = -1;
+			break;
+		}
+
+	if (munmap((void *)ptr, length) == -1) {
+		printf("%s: munmap failed: %s\n", name, strerror(errno));
+		ret = -1;
+	}
+
+	return ret;
+}
+
+
+int main(int argc, char **argv)
+{
+	int ret = 0;
+
+	if (create_file())
+		return -1;
+
+	/* whole file, attached from the VFS dataspace */
+	ret += check_mapping("whole file", FILE_SIZE, 0);
+
+	/* windows of the file, copied */
+	ret += check_mapping("first page", PAGE, 0);
+	ret += check_mapping("window", 2*PAGE, 17*PAGE);
+	ret += check_mapping("tail", 2*PAGE, 255*PAGE);
+
+	/* the dataspace of each mapping must be released on munmap */
+	for (unsigned i = 0; i < ROUNDS && !ret; i++)
+		ret += check_mapping("repeated whole file", FILE_SIZE, 0);
+
+	if (!ret)
+		printf("--- test succeeded ---\n");
+
+	return ret;
+}
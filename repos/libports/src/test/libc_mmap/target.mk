@@ -0,0 +1,5 @@
+TARGET   = test-libc_mmap
+SRC_C    = mmap.c
+LIBS     = posix
+
+CC_CXX_WARN_STRICT =
@@ -0,0 +1,149 @@
+/*
+ * \brief  Multithreaded malloc benchmark
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * Each thread repeatedly allocates and frees small blocks of varying size
+ * while keeping a working set of live blocks. Every round is repeated with
+ * an increasing number of threads to show how malloc scales with the number
+ * of concurrently allocating threads.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc includes */
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+enum {
+	MAX_THREADS  = 8,
+	WORKING_SET  = 256,
+	OPS          = 1000*1000,
+	MAX_SIZE     = 2000,
+};
+
+
+static unsigned long long now_us()
+{
+	timespec ts { };
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec*1000*1000 + ts.tv_nsec/1000;
+}
+
+
+struct Worker
+{
+	pthread_t     thread { };
+	unsigned      seed   { };
+	unsigned long ops    { };
+	bool          ok     { true };
+
+	void *blocks[WORKING_SET] { };
+
+	unsigned _random()
+	{
+		/* xorshift */
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		return seed;
+	}
+
+	void run()
+	{
+		for (unsigned long i = 0; i < ops; i++) {
+
+			void *&block = blocks[_random() % WORKING_SET];
+
+			if (block) {
+				/* detect corruption of blocks by other threads */
+				if (*(unsigned char *)block != (unsigned char)(uintptr_t)&block)
+					ok = false;
+
+				free(block);
+				block = nullptr;
+				continue;
+			}
+
+			size_t const size = 1 + _random() % MAX_SIZE;
+
+			block = malloc(size);
+			if (!block) {
+				ok = false;
+				return;
+			}
+			memset(block, (unsigned char)(uintptr_t)&block, size);
+		}
+
+		for (void *&block : blocks) {
+			free(block);
+			block = nullptr;
+		}
+	}
+
+	static void *entry(void *arg)
+	{
+		((Worker *)arg)->run();
+		return nullptr;
+	}
+};
+
+
+static Worker workers[MAX_THREADS];
+
+
+int main(int, char **)
+{
+	printf("--- malloc benchmark started ---\n");
+
+	bool ok = true;
+
+	for (unsigned num_threads = 1; num_threads <= MAX_THREADS; num_threads *= 2) {
+
+		for (unsigned i = 0; i < num_threads; i++) {
+			workers[i].seed = 0x9e3779b9u * (i + 1);
+			workers[i].ops  = OPS;
+		}
+
+		unsigned long long const start = now_us();
+
+		for (unsigned i = 0; i < num_threads; i++)
+			if (pthread_create(&workers[i].thread, nullptr,
+			                   Worker::entry, &workers[i]) != 0) {
+				printf("Error: pthread_create failed\n");
+				return -1;
+			}
+
+		for (unsigned i = 0; i < num_threads; i++)
+			pthread_join(workers[i].thread, nullptr);
+
+		unsigned long long const duration_us = now_us() - start;
+
+		for (unsigned i = 0; i < num_threads; i++)
+			ok = ok && workers[i].ok;
+
+		unsigned long long const total_ops = (unsigned long long)num_threads*OPS;
+
+		printf("threads: %u ops: %llu duration: %llu ms ops/s: %llu\n",
+		       num_threads, total_ops, duration_us/1000,
+		       duration_us ? total_ops*1000*1000/duration_us : 0);
+	}
+
+	if (!ok) {
+		printf("Error: corrupted or failed allocation\n");
+		return -1;
+	}
+
+	printf("--- malloc benchmark finished ---\n");
+	return 0;
+}
@@ -66,6 +66,24 @@ namespace Blit {
 	{
 		Slow::Blend::xrgb_a(dst, n, pixel, alpha);
 	}
+
+	/**
+	 * Replace a sequence of pixels by the average of 'pixel' and 'color'
+	 */
+	static inline void blend_xrgb_avr(uint32_t *dst, unsigned n,
+	                                  uint32_t const *pixel, uint32_t color)
+	{
+		Slow::Blend::xrgb_avr(dst, n, pixel, color);
+	}
+
+	/**
+	 * Copy a sequence of pixels to 'dst', skipping pixels of value 0
+	 */
+	static inline void blend_xrgb_masked(uint32_t *dst, unsigned n,
+	                                     uint32_t const *pixel)
+	{
+		Slow::Blend::xrgb_masked(dst, n, pixel);
+	}
 }
 
 #endif /* _INCLUDE__BLIT_H_ */
@@ -15,6 +15,7 @@
 #define _INCLUDE__BLIT__INTERNAL__NEON_H_
 
 #include <blit/types.h>
+#include <blit/internal/slow.h>
 
 /* compiler intrinsics */
 #pragma GCC diagnostic push
@@ -322,6 +323,8 @@ void Blit::Neon::B2f_flip::r270(uint32_t       *dst, unsigned dst_w,
 struct Blit::Neon::Blend
 {
 	static inline void xrgb_a(uint32_t *, unsigned, uint32_t const *, uint8_t const *);
+	static inline void xrgb_avr(uint32_t *, unsigned, uint32_t const *, uint32_t);
+	static inline void xrgb_masked(uint32_t *, unsigned, uint32_t const *);
 
 	__attribute__((optimize("-O3")))
 	static inline uint32_t _mix(uint32_t bg, uint32_t fg, uint8_t alpha)
@@ -397,4 +400,43 @@ void Blit::Neon::Blend::xrgb_a(uint32_t *dst, unsigned n,
 		*dst = _mix(*dst, *pixel, *alpha);
 }
 
+
+__attribute__((optimize("-O3")))
+void Blit::Neon::Blend::xrgb_avr(uint32_t *dst, unsigned n,
+                                 uint32_t const *pixel, uint32_t color)
+{
+	/*
+	 * Halve each component before adding, which yields the same result as
+	 * 'Slow::Blend::xrgb_avr' as opposed to the rounding 'vrhaddq_u8'.
+	 */
+	uint8x16_t const color_2x = vshrq_n_u8(vreinterpretq_u8_u32(vdupq_n_u32(color)), 1);
+
+	for (; n > 3; n -= 4, dst += 4, pixel += 4) {
+		uint8x16_t const p = vld1q_u8((uint8_t const *)pixel);
+		vst1q_u8((uint8_t *)dst, vaddq_u8(color_2x, vshrq_n_u8(p, 1)));
+	}
+
+	for (; n--; dst++, pixel++)
+		*dst = Slow::Blend::_avr(color, *pixel);
+}
+
+
+__attribute__((optimize("-O3")))
+void Blit::Neon::Blend::xrgb_masked(uint32_t *dst, unsigned n, uint32_t const *pixel)
+{
+	for (; n > 3; n -= 4, dst += 4, pixel += 4) {
+		uint32x4_t const p = vld1q_u32(pixel);
+		uint32x4_t const transparent = vceqzq_u32(p);
+
+		/* skip block if entirely transparent */
+		if (vminvq_u32(transparent))
+			continue;
+
+		vst1q_u32(dst, vbslq_u32(transparent, vld1q_u32(dst), p));
+	}
+
+	for (; n--; dst++, pixel++)
+		if (*pixel) *dst = *pixel;
+}
+
 #endif /* _INCLUDE__BLIT__INTERNAL__NEON_H_ */
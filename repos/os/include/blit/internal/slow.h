@@ -133,6 +133,13 @@ void Blit::Slow::B2f_flip::r270(uint32_t       *dst, unsigned dst_w,
 struct Blit::Slow::Blend
 {
 	static inline void xrgb_a(uint32_t *, unsigned, uint32_t const *, uint8_t const *);
+	static inline void xrgb_avr(uint32_t *, unsigned, uint32_t const *, uint32_t);
+	static inline void xrgb_masked(uint32_t *, unsigned, uint32_t const *);
+
+	static inline uint32_t _avr(uint32_t a, uint32_t b)
+	{
+		return ((a & 0xfefefefe) >> 1) + ((b & 0xfefefefe) >> 1);
+	}
 
 	__attribute__((optimize("-O3")))
 	static inline uint32_t _blend(uint32_t xrgb, unsigned alpha)
@@ -158,4 +165,21 @@ void Blit::Slow::Blend::xrgb_a(uint32_t *dst, unsigned n,
 		*dst = _mix(*dst, *pixel, *alpha);
 }
 
+
+__attribute__((optimize("-O3")))
+void Blit::Slow::Blend::xrgb_avr(uint32_t *dst, unsigned n,
+                                 uint32_t const *pixel, uint32_t color)
+{
+	for (; n--; dst++, pixel++)
+		*dst = _avr(color, *pixel);
+}
+
+
+__attribute__((optimize("-O3")))
+void Blit::Slow::Blend::xrgb_masked(uint32_t *dst, unsigned n, uint32_t const *pixel)
+{
+	for (; n--; dst++, pixel++)
+		if (*pixel) *dst = *pixel;
+}
+
 #endif /* _INCLUDE__BLIT__INTERNAL__SLOW_H_ */
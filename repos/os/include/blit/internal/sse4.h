@@ -15,6 +15,7 @@
 #define _INCLUDE__BLIT__INTERNAL__SSE4_H_
 
 #include <blit/types.h>
+#include <blit/internal/slow.h>
 
 /* compiler intrinsics */
 #ifndef _MM_MALLOC_H_INCLUDED   /* discharge dependency from stdlib.h */
@@ -306,6 +307,8 @@ void Blit::Sse4::B2f_flip::r270(uint32_t       *dst, unsigned dst_w,
 struct Blit::Sse4::Blend
 {
 	static inline void xrgb_a(uint32_t *, unsigned, uint32_t const *, uint8_t const *);
+	static inline void xrgb_avr(uint32_t *, unsigned, uint32_t const *, uint32_t);
+	static inline void xrgb_masked(uint32_t *, unsigned, uint32_t const *);
 
 	__attribute__((optimize("-O3")))
 	static inline uint32_t _blend(uint32_t xrgb, unsigned alpha)
@@ -391,4 +394,48 @@ void Blit::Sse4::Blend::xrgb_a(uint32_t *dst, unsigned n,
 		*dst = _mix(*dst, *pixel, *alpha);
 }
 
+
+__attribute__((optimize("-O3")))
+void Blit::Sse4::Blend::xrgb_avr(uint32_t *dst, unsigned n,
+                                 uint32_t const *pixel, uint32_t color)
+{
+	/*
+	 * Halve each component before adding, which yields the same result as
+	 * 'Slow::Blend::xrgb_avr' as opposed to the rounding '_mm_avg_epu8'.
+	 */
+	__m128i const mask     = _mm_set1_epi32(int(0xfefefefe));
+	__m128i const color_2x = _mm_srli_epi32(_mm_and_si128(_mm_set1_epi32(int(color)), mask), 1);
+
+	for (; n > 3; n -= 4, dst += 4, pixel += 4) {
+		__m128i const p = _mm_loadu_si128((__m128i const *)pixel);
+		_mm_storeu_si128((__m128i *)dst,
+		                 _mm_add_epi32(color_2x, _mm_srli_epi32(_mm_and_si128(p, mask), 1)));
+	}
+
+	for (; n--; dst++, pixel++)
+		*dst = Slow::Blend::_avr(color, *pixel);
+}
+
+
+__attribute__((optimize("-O3")))
+void Blit::Sse4::Blend::xrgb_masked(uint32_t *dst, unsigned n, uint32_t const *pixel)
+{
+	__m128i const zero = _mm_setzero_si128();
+
+	for (; n > 3; n -= 4, dst += 4, pixel += 4) {
+		__m128i const p = _mm_loadu_si128((__m128i const *)pixel);
+		__m128i const transparent = _mm_cmpeq_epi32(p, zero);
+
+		/* skip block if entirely transparent */
+		if (_mm_movemask_epi8(transparent) == 0xffff)
+			continue;
+
+		__m128i const d = _mm_loadu_si128((__m128i const *)dst);
+		_mm_storeu_si128((__m128i *)dst, _mm_blendv_epi8(p, d, transparent));
+	}
+
+	for (; n--; dst++, pixel++)
+		if (*pixel) *dst = *pixel;
+}
+
 #endif /* _INCLUDE__BLIT__INTERNAL__SSE3_H_ */
@@ -96,7 +96,8 @@ struct genode_nic_client_rx_context;
 
 typedef enum { GENODE_NIC_CLIENT_RX_REJECTED,
                GENODE_NIC_CLIENT_RX_ACCEPTED,
-               GENODE_NIC_CLIENT_RX_RETRY } genode_nic_client_rx_result_t;
+               GENODE_NIC_CLIENT_RX_RETRY,
+               GENODE_NIC_CLIENT_RX_RETAINED } genode_nic_client_rx_result_t;
 
 typedef genode_nic_client_rx_result_t (*genode_nic_client_rx_one_packet_t)
 	(struct genode_nic_client_rx_context *, char const *ptr, unsigned long len);
@@ -110,6 +111,39 @@ bool genode_nic_client_rx(struct genode_nic_client *,
                           genode_nic_client_rx_one_packet_t rx_one_packet,
                           struct genode_nic_client_rx_context *);
 
+/**
+ * Received packet retained by the client
+ */
+struct genode_nic_client_rx_packet
+{
+	long          offset;
+	unsigned long size;
+};
+
+typedef genode_nic_client_rx_result_t (*genode_nic_client_rx_one_packet_retainable_t)
+	(struct genode_nic_client_rx_context *, char *ptr, unsigned long len,
+	 struct genode_nic_client_rx_packet);
+
+/**
+ * Process packet reception, allowing the client to retain packets
+ *
+ * If the callback returns 'GENODE_NIC_CLIENT_RX_RETAINED', the client takes
+ * over the packet and can access its content in place until it releases
+ * the packet via 'genode_nic_client_rx_release'. The release may happen
+ * from within the callback.
+ *
+ * \return true if progress was made
+ */
+bool genode_nic_client_rx_retainable(struct genode_nic_client *,
+                                     genode_nic_client_rx_one_packet_retainable_t,
+                                     struct genode_nic_client_rx_context *);
+
+/**
+ * Acknowledge retained packet to the NIC server
+ */
+void genode_nic_client_rx_release(struct genode_nic_client *,
+                                  struct genode_nic_client_rx_packet);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -55,6 +55,11 @@ namespace Net {
 
 	/**
 	 * Accumulating modifier for incremental updates of internet checksums
+	 *
+	 * The modifier accumulates the differences caused by rewriting header
+	 * fields, e.g., addresses or ports, and applies them to the checksum
+	 * as specified in RFC 1624. This way, the checksum is updated without
+	 * visiting the remaining data that the checksum covers.
 	 */
 	class Internet_checksum_diff
 	{
@@ -84,7 +89,7 @@ namespace Net {
 			/**
 			 * Return the given checksum with this modifier applied
 			 */
-			Genode::uint16_t apply_to(signed long sum) const;
+			Genode::uint16_t apply_to(signed long checksum) const;
 	};
 }
 
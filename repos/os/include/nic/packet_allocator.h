@@ -17,9 +17,21 @@
 #define _INCLUDE__NIC__PACKET_ALLOCATOR__
 
 #include <os/packet_allocator.h>
+#include <os/segregated_packet_allocator.h>
 #include <base/log.h>
 
-namespace Nic { struct Packet_allocator; }
+namespace Nic {
+
+	template <typename> struct Packet_allocator_tpl;
+
+	using Packet_allocator = Packet_allocator_tpl<Genode::Packet_allocator>;
+
+	/**
+	 * NIC packet allocator with constant-time allocation and release
+	 */
+	using Segregated_packet_allocator =
+		Packet_allocator_tpl<Genode::Segregated_packet_allocator>;
+}
 
 
 /**
@@ -38,8 +50,13 @@ namespace Nic { struct Packet_allocator; }
  * Genode::Packet_allocator. As DEFAULT_PACKET_SIZE is used for the
  * transmission-buffer calculation we could not change it without breaking the
  * API. OFFSET_PACKET_SIZE reflects the actual (usable) packet-buffer size.
+ *
+ * The 'BACKEND' template argument selects the allocator that manages the
+ * packet buffer, which is either 'Genode::Packet_allocator' or
+ * 'Genode::Segregated_packet_allocator'.
  */
-struct Nic::Packet_allocator : Genode::Packet_allocator
+template <typename BACKEND>
+struct Nic::Packet_allocator_tpl : BACKEND
 {
 	enum {
 		DEFAULT_PACKET_SIZE = 1600,
@@ -47,15 +64,18 @@ struct Nic::Packet_allocator : Genode::Packet_allocator
 		OFFSET_PACKET_SIZE = DEFAULT_PACKET_SIZE - OFFSET,
 	};
 
-	using size_t = Genode::size_t;
+	using size_t     = Genode::size_t;
+	using Result     = typename BACKEND::Result;
+	using Error      = typename BACKEND::Error;
+	using Allocation = typename BACKEND::Allocation;
 
 	/**
 	 * Constructor
 	 *
 	 * \param md_alloc  Meta-data allocator
 	 */
-	Packet_allocator(Genode::Allocator *md_alloc)
-	: Genode::Packet_allocator(md_alloc, DEFAULT_PACKET_SIZE) {}
+	Packet_allocator_tpl(Genode::Allocator *md_alloc)
+	: BACKEND(md_alloc, DEFAULT_PACKET_SIZE) {}
 
 	Result try_alloc(size_t size) override
 	{
@@ -64,7 +84,7 @@ struct Nic::Packet_allocator : Genode::Packet_allocator
 			return Error::DENIED;
 		}
 
-		return Genode::Packet_allocator::try_alloc(size + OFFSET).convert<Result>(
+		return BACKEND::try_alloc(size + OFFSET).template convert<Result>(
 			[&] (Allocation &a) -> Result {
 				/* assume word-aligned packet buffer and offset packet by 2 bytes */
 				if ((Genode::addr_t)a.ptr & 0b11) {
@@ -88,7 +108,7 @@ struct Nic::Packet_allocator : Genode::Packet_allocator
 			return;
 		}
 
-		Genode::Packet_allocator::free((Genode::uint8_t *)addr - OFFSET, size + OFFSET);
+		BACKEND::free((Genode::uint8_t *)addr - OFFSET, size + OFFSET);
 	}
 
 
@@ -43,6 +43,57 @@ struct Texture_painter
 	using Rect  = Genode::Surface_base::Rect;
 
 
+	/*
+	 * Operations applied to a line of 'n' pixels
+	 *
+	 * The generic versions process one pixel at a time. For 'Pixel_rgb888',
+	 * the vectorized blit functions are used.
+	 */
+
+	template <typename PT>
+	static inline void _blend_line(PT *d, PT const *s, unsigned char const *a, unsigned n)
+	{
+		for (; n--; s++, d++, a++) {
+			unsigned char const alpha_value = *a;
+			if (__builtin_expect(alpha_value != 0, true))
+				*d = PT::mix(*d, *s, alpha_value + 1);
+		}
+	}
+
+	template <typename PT>
+	static inline void _mix_line(PT *d, PT const *s, PT const mix_pixel, unsigned n)
+	{
+		for (; n--; s++, d++)
+			*d = PT::avr(mix_pixel, *s);
+	}
+
+	template <typename PT>
+	static inline void _mask_line(PT *d, PT const *s, unsigned n)
+	{
+		for (; n--; s++, d++)
+			if (s->pixel) *d = *s;
+	}
+
+	static inline void _blend_line(Genode::Pixel_rgb888 *d, Genode::Pixel_rgb888 const *s,
+	                               unsigned char const *a, unsigned n)
+	{
+		Blit::blend_xrgb_a((Genode::uint32_t *)d, n, (Genode::uint32_t const *)s, a);
+	}
+
+	static inline void _mix_line(Genode::Pixel_rgb888 *d, Genode::Pixel_rgb888 const *s,
+	                             Genode::Pixel_rgb888 const mix_pixel, unsigned n)
+	{
+		Blit::blend_xrgb_avr((Genode::uint32_t *)d, n, (Genode::uint32_t const *)s,
+		                     mix_pixel.pixel);
+	}
+
+	static inline void _mask_line(Genode::Pixel_rgb888 *d, Genode::Pixel_rgb888 const *s,
+	                              unsigned n)
+	{
+		Blit::blend_xrgb_masked((Genode::uint32_t *)d, n, (Genode::uint32_t const *)s);
+	}
+
+
 	template <typename PT>
 	static inline void paint(Genode::Surface<PT>       &surface,
 	                         Genode::Texture<PT> const &texture,
@@ -74,10 +125,9 @@ struct Texture_painter
 
 		PT const mix_pixel(mix_color.r, mix_color.g, mix_color.b);
 
-		int i, j;
-		PT            const *s;
-		PT                  *d;
-		unsigned char const *a;
+		unsigned const w = clipped.w();
+
+		int j;
 
 		switch (mode) {
 
@@ -98,25 +148,19 @@ struct Texture_painter
 			 * Copy texture with alpha blending
 			 */
 			for (j = clipped.h(); j--; src += src_w, alpha += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, a = alpha, d = dst; i--; s++, d++, a++) {
-					unsigned char const alpha_value = *a;
-					if (__builtin_expect(alpha_value != 0, true))
-						*d = PT::mix(*d, *s, alpha_value + 1);
-				}
+				_blend_line(dst, src, alpha, w);
 			break;
 
 		case MIXED:
 
 			for (j = clipped.h(); j--; src += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, d = dst; i--; s++, d++)
-					*d = PT::avr(mix_pixel, *s);
+				_mix_line(dst, src, mix_pixel, w);
 			break;
 
 		case MASKED:
 
 			for (j = clipped.h(); j--; src += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, d = dst; i--; s++, d++)
-					if (s->pixel) *d = *s;
+				_mask_line(dst, src, w);
 			break;
 		}
 
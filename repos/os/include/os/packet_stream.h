@@ -60,6 +60,13 @@
  * These conditions must be queried before interacting with the queues by
  * using the methods 'packet_avail', 'ready_to_submit', 'ready_to_ack', and
  * 'ack_avail'.
+ *
+ * The submit queue and the acknowledgement queue are single-producer
+ * single-consumer ring buffers. By default, the accesses of each side are
+ * serialized by a mutex so that a side may be driven by multiple threads. A
+ * packet stream whose sides are each driven by a single thread can omit the
+ * mutexes by specifying 'Packet_stream_unlocked' as 'LOCK' argument of its
+ * 'Packet_stream_policy'.
  */
 
 /*
@@ -77,20 +84,24 @@
 #include <base/signal.h>
 #include <base/allocator.h>
 #include <base/attached_dataspace.h>
+#include <base/mutex.h>
 #include <util/string.h>
 #include <util/construct_at.h>
+#include <cpu/memory_barrier.h>
 
 namespace Genode {
 
 	class Packet_descriptor;
 
-	template <typename, int> class Packet_descriptor_queue;
-	template <typename>      class Packet_descriptor_transmitter;
-	template <typename>      class Packet_descriptor_receiver;
+	template <typename, int>      class Packet_descriptor_queue;
+	template <typename, typename> class Packet_descriptor_transmitter;
+	template <typename, typename> class Packet_descriptor_receiver;
 
 	class Packet_stream_base;
 
-	template <typename, unsigned, unsigned, typename>
+	struct Packet_stream_unlocked;
+
+	template <typename, unsigned, unsigned, typename, typename = Mutex>
 	struct Packet_stream_policy;
 
 	/**
@@ -152,6 +163,11 @@ class Genode::Packet_descriptor
 /**
  * Ring buffer shared between source and sink, containing packet descriptors
  *
+ * Each queue has exactly one producer and one consumer. The head index is
+ * written by the producer only and the tail index by the consumer only.
+ * Hence, the queue can be operated without locking as long as the
+ * descriptor slots and indices are accessed in the right order.
+ *
  * This class is private to the packet-stream interface.
  */
 template <typename PACKET_DESCRIPTOR, int QUEUE_SIZE>
@@ -159,17 +175,34 @@ class Genode::Packet_descriptor_queue
 {
 	private:
 
+		static_assert(QUEUE_SIZE > 1 && !(QUEUE_SIZE & (QUEUE_SIZE - 1)),
+		              "packet-descriptor queue size must be a power of two");
+
+		enum : unsigned { MASK = QUEUE_SIZE - 1, CACHE_LINE_SIZE = 64 };
+
 		/*
 		 * The anonymous struct is needed to skip the initialization of the
 		 * members, which are shared by both sides of the packet stream.
+		 *
+		 * Head and tail reside in distinct cache lines to prevent the
+		 * producer and the consumer from contending for the same line.
 		 */
 		struct
 		{
 			unsigned volatile _head;
+			char              _head_padding[CACHE_LINE_SIZE - sizeof(unsigned)];
 			unsigned volatile _tail;
+			char              _tail_padding[CACHE_LINE_SIZE - sizeof(unsigned)];
 			PACKET_DESCRIPTOR _queue[QUEUE_SIZE];
 		};
 
+		/*
+		 * Both indices are masked whenever read because the values are
+		 * controlled by the respective other side of the packet stream.
+		 */
+		unsigned _head_index() const { return _head & MASK; }
+		unsigned _tail_index() const { return _tail & MASK; }
+
 	public:
 
 		using Packet_descriptor = PACKET_DESCRIPTOR;
@@ -198,13 +231,24 @@ class Genode::Packet_descriptor_queue
 		 *
 		 * \return true on success, or
 		 *         false if queue is full
+		 *
+		 * Must be called by the producer only.
 		 */
 		bool add(PACKET_DESCRIPTOR packet)
 		{
 			if (full()) return false;
 
-			_queue[_head%QUEUE_SIZE] = packet;
-			_head = (_head + 1)%QUEUE_SIZE;
+			unsigned const head = _head_index();
+
+			/* write slot not before observing the consumer's tail (acquire) */
+			memory_barrier();
+
+			_queue[head] = packet;
+
+			/* make descriptor visible before publishing the new head (release) */
+			memory_barrier();
+
+			_head = (head + 1) & MASK;
 			return true;
 		}
 
@@ -212,58 +256,132 @@ class Genode::Packet_descriptor_queue
 		 * Take packet descriptor from queue
 		 *
 		 * \return  packet descriptor
+		 *
+		 * Must be called by the consumer only.
 		 */
 		PACKET_DESCRIPTOR get()
 		{
-			PACKET_DESCRIPTOR packet = _queue[_tail%QUEUE_SIZE];
-			_tail = (_tail + 1)%QUEUE_SIZE;
+			unsigned const tail = _tail_index();
+
+			/* read slot not before observing the producer's head (acquire) */
+			memory_barrier();
+
+			PACKET_DESCRIPTOR const packet = _queue[tail];
+
+			/* finish reading the slot before handing it back (release) */
+			memory_barrier();
+
+			_tail = (tail + 1) & MASK;
 			return packet;
 		}
 
+		/**
+		 * Place up to 'count' packet descriptors into queue
+		 *
+		 * \return number of descriptors added
+		 *
+		 * Must be called by the producer only. The new head is published
+		 * once for the whole batch.
+		 */
+		unsigned add(PACKET_DESCRIPTOR const *packets, unsigned count)
+		{
+			unsigned const n = min(count, slots_free());
+			if (!n) return 0;
+
+			unsigned const head = _head_index();
+
+			memory_barrier();
+
+			for (unsigned i = 0; i < n; i++)
+				_queue[(head + i) & MASK] = packets[i];
+
+			memory_barrier();
+
+			_head = (head + n) & MASK;
+			return n;
+		}
+
+		/**
+		 * Take up to 'count' packet descriptors from queue
+		 *
+		 * \return number of descriptors taken
+		 *
+		 * Must be called by the consumer only. The new tail is published
+		 * once for the whole batch.
+		 */
+		unsigned get(PACKET_DESCRIPTOR *packets, unsigned count)
+		{
+			unsigned const n = min(count, slots_used());
+			if (!n) return 0;
+
+			unsigned const tail = _tail_index();
+
+			memory_barrier();
+
+			for (unsigned i = 0; i < n; i++)
+				packets[i] = _queue[(tail + i) & MASK];
+
+			memory_barrier();
+
+			_tail = (tail + n) & MASK;
+			return n;
+		}
+
 		/**
 		 * Return current packet descriptor
 		 */
 		PACKET_DESCRIPTOR peek() const
 		{
-			return _queue[_tail%QUEUE_SIZE];
+			unsigned const tail = _tail_index();
+
+			memory_barrier();
+
+			return _queue[tail];
 		}
 
 		/**
 		 * Return true if packet-descriptor queue is empty
 		 */
-		bool empty() { return _tail == _head; }
+		bool empty() const { return _tail_index() == _head_index(); }
 
 		/**
 		 * Return true if packet-descriptor queue is full
 		 */
-		bool full() { return (_head + 1)%QUEUE_SIZE == _tail; }
+		bool full() const { return ((_head_index() + 1) & MASK) == _tail_index(); }
 
 		/**
 		 * Return true if a single element is stored in the queue
 		 */
-		bool single_element() { return (_tail + 1)%QUEUE_SIZE == _head; }
-
+		bool single_element() const { return ((_tail_index() + 1) & MASK) == _head_index(); }
 
 		/**
 		 * Return true if a single slot is left to be put into the queue
 		 */
-		bool single_slot_free() { return (_head + 2)%QUEUE_SIZE == _tail; }
+		bool single_slot_free() const { return ((_head_index() + 2) & MASK) == _tail_index(); }
 
 		/**
 		 * Return number of slots left to be put into the queue
 		 */
-		unsigned slots_free() {
-			return ((_tail > _head) ? _tail - _head
-			                        : QUEUE_SIZE - _head + _tail) - 1; }
+		unsigned slots_free() const {
+			return (_tail_index() - _head_index() - 1) & MASK; }
+
+		/**
+		 * Return number of descriptors stored in the queue
+		 */
+		unsigned slots_used() const {
+			return (_head_index() - _tail_index()) & MASK; }
 };
 
 
 /**
  * Transmit packet descriptors with data-flow control
  *
+ * The transmitter is the only producer of its queue. Concurrent calls by
+ * multiple threads are serialized by 'LOCK'.
+ *
  * This class is private to the packet-stream interface.
  */
-template <typename TX_QUEUE>
+template <typename TX_QUEUE, typename LOCK>
 class Genode::Packet_descriptor_transmitter
 {
 	private:
@@ -271,9 +389,9 @@ class Genode::Packet_descriptor_transmitter
 		/* facility to send ready-to-receive signals */
 		Signal_transmitter _rx_ready { };
 
-		Mutex     _tx_queue_mutex { };
-		TX_QUEUE *_tx_queue;
-		bool      _tx_wakeup_needed = false;
+		LOCK mutable _tx_queue_lock { };
+		TX_QUEUE    *_tx_queue;
+		bool         _tx_wakeup_needed = false;
 
 		/*
 		 * Noncopyable
@@ -306,43 +424,61 @@ class Genode::Packet_descriptor_transmitter
 				_rx_ready.submit();
 		}
 
-		bool ready_for_tx()
+		bool ready_for_tx() const
 		{
-			Mutex::Guard mutex_guard(_tx_queue_mutex);
+			typename LOCK::Guard guard(_tx_queue_lock);
 			return !_tx_queue->full();
 		}
 
 		void tx(typename TX_QUEUE::Packet_descriptor packet)
 		{
-			Mutex::Guard mutex_guard(_tx_queue_mutex);
+			typename LOCK::Guard guard(_tx_queue_lock);
 
-			if (_tx_queue->full())
+			if (!_tx_queue->add(packet))
 				throw Saturated_tx_queue();
 
-			_tx_queue->add(packet);
-
 			if (_tx_queue->single_element())
 				_rx_ready.submit();
 		}
 
 		bool try_tx(typename TX_QUEUE::Packet_descriptor packet)
 		{
-			Mutex::Guard mutex_guard(_tx_queue_mutex);
+			typename LOCK::Guard guard(_tx_queue_lock);
 
-			if (_tx_queue->full())
+			if (!_tx_queue->add(packet))
 				return false;
 
-			_tx_queue->add(packet);
-
 			if (_tx_queue->single_element())
 				_tx_wakeup_needed = true;
 
 			return true;
 		}
 
+		/**
+		 * Transmit up to 'count' packet descriptors
+		 *
+		 * \return number of transmitted descriptors
+		 *
+		 * A wakeup is noted at most once for the whole batch, namely if
+		 * the queue contained no other descriptors than the batch.
+		 */
+		unsigned try_tx(typename TX_QUEUE::Packet_descriptor const *packets,
+		                unsigned count)
+		{
+			typename LOCK::Guard guard(_tx_queue_lock);
+
+			unsigned const n = _tx_queue->add(packets, count);
+
+			unsigned const used = _tx_queue->slots_used();
+			if (n && used && used <= n)
+				_tx_wakeup_needed = true;
+
+			return n;
+		}
+
 		bool tx_wakeup()
 		{
-			Mutex::Guard mutex_guard(_tx_queue_mutex);
+			typename LOCK::Guard guard(_tx_queue_lock);
 
 			bool signal_submitted = false;
 
@@ -358,16 +494,19 @@ class Genode::Packet_descriptor_transmitter
 		/**
 		 * Return number of slots left to be put into the tx queue
 		 */
-		unsigned tx_slots_free() { return _tx_queue->slots_free(); }
+		unsigned tx_slots_free() const { return _tx_queue->slots_free(); }
 };
 
 
 /**
  * Receive packet descriptors with data-flow control
  *
+ * The receiver is the only consumer of its queue. Concurrent calls by
+ * multiple threads are serialized by 'LOCK'.
+ *
  * This class is private to the packet-stream interface.
  */
-template <typename RX_QUEUE>
+template <typename RX_QUEUE, typename LOCK>
 class Genode::Packet_descriptor_receiver
 {
 	private:
@@ -375,9 +514,9 @@ class Genode::Packet_descriptor_receiver
 		/* facility to send ready-to-transmit signals */
 		Signal_transmitter _tx_ready { };
 
-		Mutex mutable _rx_queue_mutex { };
-		RX_QUEUE     *_rx_queue;
-		bool          _rx_wakeup_needed = false;
+		LOCK mutable _rx_queue_lock { };
+		RX_QUEUE    *_rx_queue;
+		bool         _rx_wakeup_needed = false;
 
 		/*
 		 * Noncopyable
@@ -410,15 +549,15 @@ class Genode::Packet_descriptor_receiver
 				_tx_ready.submit();
 		}
 
-		bool ready_for_rx()
+		bool ready_for_rx() const
 		{
-			Mutex::Guard mutex_guard(_rx_queue_mutex);
+			typename LOCK::Guard guard(_rx_queue_lock);
 			return !_rx_queue->empty();
 		}
 
 		void rx(typename RX_QUEUE::Packet_descriptor *out_packet)
 		{
-			Mutex::Guard mutex_guard(_rx_queue_mutex);
+			typename LOCK::Guard guard(_rx_queue_lock);
 
 			if (_rx_queue->empty())
 				throw Empty_rx_queue();
@@ -431,7 +570,7 @@ class Genode::Packet_descriptor_receiver
 
 		typename RX_QUEUE::Packet_descriptor try_rx()
 		{
-			Mutex::Guard mutex_guard(_rx_queue_mutex);
+			typename LOCK::Guard guard(_rx_queue_lock);
 
 			typename RX_QUEUE::Packet_descriptor packet { };
 
@@ -444,9 +583,30 @@ class Genode::Packet_descriptor_receiver
 			return packet;
 		}
 
+		/**
+		 * Receive up to 'count' packet descriptors
+		 *
+		 * \return number of received descriptors
+		 *
+		 * A wakeup is noted at most once for the whole batch, namely if
+		 * the queue was saturated before.
+		 */
+		unsigned try_rx(typename RX_QUEUE::Packet_descriptor *packets,
+		                unsigned count)
+		{
+			typename LOCK::Guard guard(_rx_queue_lock);
+
+			unsigned const n = _rx_queue->get(packets, count);
+
+			if (n && _rx_queue->slots_free() <= n)
+				_rx_wakeup_needed = true;
+
+			return n;
+		}
+
 		bool rx_wakeup(bool omit_signal)
 		{
-			Mutex::Guard mutex_guard(_rx_queue_mutex);
+			typename LOCK::Guard guard(_rx_queue_lock);
 
 			bool signal_submitted = false;
 
@@ -462,7 +622,7 @@ class Genode::Packet_descriptor_receiver
 
 		typename RX_QUEUE::Packet_descriptor rx_peek() const
 		{
-			Mutex::Guard mutex_guard(_rx_queue_mutex);
+			typename LOCK::Guard guard(_rx_queue_lock);
 			return _rx_queue->peek();
 		}
 };
@@ -568,17 +728,41 @@ class Genode::Packet_stream_base
 };
 
 
+/**
+ * Lock type for packet streams whose sides are each driven by one thread
+ *
+ * With this type as 'LOCK' argument of 'Packet_stream_policy', the queue
+ * accesses of each side are not serialized. The queues remain safe to use
+ * by the single thread of the source and the single thread of the sink.
+ */
+struct Genode::Packet_stream_unlocked : Noncopyable
+{
+	struct Guard
+	{
+		explicit Guard(Packet_stream_unlocked &) { }
+	};
+
+	Packet_stream_unlocked() { }
+};
+
+
 /**
  * Policy used by both sides source and sink
+ *
+ * The 'LOCK' type serializes the accesses of each side to its queues. It
+ * is local to each side and does not affect the layout of the shared
+ * communication buffer.
  */
 template <typename PACKET_DESCRIPTOR,
           unsigned SUBMIT_QUEUE_SIZE,
           unsigned ACK_QUEUE_SIZE,
-          typename CONTENT_TYPE>
+          typename CONTENT_TYPE,
+          typename LOCK>
 struct Genode::Packet_stream_policy
 {
 	using Content_type      = CONTENT_TYPE;
 	using Packet_descriptor = PACKET_DESCRIPTOR;
+	using Lock              = LOCK;
 
 	using Submit_queue = Packet_descriptor_queue<PACKET_DESCRIPTOR, SUBMIT_QUEUE_SIZE>;
 	using Ack_queue    = Packet_descriptor_queue<PACKET_DESCRIPTOR, ACK_QUEUE_SIZE>;
@@ -605,8 +789,8 @@ class Genode::Packet_stream_source : private Packet_stream_base
 
 		Range_allocator &_packet_alloc;
 
-		Packet_descriptor_transmitter<Submit_queue> _submit_transmitter;
-		Packet_descriptor_receiver<Ack_queue>       _ack_receiver;
+		Packet_descriptor_transmitter<Submit_queue, typename POLICY::Lock> _submit_transmitter;
+		Packet_descriptor_receiver<Ack_queue, typename POLICY::Lock>       _ack_receiver;
 
 	public:
 
@@ -779,6 +963,20 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return _submit_transmitter.try_tx(packet);
 		}
 
+		/**
+		 * Submit up to 'count' packets to the server
+		 *
+		 * \return number of submitted packets, which is lower than 'count'
+		 *         if the submit queue is congested
+		 *
+		 * This method never blocks. The sink is signalled at most once for
+		 * the whole batch by the next call of 'wakeup'.
+		 */
+		unsigned try_submit_packets(Packet_descriptor const *packets, unsigned count)
+		{
+			return _submit_transmitter.try_tx(packets, count);
+		}
+
 		/**
 		 * Wake up the packet sink if needed
 		 *
@@ -822,6 +1020,18 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return _ack_receiver.try_rx();
 		}
 
+		/**
+		 * Obtain up to 'count' acknowledgements from sink
+		 *
+		 * \return number of acknowledged packets stored in 'packets'
+		 *
+		 * This method never blocks.
+		 */
+		unsigned try_get_acked_packets(Packet_descriptor *packets, unsigned count)
+		{
+			return _ack_receiver.try_rx(packets, count);
+		}
+
 		/**
 		 * Release bulk-buffer space consumed by the packet
 		 */
@@ -862,8 +1072,8 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 
 	private:
 
-		Packet_descriptor_receiver<Submit_queue> _submit_receiver;
-		Packet_descriptor_transmitter<Ack_queue> _ack_transmitter;
+		Packet_descriptor_receiver<Submit_queue, typename POLICY::Lock> _submit_receiver;
+		Packet_descriptor_transmitter<Ack_queue, typename POLICY::Lock> _ack_transmitter;
 
 	public:
 
@@ -936,6 +1146,18 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			return _submit_receiver.try_rx();
 		}
 
+		/**
+		 * Obtain up to 'count' packets from source
+		 *
+		 * \return number of packets stored in 'packets'
+		 *
+		 * This method never blocks.
+		 */
+		unsigned try_get_packets(Packet_descriptor *packets, unsigned count)
+		{
+			return _submit_receiver.try_rx(packets, count);
+		}
+
 		/**
 		 * Wake up the packet source if needed
 		 *
@@ -1006,6 +1228,20 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			return _ack_transmitter.try_tx(packet);
 		}
 
+		/**
+		 * Acknowledge up to 'count' packets to the client
+		 *
+		 * \return number of acknowledged packets, which is lower than
+		 *         'count' if the acknowledgement queue is congested
+		 *
+		 * This method never blocks. The source is signalled at most once
+		 * for the whole batch by the next call of 'wakeup'.
+		 */
+		unsigned try_ack_packets(Packet_descriptor const *packets, unsigned count)
+		{
+			return _ack_transmitter.try_tx(packets, count);
+		}
+
 		void debug_print_buffers() {
 			Packet_stream_base::_debug_print_buffers(); }
 
@@ -0,0 +1,378 @@
+/*
+ * \brief  Constant-time packet allocator for packet streams
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__OS__SEGREGATED_PACKET_ALLOCATOR_H_
+#define _INCLUDE__OS__SEGREGATED_PACKET_ALLOCATOR_H_
+
+#include <base/allocator.h>
+#include <base/log.h>
+
+namespace Genode { class Segregated_packet_allocator; }
+
+
+/**
+ * Packet allocator based on two-level segregated free lists
+ *
+ * This allocator is a drop-in replacement for 'Genode::Packet_allocator'.
+ * Like the latter, it hands out packets with the granularity of a block
+ * size. Free ranges of blocks are kept in free lists, one for each size
+ * class. A two-level bitmap of non-empty size classes is searched via
+ * find-first-set. Hence, allocation and release take constant time,
+ * independent from the fragmentation of the bulk buffer. Freed ranges are
+ * immediately coalesced with their free neighbours.
+ *
+ * All meta data is kept outside of the bulk buffer, which is shared with
+ * the peer of the packet stream. Because packets to be released are
+ * reported back by the peer, 'free' validates the packet against the meta
+ * data and ignores packets that were not handed out by the allocator.
+ */
+class Genode::Segregated_packet_allocator : public Genode::Range_allocator
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Segregated_packet_allocator(Segregated_packet_allocator const &);
+		Segregated_packet_allocator &operator = (Segregated_packet_allocator const &);
+
+		enum : uint32_t { INVALID = ~0U };
+
+		/*
+		 * Each power-of-two range of sizes is subdivided into 'SL_COUNT'
+		 * size classes. Sizes below 'SL_COUNT' blocks have a class of
+		 * their own.
+		 */
+		enum { SL_LOG2 = 4, SL_COUNT = 1 << SL_LOG2, FL_COUNT = 32 - SL_LOG2 + 1 };
+
+		/**
+		 * Meta data of a block, valid if the block starts a region
+		 */
+		struct Region
+		{
+			uint32_t size;       /* number of blocks                     */
+			uint32_t prev_phys;  /* start of physically preceding region */
+			uint32_t next_free;  /* free-list successor                  */
+			uint32_t prev_free;  /* free-list predecessor                */
+			bool     start;      /* block is the first block of a region */
+			bool     free;
+		};
+
+		struct Index { unsigned fl, sl; };
+
+		Allocator *_md_alloc;          /* meta-data allocator               */
+		size_t     _block_size;        /* granularity of packet allocations */
+		addr_t     _base       = 0;    /* allocation base                   */
+		uint32_t   _num_blocks = 0;
+		uint32_t   _free_blocks = 0;
+		Region    *_regions    = nullptr;
+
+		uint32_t _fl_bitmap = 0;
+		uint32_t _sl_bitmap[FL_COUNT] { };
+		uint32_t _heads[FL_COUNT][SL_COUNT] { };
+
+		static unsigned _msb(uint32_t v) { return 31 - __builtin_clz(v); }
+		static unsigned _lsb(uint32_t v) { return __builtin_ctz(v); }
+
+		/**
+		 * Return size class that contains 'size'
+		 */
+		static Index _index(uint32_t size)
+		{
+			if (size < SL_COUNT)
+				return { 0, size };
+
+			unsigned const msb = _msb(size);
+			return { msb - SL_LOG2 + 1, (size >> (msb - SL_LOG2)) ^ SL_COUNT };
+		}
+
+		/**
+		 * Return smallest size class whose ranges all hold 'size' blocks
+		 */
+		static Index _search_index(uint32_t size)
+		{
+			if (size < SL_COUNT)
+				return _index(size);
+
+			uint64_t const rounded = (uint64_t)size + (1U << (_msb(size) - SL_LOG2)) - 1;
+			if (rounded > INVALID)
+				return { FL_COUNT, 0 };
+
+			return _index((uint32_t)rounded);
+		}
+
+		void _insert_free(uint32_t i)
+		{
+			Region &r = _regions[i];
+
+			Index const idx = _index(r.size);
+			uint32_t &head = _heads[idx.fl][idx.sl];
+
+			r.free      = true;
+			r.prev_free = INVALID;
+			r.next_free = head;
+
+			if (head != INVALID)
+				_regions[head].prev_free = i;
+
+			head = i;
+
+			_fl_bitmap         |= 1U << idx.fl;
+			_sl_bitmap[idx.fl] |= 1U << idx.sl;
+
+			_free_blocks += r.size;
+		}
+
+		void _remove_free(uint32_t i)
+		{
+			Region &r = _regions[i];
+
+			Index const idx = _index(r.size);
+			uint32_t &head = _heads[idx.fl][idx.sl];
+
+			if (r.prev_free != INVALID)
+				_regions[r.prev_free].next_free = r.next_free;
+			else
+				head = r.next_free;
+
+			if (r.next_free != INVALID)
+				_regions[r.next_free].prev_free = r.prev_free;
+
+			if (head == INVALID) {
+				_sl_bitmap[idx.fl] &= ~(1U << idx.sl);
+				if (!_sl_bitmap[idx.fl])
+					_fl_bitmap &= ~(1U << idx.fl);
+			}
+
+			r.free = false;
+
+			_free_blocks -= r.size;
+		}
+
+		/**
+		 * Return start of a free region with at least 'size' blocks
+		 */
+		uint32_t _find_free(uint32_t size) const
+		{
+			Index idx = _search_index(size);
+			if (idx.fl >= FL_COUNT)
+				return INVALID;
+
+			uint32_t sl_map = _sl_bitmap[idx.fl] & (~0U << idx.sl);
+			if (!sl_map) {
+
+				uint32_t const fl_map = (idx.fl + 1 < FL_COUNT)
+				                      ? _fl_bitmap & (~0U << (idx.fl + 1)) : 0;
+				if (!fl_map)
+					return INVALID;
+
+				idx.fl = _lsb(fl_map);
+				sl_map = _sl_bitmap[idx.fl];
+			}
+			return _heads[idx.fl][_lsb(sl_map)];
+		}
+
+		/**
+		 * Set the physical predecessor of the region following 'i'
+		 */
+		void _link_successor(uint32_t i)
+		{
+			uint32_t const next = i + _regions[i].size;
+			if (next < _num_blocks)
+				_regions[next].prev_phys = i;
+		}
+
+		/**
+		 * Trim region 'i' to 'size' blocks, returning the rest to the free lists
+		 */
+		void _split(uint32_t i, uint32_t size)
+		{
+			Region &r = _regions[i];
+			if (r.size == size)
+				return;
+
+			uint32_t const rest = i + size;
+
+			_regions[rest] = Region { .size      = r.size - size,
+			                          .prev_phys = i,
+			                          .next_free = INVALID,
+			                          .prev_free = INVALID,
+			                          .start     = true,
+			                          .free      = false };
+			r.size = size;
+
+			_link_successor(rest);
+			_insert_free(rest);
+		}
+
+		uint32_t _blocks(size_t size) const
+		{
+			return (uint32_t)((size + _block_size - 1) / _block_size);
+		}
+
+		void _reset()
+		{
+			_fl_bitmap = 0;
+			for (unsigned fl = 0; fl < FL_COUNT; fl++) {
+				_sl_bitmap[fl] = 0;
+				for (unsigned sl = 0; sl < SL_COUNT; sl++)
+					_heads[fl][sl] = INVALID;
+			}
+			_base = 0;
+			_num_blocks = _free_blocks = 0;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param md_alloc       Meta-data allocator
+		 * \param block_size     Granularity of packets in stream
+		 */
+		Segregated_packet_allocator(Allocator *md_alloc, size_t block_size)
+		: _md_alloc(md_alloc), _block_size(block_size) { _reset(); }
+
+		~Segregated_packet_allocator()
+		{
+			if (_regions)
+				_md_alloc->free(_regions, _num_blocks*sizeof(Region));
+		}
+
+
+		/*******************************
+		 ** Range-allocator interface **
+		 *******************************/
+
+		Range_result add_range(addr_t const base, size_t const size) override
+		{
+			if (_regions)
+				return Alloc_error::DENIED;
+
+			size_t const num_blocks = size / _block_size;
+			if (!num_blocks || num_blocks >= INVALID)
+				return Alloc_error::DENIED;
+
+			return _md_alloc->try_alloc(num_blocks*sizeof(Region)).convert<Range_result>(
+				[&] (Allocation &a) -> Range_result {
+					a.deallocate = false;
+
+					_reset();
+					_regions    = (Region *)a.ptr;
+					_base       = base;
+					_num_blocks = (uint32_t)num_blocks;
+
+					for (uint32_t i = 0; i < _num_blocks; i++)
+						_regions[i] = Region { };
+
+					_regions[0] = Region { .size      = _num_blocks,
+					                       .prev_phys = INVALID,
+					                       .next_free = INVALID,
+					                       .prev_free = INVALID,
+					                       .start     = true,
+					                       .free      = false };
+					_insert_free(0);
+					return Ok();
+				},
+				[&] (Alloc_error e) { return e; });
+		}
+
+		Range_result remove_range(addr_t base, size_t) override
+		{
+			if (!_regions || _base != base)
+				return Alloc_error::DENIED;
+
+			_md_alloc->free(_regions, _num_blocks*sizeof(Region));
+			_regions = nullptr;
+			_reset();
+
+			return Ok();
+		}
+
+		Alloc_result alloc_aligned(size_t size, Align, Range) override
+		{
+			return try_alloc(size);
+		}
+
+		Alloc_result try_alloc(size_t size) override
+		{
+			if (!_regions || !size || size > (size_t)_num_blocks*_block_size)
+				return Alloc_error::DENIED;
+
+			uint32_t const cnt = _blocks(size);
+
+			uint32_t const i = _find_free(cnt);
+			if (i == INVALID)
+				return Alloc_error::DENIED;
+
+			_remove_free(i);
+			_split(i, cnt);
+
+			return { *this, {
+				.ptr = reinterpret_cast<void *>(i * _block_size + _base),
+				.num_bytes = size } };
+		}
+
+		void _free(Allocation &a) override { free(a.ptr, a.num_bytes); }
+
+		void free(void *addr, size_t size) override
+		{
+			addr_t const offset = (addr_t)addr - _base;
+			uint32_t const i = (uint32_t)(offset / _block_size);
+
+			if (!_regions || (addr_t)addr < _base || offset % _block_size
+			 || i >= _num_blocks || !_regions[i].start || _regions[i].free
+			 || _regions[i].size != _blocks(size)) {
+				warning("Segregated_packet_allocator: invalid free of ", addr,
+				        " size ", size);
+				return;
+			}
+
+			uint32_t start = i;
+
+			/* coalesce with physical successor */
+			uint32_t const next = i + _regions[i].size;
+			if (next < _num_blocks && _regions[next].free) {
+				_remove_free(next);
+				_regions[i].size    += _regions[next].size;
+				_regions[next].start = false;
+			}
+
+			/* coalesce with physical predecessor */
+			uint32_t const prev = _regions[i].prev_phys;
+			if (prev != INVALID && _regions[prev].free) {
+				_remove_free(prev);
+				_regions[prev].size += _regions[i].size;
+				_regions[i].start    = false;
+				start = prev;
+			}
+
+			_link_successor(start);
+			_insert_free(start);
+		}
+
+
+		/*************
+		 ** Dummies **
+		 *************/
+
+		bool need_size_for_free() const override { return true; }
+		void free(void *) override { }
+		size_t overhead(size_t) const override {  return 0;}
+		size_t avail() const override { return _free_blocks*_block_size; }
+		bool valid_addr(addr_t) const override { return 0; }
+		Alloc_result alloc_addr(size_t, addr_t) override {
+			return Alloc_error::DENIED; }
+};
+
+#endif /* _INCLUDE__OS__SEGREGATED_PACKET_ALLOCATOR_H_ */
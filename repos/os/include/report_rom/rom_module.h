@@ -18,6 +18,7 @@
 #include <util/reconstructible.h>
 #include <os/session_policy.h>
 #include <base/attached_ram_dataspace.h>
+#include <rom_session/rom_session.h>
 
 namespace Rom {
 	using Genode::size_t;
@@ -27,6 +28,7 @@ namespace Rom {
 
 	class Module;
 	class Readable_module;
+	class Shared_content;
 	class Registry;
 	class Writer;
 	class Reader;
@@ -58,6 +60,90 @@ struct Rom::Reader : private Reader_list::Element, Interface
 };
 
 
+/**
+ * Immutable version of the content of a ROM module
+ *
+ * The content is stored in a sealed RAM dataspace, which is handed out
+ * read-only to all ROM clients that read the version. The version is
+ * reference-counted and destroyed as soon as neither the module nor any ROM
+ * session refers to it anymore.
+ */
+class Rom::Shared_content : Genode::Noncopyable
+{
+	private:
+
+		Genode::Allocator &_alloc;
+
+		Attached_ram_dataspace _ds;
+
+		size_t const _size;
+
+		unsigned _ref_cnt = 1;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * The content is followed by a zero termination.
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Shared_content(Genode::Allocator     &alloc,
+		               Genode::Ram_allocator &ram,
+		               Genode::Env::Local_rm &rm,
+		               char const * const src, size_t const src_len)
+		:
+			_alloc(alloc), _ds(ram, rm, src_len + 1), _size(src_len)
+		{
+			Genode::memcpy(_ds.local_addr<char>(), src, src_len);
+			_ds.local_addr<char>()[src_len] = 0;
+
+			ram.seal(_ds.cap());
+		}
+
+		/**
+		 * Create version with content of 'src', returns nullptr on error
+		 */
+		static Shared_content *create(Genode::Allocator     &alloc,
+		                              Genode::Ram_allocator &ram,
+		                              Genode::Env::Local_rm &rm,
+		                              char const * const src, size_t const src_len)
+		{
+			try { return new (alloc) Shared_content(alloc, ram, rm, src, src_len); }
+			catch (Genode::Out_of_ram)  { }
+			catch (Genode::Out_of_caps) { }
+			return nullptr;
+		}
+
+		Shared_content &acquire()
+		{
+			_ref_cnt++;
+			return *this;
+		}
+
+		/**
+		 * Drop reference, destroy version when unused
+		 */
+		static void release(Shared_content &content)
+		{
+			if (--content._ref_cnt == 0)
+				Genode::destroy(content._alloc, &content);
+		}
+
+		size_t size() const { return _size; }
+
+		char const *local_addr() const { return _ds.local_addr<char const>(); }
+
+		Genode::Rom_dataspace_capability dataspace() const
+		{
+			Genode::Dataspace_capability ds_cap = _ds.cap();
+			return Genode::static_cap_cast<Genode::Rom_dataspace>(ds_cap);
+		}
+};
+
+
 struct Rom::Readable_module : Interface
 {
 	/**
@@ -76,6 +162,17 @@ struct Rom::Readable_module : Interface
 	                            size_t dst_len) const = 0;
 
 	virtual size_t size() const = 0;
+
+	/**
+	 * Obtain a reference to the current content version
+	 *
+	 * Returns nullptr if the module does not share its content with the
+	 * reader. In this case, the content must be obtained via 'read_content'.
+	 * Otherwise, the caller is responsible for dropping the reference via
+	 * 'Shared_content::release'.
+	 */
+	virtual Shared_content *acquire_shared_content(Reader const &) const {
+		return nullptr; }
 };
 
 
@@ -165,6 +262,33 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		 */
 		size_t _size = 0;
 
+		/**
+		 * Allocator of shared content versions
+		 *
+		 * If defined, each report is stored in a new 'Shared_content' version
+		 * instead of '_ds'. The version is handed out to all ROM clients
+		 * without copying.
+		 */
+		Genode::Allocator * const _shared_alloc;
+
+		Shared_content *_shared = nullptr;
+
+		void _release_shared()
+		{
+			if (_shared)
+				Shared_content::release(*_shared);
+
+			_shared = nullptr;
+		}
+
+		char const *_content() const
+		{
+			if (_shared)
+				return _shared->local_addr();
+
+			return _ds.constructed() ? _ds->local_addr<char>() : nullptr;
+		}
+
 
 		/********************************
 		 ** Interface used by registry **
@@ -183,15 +307,19 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		 *                      time when the module content is obtained
 		 * \param write_policy  policy hook function that is evaluated each
 		 *                      time when the module content is changed
+		 * \param shared_alloc  allocator for shared content versions, if
+		 *                      nullptr, the content is copied to each reader
 		 */
 		Module(Genode::Ram_allocator &ram,
 		       Genode::Env::Local_rm &rm,
 		       Name            const &name,
 		       Read_policy     const &read_policy,
-		       Write_policy    const &write_policy)
+		       Write_policy    const &write_policy,
+		       Genode::Allocator     *shared_alloc = nullptr)
 		:
 			_name(name), _ram(ram), _rm(rm),
-			_read_policy(read_policy), _write_policy(write_policy)
+			_read_policy(read_policy), _write_policy(write_policy),
+			_shared_alloc(shared_alloc)
 		{ }
 
 
@@ -223,7 +351,9 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 			/* clear content if its origin disappears */
 			if (_last_writer == &writer) {
-				Genode::bzero(_ds->local_addr<char>(), _size);
+				if (_ds.constructed())
+					Genode::bzero(_ds->local_addr<char>(), _size);
+				_release_shared();
 				_size = 0;
 				_last_writer = nullptr;
 			}
@@ -258,6 +388,8 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 	public:
 
+		~Module() { _release_shared(); }
+
 		/**
 		 * Assign new content to the ROM module
 		 *
@@ -272,27 +404,46 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 			_last_writer = &writer;
 
-			/*
-			 * Realloc backing store if needed
-			 *
-			 * Take a terminating zero into account, which we append to each
-			 * report. This way, we do not need to trust report clients to
-			 * append a zero termination to textual reports.
-			 */
-			if (!_ds.constructed() || _ds->size() < (src_len + 1))
-				_ds.construct(_ram, _rm, (src_len + 1));
-
-			/* copy content into backing store */
-			_size = src_len;
-			Genode::memcpy(_ds->local_addr<char>(), src, _size);
-
-			/* append zero termination */
-			_ds->local_addr<char>()[src_len] = 0;
+			if (_shared_alloc) {
+
+				/*
+				 * Replace the current version, which remains valid for the
+				 * ROM sessions still referring to it
+				 */
+				_release_shared();
+				_shared = Shared_content::create(*_shared_alloc, _ram, _rm,
+				                                 src, src_len);
+				if (!_shared) {
+					Genode::warning("failed to allocate shared content of "
+					                "module '", _name, "'");
+					_last_writer = nullptr;
+				}
+				_size = _shared ? src_len : 0;
+
+			} else {
+
+				/*
+				 * Realloc backing store if needed
+				 *
+				 * Take a terminating zero into account, which we append to
+				 * each report. This way, we do not need to trust report
+				 * clients to append a zero termination to textual reports.
+				 */
+				if (!_ds.constructed() || _ds->size() < (src_len + 1))
+					_ds.construct(_ram, _rm, (src_len + 1));
+
+				/* copy content into backing store */
+				_size = src_len;
+				Genode::memcpy(_ds->local_addr<char>(), src, _size);
+
+				/* append zero termination */
+				_ds->local_addr<char>()[src_len] = 0;
+			}
 
 			/* notify ROM clients that access the module */
 			for (Reader *r = _readers.first(); r; r = r->next()) {
 
-				if (_read_policy.read_permitted(*this, *_last_writer, *r))
+				if (_last_writer && _read_policy.read_permitted(*this, *_last_writer, *r))
 					r->mark_as_outdated();
 				else
 					r->mark_as_invalidated();
@@ -305,7 +456,8 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		 */
 		size_t read_content(Reader const &reader, char *dst, size_t dst_len) const override
 		{
-			if (!_ds.constructed() || !_last_writer)
+			char const * const content = _content();
+			if (!content || !_last_writer)
 				return 0;
 
 			if (!_read_policy.read_permitted(*this, *_last_writer, reader))
@@ -314,10 +466,24 @@ struct Rom::Module : private Module_list::Element, Readable_module
 			if (dst_len < _size)
 				throw Buffer_too_small();
 
-			Genode::memcpy(dst, _ds->local_addr<char>(), _size);
+			Genode::memcpy(dst, content, _size);
 			return _size;
 		}
 
+		/**
+		 * Readable_module interface
+		 */
+		Shared_content *acquire_shared_content(Reader const &reader) const override
+		{
+			if (!_shared || !_last_writer)
+				return nullptr;
+
+			if (!_read_policy.read_permitted(*this, *_last_writer, reader))
+				return nullptr;
+
+			return &_shared->acquire();
+		}
+
 		virtual size_t size() const override { return _size; }
 
 		Name name() const { return _name; }
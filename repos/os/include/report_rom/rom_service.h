@@ -53,6 +53,25 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		Constructible<Genode::Attached_ram_dataspace> _ds { };
 
+		/**
+		 * Content version shared with other readers, if provided by module
+		 */
+		Shared_content *_shared = nullptr;
+
+		void _release_shared()
+		{
+			if (_shared)
+				Shared_content::release(*_shared);
+
+			_shared = nullptr;
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Session_component(Session_component const &);
+		Session_component &operator = (Session_component const &);
+
 		/**
 		 * Size of content delivered to the client
 		 *
@@ -90,6 +109,7 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		~Session_component()
 		{
+			_release_shared();
 			_registry.release(*this, _module);
 		}
 
@@ -99,6 +119,17 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 		{
 			using namespace Genode;
 
+			_release_shared();
+
+			/* hand out the sealed content version without copying */
+			_shared = _module.acquire_shared_content(*this);
+			if (_shared) {
+				_ds.destruct();
+				_content_size   = _shared->size();
+				_client_version = _current_version;
+				return _shared->dataspace();
+			}
+
 			/* replace dataspace by new one */
 			/* XXX we could keep the old dataspace if the size fits */
 			_ds.construct(_ram, _rm, _module.size());
@@ -117,6 +148,13 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		bool update() override
 		{
+			/*
+			 * A shared content version is immutable, so any new version
+			 * requires the client to request a new dataspace.
+			 */
+			if (_shared)
+				return _current_version == _client_version;
+
 			if (!_ds.constructed() || _module.size() > _ds->size())
 				return false;
 
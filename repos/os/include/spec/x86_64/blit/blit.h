@@ -30,7 +30,9 @@ namespace Blit {
 			_b2f<Slow>(surface, texture, rect, rotate, flip);
 	}
 
-	static inline void blend_xrgb_a(auto &&... args) { Sse4::Blend::xrgb_a(args...); }
+	static inline void blend_xrgb_a     (auto &&... args) { Sse4::Blend::xrgb_a(args...); }
+	static inline void blend_xrgb_avr   (auto &&... args) { Sse4::Blend::xrgb_avr(args...); }
+	static inline void blend_xrgb_masked(auto &&... args) { Sse4::Blend::xrgb_masked(args...); }
 }
 
 #endif /* _INCLUDE__SPEC__X86_64__BLIT_H_ */
@@ -163,6 +163,246 @@ class Genode::Vfs::Dir_file_system : public File_system
 		 */
 		bool _top_dir(char const *path) const {	return strcmp(path, "/") == 0; }
 
+		/**
+		 * Sub file systems that may provide a path
+		 */
+		struct Route
+		{
+			enum class Type { ALL, NONE, ONE };
+
+			Type         type;
+			File_system *owner;
+
+			static Route all() { return { Type::ALL, nullptr }; }
+		};
+
+		/**
+		 * Cache of routes for the top-level names of this directory
+		 *
+		 * Each lookup propagates a path into the sub file systems in order,
+		 * which becomes costly for stacked VFS layouts and for sub file
+		 * systems backed by another component. For recently used names of
+		 * the first path element, the cache remembers whether exactly one
+		 * or several sub file systems provide the name. Paths below a name
+		 * with a single owner are handed to the owner only. Names provided
+		 * by none of the sub file systems are not cached because they may
+		 * appear at any time.
+		 *
+		 * The cache is flushed whenever the top level of any sub file
+		 * system may have changed, i.e., on modifications via this
+		 * directory and on watch responses of the sub file systems.
+		 */
+		class Routing_cache : public Watch_response_handler
+		{
+			public:
+
+				enum { NUM_ENTRIES = 16 };
+
+			private:
+
+				struct Entry
+				{
+					Name          name;
+					Route         route;
+					unsigned long last_use;  /* 0 if unused */
+				};
+
+				Entry         _entries[NUM_ENTRIES] { };
+				unsigned long _use_count { 0 };
+
+			public:
+
+				Route lookup(Name const &name, auto const &classify_fn)
+				{
+					_use_count++;
+
+					Entry *victim = &_entries[0];
+					for (Entry &entry : _entries) {
+
+						if (entry.last_use && entry.name == name) {
+							entry.last_use = _use_count;
+							return entry.route;
+						}
+						if (entry.last_use < victim->last_use)
+							victim = &entry;
+					}
+
+					Route const route = classify_fn();
+					if (route.type != Route::Type::NONE)
+						*victim = { .name = name, .route = route, .last_use = _use_count };
+					return route;
+				}
+
+				void flush()
+				{
+					for (Entry &entry : _entries)
+						entry.last_use = 0;
+				}
+
+				/**
+				 * Watch_response_handler interface
+				 */
+				void watch_response() override { flush(); }
+		};
+
+		Routing_cache _routing_cache { };
+
+		/* enabled via the 'routing_cache' attribute, disabled by default */
+		bool _routing_cache_enabled;
+
+		enum class Routing_watch { NONE, INSTALLED, FAILED };
+
+		Routing_watch _routing_watch { Routing_watch::NONE };
+
+		/* watch handles of the top directories of the sub file systems */
+		Dir_watch_handle::Watch_handle_registry _routing_watch_handles { };
+
+		/**
+		 * Watch the top directories of the sub file systems
+		 *
+		 * Routes are cached only if changes of the top directories of all
+		 * sub file systems are reported. WATCH_ERR_STATIC is returned by
+		 * each file system that does not implement 'watch', which does not
+		 * prove that its top level is static.
+		 */
+		bool _routing_watched()
+		{
+			if (_routing_watch != Routing_watch::NONE)
+				return _routing_watch == Routing_watch::INSTALLED;
+
+			_routing_watch = Routing_watch::INSTALLED;
+
+			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+
+				/* the top level of a sub directory is its static name */
+				if (strcmp(fs->type(), "dir") == 0)
+					continue;
+
+				Vfs_watch_handle *handle = nullptr;
+				switch (fs->watch("/", &handle, _env.alloc())) {
+
+				case WATCH_OK:
+					try {
+						new (_env.alloc())
+							Dir_watch_handle::Watch_handle_element(
+								_routing_watch_handles, *handle);
+						handle->handler(&_routing_cache);
+						continue;
+					}
+					catch (...) { handle->close(); }
+					break;
+
+				case WATCH_ERR_STATIC:
+				case WATCH_ERR_UNACCESSIBLE:
+				case WATCH_ERR_OUT_OF_RAM:
+				case WATCH_ERR_OUT_OF_CAPS:
+					break;
+				}
+
+				_routing_watch = Routing_watch::FAILED;
+				break;
+			}
+			return _routing_watch == Routing_watch::INSTALLED;
+		}
+
+		void _close_routing_watch_handles()
+		{
+			_routing_watch_handles.for_each([&] (Dir_watch_handle::Watch_handle_element &e) {
+				e.watch_handle.close();
+				destroy(_env.alloc(), &e);
+			});
+			_routing_watch = Routing_watch::NONE;
+		}
+
+		/**
+		 * Return length of the first element of 'path', skipping the
+		 * leading slash
+		 */
+		static size_t _first_element_len(char const *path)
+		{
+			size_t len = 0;
+			for (; path[len] && path[len] != '/'; len++);
+			return len;
+		}
+
+		/**
+		 * Return true if 'path' is a top-level path of this directory
+		 */
+		static bool _top_level(char const *path)
+		{
+			if (path[0] == '/')
+				path++;
+
+			return path[_first_element_len(path)] == 0;
+		}
+
+		/**
+		 * Return sub file systems that may provide the sub path 'path'
+		 */
+		Route _route(char const *path)
+		{
+			if (!_routing_cache_enabled || !_first_file_system)
+				return Route::all();
+
+			if (path[0] == '/')
+				path++;
+
+			size_t const len = _first_element_len(path);
+			if (len == 0 || len >= MAX_NAME_LEN)
+				return Route::all();
+
+			if (!_routing_watched())
+				return Route::all();
+
+			Name const name { Cstring(path, len) };
+
+			return _routing_cache.lookup(name, [&] {
+
+				String<MAX_NAME_LEN + 1> const top_path { "/", name };
+
+				unsigned     count = 0;
+				File_system *owner = nullptr;
+
+				for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+					Stat stat { };
+					if (fs->stat(top_path.string(), stat) != STAT_ERR_NO_ENTRY) {
+						count++;
+						owner = fs;
+					}
+				}
+
+				switch (count) {
+				case 0:  return Route { Route::Type::NONE, nullptr };
+				case 1:  return Route { Route::Type::ONE,  owner   };
+				default: return Route::all();
+				}
+			});
+		}
+
+		File_system *_first(Route const &route)
+		{
+			switch (route.type) {
+			case Route::Type::ALL:  return _first_file_system;
+			case Route::Type::NONE: return nullptr;
+			case Route::Type::ONE:  return route.owner;
+			}
+			return nullptr;
+		}
+
+		static File_system *_next(Route const &route, File_system *fs)
+		{
+			return route.type == Route::Type::ALL ? fs->next : nullptr;
+		}
+
+		/**
+		 * Flush cached routes after a modification of the path 'path'
+		 */
+		void _modified(char const *path)
+		{
+			if (path && _top_level(path))
+				_routing_cache.flush();
+		}
+
 		/**
 		 * Perform operation on a file system
 		 *
@@ -365,7 +605,8 @@ class Genode::Vfs::Dir_file_system : public File_system
 		:
 			_env(env),
 			_vfs_root(!node.has_type("dir")),
-			_name(_vfs_root ? Name() : node.attribute_value("name", Name()))
+			_name(_vfs_root ? Name() : node.attribute_value("name", Name())),
+			_routing_cache_enabled(node.attribute_value("routing_cache", false))
 		{
 			using namespace Genode;
 
@@ -388,6 +629,8 @@ class Genode::Vfs::Dir_file_system : public File_system
 			});
 		}
 
+		~Dir_file_system() { _close_routing_watch_handles(); }
+
 		/*********************************
 		 ** Directory-service interface **
 		 *********************************/
@@ -402,8 +645,8 @@ class Genode::Vfs::Dir_file_system : public File_system
 			 * Query sub file systems for dataspace using the path local to
 			 * the respective file system
 			 */
-			File_system *fs = _first_file_system;
-			for (; fs; fs = fs->next) {
+			Route const route = _route(path);
+			for (File_system *fs = _first(route); fs; fs = _next(route, fs)) {
 				Dataspace_capability ds = fs->dataspace(path);
 				if (ds.valid())
 					return ds;
@@ -450,7 +693,8 @@ class Genode::Vfs::Dir_file_system : public File_system
 			 * The given path refers to one of our sub directories.
 			 * Propagate the request into our file systems.
 			 */
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			Route const route = _route(path);
+			for (File_system *fs = _first(route); fs; fs = _next(route, fs)) {
 
 				Stat_result const err = fs->stat(path, out);
 
@@ -507,7 +751,8 @@ class Genode::Vfs::Dir_file_system : public File_system
 			if (strlen(path) == 0)
 				return true;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next)
+			Route const route = _route(path);
+			for (File_system *fs = _first(route); fs; fs = _next(route, fs))
 				if (fs->directory(path))
 					return true;
 
@@ -523,7 +768,8 @@ class Genode::Vfs::Dir_file_system : public File_system
 			if (strlen(path) == 0)
 				return path;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			Route const route = _route(path);
+			for (File_system *fs = _first(route); fs; fs = _next(route, fs)) {
 				char const *leaf_path = fs->leaf_path(path);
 				if (leaf_path)
 					return leaf_path;
@@ -573,13 +819,22 @@ class Genode::Vfs::Dir_file_system : public File_system
 				catch (Out_of_caps) { return OPEN_ERR_OUT_OF_CAPS; }
 			}
 
-			/* path refers to any of our sub file systems */
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			/*
+			 * Path refers to any of our sub file systems. A file may be
+			 * created by any of them.
+			 */
+			bool  const create = (mode & OPEN_MODE_CREATE);
+			Route const route  = create ? Route::all() : _route(path);
+			for (File_system *fs = _first(route); fs; fs = _next(route, fs)) {
 
 				Open_result const err = fs->open(path, mode, out_handle, alloc);
 				switch (err) {
 				case OPEN_ERR_UNACCESSIBLE:
 					continue;
+				case OPEN_OK:
+					if (create)
+						_modified(path);
+					return err;
 				default:
 					return err;
 				}
@@ -622,7 +877,8 @@ class Genode::Vfs::Dir_file_system : public File_system
 				res = OPENDIR_OK;
 			}
 			try {
-				for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+				Route const route = _route(sub_path);
+				for (File_system *fs = _first(route); fs; fs = _next(route, fs)) {
 					Vfs_handle *sub_dir_handle = nullptr;
 
 					Opendir_result r = fs->opendir(
@@ -720,6 +976,8 @@ class Genode::Vfs::Dir_file_system : public File_system
 
 				if (opendir_result != OPENDIR_OK)
 					return opendir_result;
+
+				_modified(sub_path);
 			}
 
 			Dir_vfs_handle *dir_vfs_handle;
@@ -753,10 +1011,16 @@ class Genode::Vfs::Dir_file_system : public File_system
 				return fs.openlink(path, create, out_handle, alloc);
 			};
 
-			return _dir_op(OPENLINK_ERR_LOOKUP_FAILED,
-			               OPENLINK_ERR_PERMISSION_DENIED,
-			               OPENLINK_OK,
-			               path, openlink_fn);
+			Openlink_result const result =
+				_dir_op(OPENLINK_ERR_LOOKUP_FAILED,
+				        OPENLINK_ERR_PERMISSION_DENIED,
+				        OPENLINK_OK,
+				        path, openlink_fn);
+
+			if (create && result == OPENLINK_OK)
+				_modified(_sub_path(path));
+
+			return result;
 		}
 
 		void close(Vfs_handle *handle) override
@@ -809,8 +1073,14 @@ class Genode::Vfs::Dir_file_system : public File_system
 				return fs.unlink(path);
 			};
 
-			return _dir_op(UNLINK_ERR_NO_ENTRY, UNLINK_ERR_NO_PERM, UNLINK_OK,
-			               path, unlink_fn);
+			Unlink_result const result =
+				_dir_op(UNLINK_ERR_NO_ENTRY, UNLINK_ERR_NO_PERM, UNLINK_OK,
+				        path, unlink_fn);
+
+			if (result == UNLINK_OK)
+				_modified(_sub_path(path));
+
+			return result;
 		}
 
 		Rename_result rename(char const *from_path, char const *to_path) override
@@ -838,7 +1108,10 @@ class Genode::Vfs::Dir_file_system : public File_system
 			Rename_result final = RENAME_ERR_NO_ENTRY;
 			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
 				switch (fs->rename(from_path, to_path)) {
-				case RENAME_OK:           return RENAME_OK;
+				case RENAME_OK:
+					_modified(from_path);
+					_modified(to_path);
+					return RENAME_OK;
 				case RENAME_ERR_NO_ENTRY: continue;
 				case RENAME_ERR_NO_PERM:  return RENAME_ERR_NO_PERM;
 				case RENAME_ERR_CROSS_FS: final = RENAME_ERR_CROSS_FS;
@@ -858,6 +1131,10 @@ class Genode::Vfs::Dir_file_system : public File_system
 		{
 			using namespace Genode;
 
+			_routing_cache_enabled = node.attribute_value("routing_cache", false);
+			_routing_cache.flush();
+			_close_routing_watch_handles();
+
 			File_system *curr = _first_file_system;
 			node.for_each_sub_node([&] (Node const &sub_node) {
 
@@ -0,0 +1,2 @@
+SRC_DIR = src/server/block_cache
+include $(GENODE_DIR)/repos/base/recipes/src/content.inc
@@ -57,6 +57,30 @@ struct genode_nic_client : private Noncopyable, private Interface
 		                              BUF_SIZE, BUF_SIZE,
 		                              _session_label.string() };
 
+		/*
+		 * Released packets not yet acknowledged, either because the ack
+		 * queue is congested or because the packet was released while being
+		 * processed by 'for_each_rx_packet'
+		 */
+		Nic::Packet_descriptor _pending_acks[Nic::Session::QUEUE_SIZE] { };
+		unsigned               _num_pending_acks = 0;
+
+		bool _rx_in_progress = false;
+
+		void _flush_pending_acks()
+		{
+			if (!_num_pending_acks)
+				return;
+
+			unsigned const n =
+				_connection.rx()->try_ack_packets(_pending_acks, _num_pending_acks);
+
+			for (unsigned i = n; i < _num_pending_acks; i++)
+				_pending_acks[i - n] = _pending_acks[i];
+
+			_num_pending_acks -= n;
+		}
+
 	public:
 
 		genode_nic_client(Env &env, Allocator &alloc,
@@ -137,11 +161,16 @@ struct genode_nic_client : private Noncopyable, private Interface
 
 			Nic::Session::Rx::Sink &rx_sink = *_connection.rx();
 
+			_flush_pending_acks();
+
 			for (;;) {
 
 				if (!rx_sink.packet_avail() || !rx_sink.ack_slots_free())
 					break;
 
+				if (_num_pending_acks)
+					break;
+
 				using Packet_descriptor = Nic::Packet_descriptor;
 
 				Packet_descriptor const packet = rx_sink.peek_packet();
@@ -149,13 +178,17 @@ struct genode_nic_client : private Noncopyable, private Interface
 				bool const packet_valid = rx_sink.packet_valid(packet)
 				                       && (packet.offset() >= 0);
 
-				char const *content = rx_sink.packet_content(packet);
+				char *content = rx_sink.packet_content(packet);
+
+				_rx_in_progress = true;
 
 				genode_nic_client_rx_result_t const
 					response = packet_valid
-					         ? fn(content, packet.size())
+					         ? fn(content, packet)
 					         : GENODE_NIC_CLIENT_RX_REJECTED;
 
+				_rx_in_progress = false;
+
 				bool progress = false;
 
 				switch (response) {
@@ -168,6 +201,13 @@ struct genode_nic_client : private Noncopyable, private Interface
 					progress = true;
 					break;
 
+				case GENODE_NIC_CLIENT_RX_RETAINED:
+
+					(void)rx_sink.try_get_packet();
+					_flush_pending_acks();
+					progress = true;
+					break;
+
 				case GENODE_NIC_CLIENT_RX_RETRY:
 					Genode::warning("RETRY");
 					break;
@@ -182,6 +222,18 @@ struct genode_nic_client : private Noncopyable, private Interface
 			return overall_progress;
 		}
 
+		void release_rx_packet(Nic::Packet_descriptor const &packet)
+		{
+			if (_num_pending_acks == Nic::Session::QUEUE_SIZE) {
+				error("nic_client: unable to acknowledge released packet");
+				return;
+			}
+			_pending_acks[_num_pending_acks++] = packet;
+
+			if (!_rx_in_progress)
+				_flush_pending_acks();
+		}
+
 		Nic::Mac_address mac_address() { return _connection.mac_address(); }
 
 		bool link_state() { return _connection.link_state(); }
@@ -237,8 +289,28 @@ bool genode_nic_client_rx(struct genode_nic_client *nic_client_ptr,
                           genode_nic_client_rx_one_packet_t rx_one_packet_cb,
                           struct genode_nic_client_rx_context *ctx_ptr)
 {
-	return nic_client_ptr->for_each_rx_packet([&] (char const *ptr, size_t len) {
-		return rx_one_packet_cb(ctx_ptr, ptr, len); });
+	return nic_client_ptr->for_each_rx_packet([&] (char const *ptr,
+	                                               Nic::Packet_descriptor const &packet) {
+		return rx_one_packet_cb(ctx_ptr, ptr, packet.size()); });
+}
+
+
+bool genode_nic_client_rx_retainable(struct genode_nic_client *nic_client_ptr,
+                                     genode_nic_client_rx_one_packet_retainable_t rx_one_packet_cb,
+                                     struct genode_nic_client_rx_context *ctx_ptr)
+{
+	return nic_client_ptr->for_each_rx_packet([&] (char *ptr,
+	                                               Nic::Packet_descriptor const &packet) {
+		genode_nic_client_rx_packet const rx_packet { .offset = packet.offset(),
+		                                              .size   = packet.size() };
+		return rx_one_packet_cb(ctx_ptr, ptr, packet.size(), rx_packet); });
+}
+
+
+void genode_nic_client_rx_release(struct genode_nic_client *nic_client_ptr,
+                                  struct genode_nic_client_rx_packet packet)
+{
+	nic_client_ptr->release_rx_packet(Nic::Packet_descriptor(packet.offset, packet.size));
 }
 
 
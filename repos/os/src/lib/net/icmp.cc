@@ -37,3 +37,26 @@ bool Icmp_packet::checksum_error(size_t data_sz) const
 {
 	return internet_checksum((Packed_uint16 *)this, sizeof(Icmp_packet) + data_sz);
 }
+
+
+void Icmp_packet::update_checksum(Internet_checksum_diff const &icd)
+{
+	_checksum = icd.apply_to(_checksum);
+}
+
+
+void Icmp_packet::type_and_code(Type t, Code c, Internet_checksum_diff &icd)
+{
+	uint8_t const new_type_and_code[2] { (uint8_t)t, (uint8_t)c };
+	icd.add_up_diff((Packed_uint16 *)new_type_and_code, (Packed_uint16 *)&_type, 2);
+	_type = (uint8_t)t;
+	_code = (uint8_t)c;
+}
+
+
+void Icmp_packet::query_id(uint16_t v, Internet_checksum_diff &icd)
+{
+	uint16_t const new_id = host_to_big_endian(v);
+	icd.add_up_diff((Packed_uint16 *)&new_id, (Packed_uint16 *)&_rest_of_header_u16[0], 2);
+	_rest_of_header_u16[0] = new_id;
+}
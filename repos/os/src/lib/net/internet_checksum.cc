@@ -29,6 +29,13 @@ struct Packed_uint8
 } __attribute__((packed));
 
 
+struct Packed_uint32
+{
+	Genode::uint32_t value;
+
+} __attribute__((packed));
+
+
 static void fold_checksum_to_16_bits(signed long &sum)
 {
 	while (addr_t const remainder = sum >> 16) {
@@ -37,19 +44,107 @@ static void fold_checksum_to_16_bits(signed long &sum)
 }
 
 
+/*
+ * As 2^16 equals 1 modulo 2^16 - 1, the one's complement sum of 16-bit
+ * words can be computed by adding up wider words and folding the result
+ * to 16 bits afterwards. We add up 32-bit words into 64-bit accumulators,
+ * which cannot overflow for any packet size. Independent from the byte
+ * order, this yields the same result as adding up 16-bit words.
+ */
+static uint64_t fold_to_32_bits(uint64_t sum)
+{
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	return (sum & 0xffffffff) + (sum >> 32);
+}
+
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+
+/*
+ * Each 64-bit lane is split into its two 32-bit words, which are added up
+ * in separate accumulators. The compiler translates the vector operations
+ * to SSE2 or NEON instructions.
+ */
+typedef Genode::uint64_t Vector __attribute__((vector_size(16)));
+
+struct Packed_vector
+{
+	Vector value;
+
+} __attribute__((packed));
+
+
+static uint64_t sum_of_vectors(Packed_vector const *&data_ptr, size_t &data_sz)
+{
+	enum { SZ = sizeof(Vector) };
+
+	Vector const low_mask = { 0xffffffff, 0xffffffff };
+	Vector sum_a = { 0, 0 }, sum_b = { 0, 0 };
+
+	for (; data_sz >= 4*SZ; data_sz -= 4*SZ, data_ptr += 4) {
+		Vector const v0 = data_ptr[0].value, v1 = data_ptr[1].value;
+		Vector const v2 = data_ptr[2].value, v3 = data_ptr[3].value;
+		sum_a += (v0 & low_mask) + (v1 & low_mask);
+		sum_b += (v0 >> 32)      + (v1 >> 32);
+		sum_a += (v2 & low_mask) + (v3 & low_mask);
+		sum_b += (v2 >> 32)      + (v3 >> 32);
+	}
+	for (; data_sz >= SZ; data_sz -= SZ, data_ptr++) {
+		Vector const v = data_ptr->value;
+		sum_a += v & low_mask;
+		sum_b += v >> 32;
+	}
+	Vector const sum = sum_a + sum_b;
+	return fold_to_32_bits(sum[0]) + fold_to_32_bits(sum[1]);
+}
+
+#endif /* __SSE2__ || __ARM_NEON */
+
+
 static uint16_t checksum_of_raw_data(Packed_uint16 const *data_ptr,
                                      size_t               data_sz,
                                      signed long          sum)
 {
-	/* add up bytes in pairs */
-	for (; data_sz > 1; data_sz -= sizeof(Packed_uint16)) {
-		sum += data_ptr->value;
+	uint64_t wide_sum = 0;
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+	{
+		/* add up blocks of 16 bytes */
+		Packed_vector const *vector_ptr = (Packed_vector const *)data_ptr;
+		wide_sum += sum_of_vectors(vector_ptr, data_sz);
+		data_ptr = (Packed_uint16 const *)vector_ptr;
+	}
+#endif
+
+	/* add up bytes in quadruples */
+	{
+		Packed_uint32 const *word_ptr = (Packed_uint32 const *)data_ptr;
+		uint64_t sum_a = 0, sum_b = 0;
+		for (; data_sz >= 2*sizeof(Packed_uint32); data_sz -= 2*sizeof(Packed_uint32)) {
+			sum_a += word_ptr[0].value;
+			sum_b += word_ptr[1].value;
+			word_ptr += 2;
+		}
+		if (data_sz >= sizeof(Packed_uint32)) {
+			sum_a += word_ptr->value;
+			data_sz -= sizeof(Packed_uint32);
+			word_ptr++;
+		}
+		wide_sum += fold_to_32_bits(sum_a) + fold_to_32_bits(sum_b);
+		data_ptr = (Packed_uint16 const *)word_ptr;
+	}
+	/* add left-over pair of bytes, if any */
+	if (data_sz > 1) {
+		wide_sum += data_ptr->value;
 		data_ptr++;
+		data_sz -= sizeof(Packed_uint16);
 	}
 	/* add left-over byte, if any */
 	if (data_sz > 0) {
-		sum += ((Packed_uint8 const *)data_ptr)->value;
+		wide_sum += ((Packed_uint8 const *)data_ptr)->value;
 	}
+	wide_sum = fold_to_32_bits(wide_sum);
+	sum += (signed long)((wide_sum & 0xffff) + (wide_sum >> 16));
 	fold_checksum_to_16_bits(sum);
 
 	/* return one's complement */
@@ -115,9 +210,29 @@ void Internet_checksum_diff::add_up_diff(Packed_uint16 const *new_data_ptr,
 }
 
 
-uint16_t Internet_checksum_diff::apply_to(signed long sum) const
+void Internet_checksum_diff::add_up_diff(Internet_checksum_diff const &icd)
 {
-	sum += _value;
-	fold_checksum_to_16_bits(sum);
-	return (uint16_t)sum;
+	_value += icd._value;
+}
+
+
+uint16_t Internet_checksum_diff::apply_to(signed long checksum) const
+{
+	/*
+	 * Update the checksum according to equation 3 of RFC 1624:
+	 *
+	 *   HC' = ~(~HC + ~m + m')
+	 *
+	 * Adding '~m' equals subtracting 'm' modulo 2^16 - 1. So, we subtract
+	 * the accumulated differences from the sum that is covered by the
+	 * checksum. In one's complement arithmetic, a sum of a non-zero value
+	 * and any other value is never zero. Hence, like in RFC 1624, the
+	 * updated sum is in the range from 1 to 0xffff.
+	 */
+	signed long sum = (signed long)(uint16_t)~checksum - _value;
+	sum %= 0xffff;
+	if (sum <= 0)
+		sum += 0xffff;
+
+	return (uint16_t)~sum;
 }
@@ -213,7 +213,7 @@ Genode::Vfs::Global_file_system_factory::Global_file_system_factory(Genode::Allo
 :
 	_md_alloc(alloc)
 {
-	_add_builtin_fs<Vfs_tar     ::File_system>();
+	_add_builtin_fs<Vfs_tar     ::Rom_file_system>();
 	_add_builtin_fs<Vfs_fs      ::File_system>();
 	_add_builtin_fs<Vfs_terminal::File_system>();
 	_add_builtin_fs<Vfs_null    ::File_system>();
@@ -25,7 +25,11 @@ namespace Vfs_tar {
 	using namespace Genode::Vfs;
 
 	class Record;
+	class Entry;
+	struct Archive;
+	class Rom_archive;
 	class File_system;
+	class Rom_file_system;
 }
 
 
@@ -120,7 +124,7 @@ class Vfs_tar::Record
 		unsigned    max_name_len() const { return _long_name() ? MAX_PATH_LEN : 100;           }
 		char const *linked_name()  const { return _long_name() ? _data_begin() : _linked_name; }
 
-		file_size storage_size()
+		file_size storage_size() const
 		{
 			if (_long_name()) {
 				/* this size + next header + next size */
@@ -129,21 +133,130 @@ class Vfs_tar::Record
 
 			return _read(_size);
 		}
+
+		/**
+		 * Number of bytes preceding the data of the record
+		 *
+		 * For GNU long names, the header is followed by the name and
+		 * another header. Only the first 'BLOCK_LEN' bytes must be
+		 * accessible when calling this method.
+		 */
+		file_size header_size() const
+		{
+			file_size const block_len = BLOCK_LEN;
+
+			return _long_name() ? block_len + _block_align(_read(_size)) + block_len
+			                    : block_len;
+		}
+};
+
+
+/**
+ * Meta data of a tar record
+ *
+ * The meta data is kept for each record of the archive, which allows for
+ * accessing the archive content solely via the 'Archive' interface.
+ */
+class Vfs_tar::Entry
+{
+	private:
+
+		file_size   const _size;
+		file_size   const _data_offset;
+		long long   const _mtime;
+		unsigned    const _type;
+		Node_rwx    const _rwx;
+		char const *const _linked_name;
+
+		/*
+		 * Noncopyable
+		 */
+		Entry(Entry const &);
+		Entry &operator = (Entry const &);
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param data_offset  offset of the record data within the archive
+		 * \param linked_name  name of link target, must stay valid during
+		 *                     the lifetime of the entry
+		 */
+		Entry(Record const &record, file_size data_offset, char const *linked_name)
+		:
+			_size(record.size()), _data_offset(data_offset),
+			_mtime(record.mtime()), _type(record.type()), _rwx(record.rwx()),
+			_linked_name(linked_name)
+		{ }
+
+		file_size          size() const { return _size; }
+		file_size   data_offset() const { return _data_offset; }
+		long long         mtime() const { return _mtime; }
+		unsigned           type() const { return _type; }
+		Node_rwx            rwx() const { return _rwx; }
+		char const *linked_name() const { return _linked_name ? _linked_name : ""; }
 };
 
 
+/**
+ * Content of a tar archive
+ */
+struct Vfs_tar::Archive : Interface
+{
+	virtual file_size size() const = 0;
+
+	/**
+	 * Copy archive content starting at 'offset' to 'dst'
+	 *
+	 * \return number of bytes copied, which is less than the size of
+	 *         'dst' only at the end of the archive or on error
+	 */
+	virtual size_t read(file_size offset, Byte_range_ptr const &dst) = 0;
+};
+
+
+/**
+ * Uncompressed tar archive provided as ROM module
+ */
+class Vfs_tar::Rom_archive : public Archive
+{
+	private:
+
+		Attached_rom_dataspace _rom;
+
+	public:
+
+		Rom_archive(Genode::Env &env, char const *rom_name)
+		: _rom(env, rom_name) { }
+
+		file_size size() const override { return _rom.size(); }
+
+		size_t read(file_size offset, Byte_range_ptr const &dst) override
+		{
+			if (offset >= _rom.size())
+				return 0;
+
+			size_t const count = min(dst.num_bytes, size_t(_rom.size() - offset));
+
+			memcpy(dst.start, _rom.local_addr<char const>() + offset, count);
+			return count;
+		}
+};
+
+
+/**
+ * Read-only file system backed by a tar archive
+ */
 class Vfs_tar::File_system : public Vfs::File_system
 {
 	Genode::Env &_env;
 	Allocator   &_alloc;
+	Archive     &_archive;
 
 	using Rom_name = String<64>;
 	Rom_name _rom_name;
 
-	Attached_rom_dataspace _tar_ds { _env, _rom_name.string() };
-	char                  *_tar_base = _tar_ds.local_addr<char>();
-	file_size       const  _tar_size = _tar_ds.size();
-
 	/*
 	 * Noncopyable
 	 */
@@ -183,19 +296,21 @@ class Vfs_tar::File_system : public Vfs::File_system
 
 		Read_result read(Byte_range_ptr const &dst, size_t &out_count) override
 		{
-			file_size const record_size = _node->record->size();
+			Entry const &record = *_node->record;
+
+			file_size const record_size = record.size();
 
 			file_size const record_bytes_left = record_size >= seek()
 			                                  ? record_size  - seek() : 0;
 
 			size_t const count = min(size_t(record_bytes_left), dst.num_bytes);
 
-			char const *data = (char *)_node->record->data() + seek();
+			File_system &tar_fs = static_cast<File_system&>(fs());
 
-			memcpy(dst.start, data, count);
+			out_count = tar_fs._archive.read(record.data_offset() + seek(),
+			                                 Byte_range_ptr(dst.start, count));
 
-			out_count = count;
-			return READ_OK;
+			return (out_count == count) ? READ_OK : READ_ERR_IO;
 		}
 	};
 
@@ -203,6 +318,21 @@ class Vfs_tar::File_system : public Vfs::File_system
 	{
 		using Tar_vfs_handle::Tar_vfs_handle;
 
+		/* most recently read child, which speeds up sequential reads */
+		Node const *_last_child       { nullptr };
+		unsigned    _last_child_index { 0 };
+
+		Node const *_child(unsigned index)
+		{
+			if (_last_child && index == _last_child_index + 1)
+				_last_child = _last_child->next();
+			else if (!_last_child || index != _last_child_index)
+				_last_child = _node->lookup_child(index);
+
+			_last_child_index = index;
+			return _last_child;
+		}
+
 		Read_result read(Byte_range_ptr const &dst, size_t &out_count) override
 		{
 			if (dst.num_bytes < sizeof(Dirent))
@@ -212,7 +342,7 @@ class Vfs_tar::File_system : public Vfs::File_system
 
 			unsigned const index = (unsigned)(seek() / sizeof(Dirent));
 
-			Node const *node_ptr = _node->lookup_child(index);
+			Node const *node_ptr = _child(index);
 
 			if (!node_ptr) {
 				dirent = Dirent { };
@@ -222,7 +352,7 @@ class Vfs_tar::File_system : public Vfs::File_system
 
 			Node const &node = *node_ptr;
 
-			Record const *record_ptr = node.record;
+			Entry const *record_ptr = node.record;
 
 			while (record_ptr && (record_ptr->type() == Record::TYPE_HARDLINK)) {
 				File_system &tar_fs = static_cast<File_system&>(fs());
@@ -244,7 +374,7 @@ class Vfs_tar::File_system : public Vfs::File_system
 				return READ_OK;
 			}
 
-			Record const &record = *record_ptr;
+			Entry const &record = *record_ptr;
 
 			auto node_type = [&] ()
 			{
@@ -278,11 +408,11 @@ class Vfs_tar::File_system : public Vfs::File_system
 
 		Read_result read(Byte_range_ptr const &dst, size_t &out_count) override
 		{
-			Record const *record = _node->record;
+			char const *linked_name = _node->record->linked_name();
 
-			size_t const count = min(dst.num_bytes, 100UL);
+			size_t const count = min(dst.num_bytes, strlen(linked_name));
 
-			memcpy(dst.start, record->linked_name(), count);
+			memcpy(dst.start, linked_name, count);
 
 			out_count = count;
 
@@ -296,49 +426,19 @@ class Vfs_tar::File_system : public Vfs::File_system
 
 	struct Node : List<Node>, List<Node>::Element
 	{
-		char const *name;
-		Record const *record;
+		char  const *name;
+		Node  const *parent;
+		Entry const *record;
 
-		Node(char const *name, Record const *record) : name(name), record(record) { }
+		/* hash of parent and name, assigned by the 'Path_index' */
+		uint32_t hash { 0 };
 
-		Node *lookup(char const *name)
-		{
-			Absolute_path lookup_path(name);
-
-			Node *parent_node = this;
-			Node *child_node;
-
-			Path_element_token t(lookup_path.base());
-
-			while (t) {
-
-				if (t.type() != Path_element_token::IDENT) {
-						t = t.next();
-						continue;
-				}
+		file_size num_dirent { 0 };
 
-				char path_element[MAX_PATH_LEN];
+		Node(char const *name, Node const *parent, Entry const *record)
+		: name(name), parent(parent), record(record) { }
 
-				t.string(path_element, sizeof(path_element));
-
-				for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-					if (strcmp(child_node->name, path_element) == 0) {
-						parent_node = child_node;
-						break;
-					}
-				}
-
-				if (!child_node)
-					return 0;
-
-				t = t.next();
-			}
-
-			return parent_node;
-		}
-
-
-		Node const *lookup_child(int index) const
+		Node const *lookup_child(unsigned index) const
 		{
 			for (Node const *child_node = first(); child_node; child_node = child_node->next(), index--) {
 				if (index == 0)
@@ -348,177 +448,300 @@ class Vfs_tar::File_system : public Vfs::File_system
 			return 0;
 		}
 
+		private:
 
-		file_size num_dirent()
-		{
-			file_size count = 0;
-			for (Node *child_node = first(); child_node; child_node = child_node->next(), count++) ;
-			return count;
-		}
+			/*
+			 * Noncopyable
+			 */
+			Node(Node const &);
+			Node &operator = (Node const &);
 
-	} _root_node;
+	} _root_node { "", nullptr, nullptr };
 
 
-	/*
-	 *  Create a Node for a tar record and insert it into the node list
+	/**
+	 * Hash table of all nodes keyed by their parent node and name
+	 *
+	 * The index is populated when scanning the archive. It allows for
+	 * resolving each element of a path by a single probe instead of
+	 * walking the child list of the parent node. The table uses open
+	 * addressing with linear probing.
 	 */
-	class Add_node_action
+	class Path_index
 	{
 		private:
 
+			enum : size_t { MIN_CAPACITY = 64 };
+
 			Allocator &_alloc;
+			Node     **_slots    { nullptr };
+			size_t     _capacity { 0 };
+			size_t     _count    { 0 };
 
-			Node &_root_node;
+			size_t _index(uint32_t hash) const { return hash & (_capacity - 1); }
+			size_t _next(size_t i)       const { return (i + 1) & (_capacity - 1); }
 
-		public:
+			void _insert_slot(Node &node)
+			{
+				size_t i = _index(node.hash);
+				while (_slots[i])
+					i = _next(i);
 
-			Add_node_action(Allocator &alloc, Node &root_node)
-			: _alloc(alloc), _root_node(root_node) { }
+				_slots[i] = &node;
+				_count++;
+			}
 
-			void operator()(Record const *record)
+			void _grow()
 			{
-				Absolute_path current_path;
+				Node  **const old_slots    = _slots;
+				size_t  const old_capacity = _capacity;
 
-				char path_element[MAX_PATH_LEN];
+				_capacity = old_capacity ? old_capacity*2 : (size_t)MIN_CAPACITY;
+				_slots    = (Node **)_alloc.alloc(_capacity*sizeof(Node *));
+				_count    = 0;
 
-				if (record->max_name_len() > 100 || record->name()[99] == 0)
-					current_path.import(record->name());
+				for (size_t i = 0; i < _capacity; i++)
+					_slots[i] = nullptr;
 
-				/*
-				 * GNU tar does not null terminate names of length 100
-				 */
-				else {
-					copy_cstring(path_element, record->name(), 101);
-					current_path.import(path_element);
-				}
+				for (size_t i = 0; i < old_capacity; i++)
+					if (old_slots[i])
+						_insert_slot(*old_slots[i]);
+
+				if (old_slots)
+					_alloc.free(old_slots, old_capacity*sizeof(Node *));
+			}
+
+			/*
+			 * Noncopyable
+			 */
+			Path_index(Path_index const &);
+			Path_index &operator = (Path_index const &);
 
-				Path_element_token t(current_path.base());
+		public:
 
-				Node *parent_node = &_root_node;
-				Node *child_node;
+			Path_index(Allocator &alloc) : _alloc(alloc) { }
 
-				while(t) {
+			~Path_index()
+			{
+				if (_slots)
+					_alloc.free(_slots, _capacity*sizeof(Node *));
+			}
 
-					if (t.type() != Path_element_token::IDENT) {
-							t = t.next();
-							continue;
-					}
+			/**
+			 * FNV-1a hash of the parent-node address and the name
+			 */
+			static uint32_t hash(Node const &parent, char const *name, size_t len)
+			{
+				uint32_t h = 2166136261u;
+				auto mix = [&] (uint8_t byte) { h = (h ^ byte)*16777619u; };
 
-					Absolute_path remaining_path(t.start());
+				addr_t const parent_addr = (addr_t)&parent;
+				for (unsigned i = 0; i < sizeof(parent_addr); i++)
+					mix(uint8_t(parent_addr >> (8*i)));
 
-					t.string(path_element, sizeof(path_element));
+				for (size_t i = 0; i < len; i++)
+					mix(uint8_t(name[i]));
 
-					for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-						if (strcmp(child_node->name, path_element) == 0)
-							break;
-					}
+				return h;
+			}
 
-					if (child_node) {
+			void insert(Node &node)
+			{
+				node.hash = hash(*node.parent, node.name, strlen(node.name));
 
-						if (remaining_path.has_single_element()) {
-							/* Found a node for the record to be inserted.
-							 * This is usually a directory node without
-							 * record. */
-							child_node->record = record;
-						}
-					} else {
-						if (remaining_path.has_single_element()) {
-
-							/*
-							 * TODO: find 'path_element' in 'record->name'
-							 * and use the location in the record as name
-							 * pointer to save some memory
-							 */
-							size_t name_size = strlen(path_element) + 1;
-							char *name = (char*)_alloc.alloc(name_size);
-							copy_cstring(name, path_element, name_size);
-							child_node = new (_alloc) Node(name, record);
-						} else {
-
-							/* create a directory node without record */
-							size_t name_size = strlen(path_element) + 1;
-							char *name = (char*)_alloc.alloc(name_size);
-							copy_cstring(name, path_element, name_size);
-							child_node = new (_alloc) Node(name, 0);
-						}
-						parent_node->insert(child_node);
-					}
+				/* keep the load factor at or below 1/2 */
+				if ((_count + 1)*2 > _capacity)
+					_grow();
 
-					parent_node = child_node;
-					t = t.next();
+				_insert_slot(node);
+			}
+
+			/**
+			 * Return child of 'parent' named by the first 'len' characters
+			 * of 'name'
+			 */
+			Node *lookup(Node const &parent, char const *name, size_t len) const
+			{
+				if (!_capacity)
+					return nullptr;
+
+				uint32_t const h = hash(parent, name, len);
+
+				for (size_t i = _index(h); _slots[i]; i = _next(i)) {
+					Node &node = *_slots[i];
+					if (node.hash == h && node.parent == &parent
+					 && strcmp(node.name, name, len) == 0 && node.name[len] == 0)
+						return &node;
 				}
+				return nullptr;
 			}
-	};
+	} _path_index { _alloc };
 
 
-	template <typename Tar_record_action>
-	void _for_each_tar_record_do(Tar_record_action tar_record_action)
+	Node *_lookup(char const *path)
 	{
-		/* measure size of archive in blocks */
-		unsigned block_id = 0, block_cnt = (unsigned)(_tar_size/Record::BLOCK_LEN);
+		Absolute_path lookup_path(path);
+
+		Node *node = &_root_node;
+
+		for (Path_element_token t(lookup_path.base()); t; t = t.next()) {
+
+			if (t.type() != Path_element_token::IDENT)
+				continue;
+
+			node = _path_index.lookup(*node, t.start(), t.len());
+			if (!node)
+				return nullptr;
+		}
+		return node;
+	}
 
-		/* scan metablocks of archive */
-		while (block_id < block_cnt) {
 
-			Record *record = (Record *)(_tar_base + block_id*Record::BLOCK_LEN);
+	char const *_alloc_string(char const *string, size_t max_len)
+	{
+		size_t len = 0;
+		for (; len < max_len && string[len]; len++);
 
-			tar_record_action(record);
+		char *copy = (char *)_alloc.alloc(len + 1);
+		copy_cstring(copy, string, len + 1);
+		return copy;
+	}
 
-			file_size size = record->storage_size();
 
-			/* some datablocks */       /* one metablock */
-			block_id = block_id + (unsigned)(size / Record::BLOCK_LEN) + 1;
+	/*
+	 *  Create nodes for a tar record and insert them into the node tree
+	 */
+	void _add_node(Record const &record, Entry const *entry)
+	{
+		Absolute_path current_path;
 
-			/* round up */
-			if (size % Record::BLOCK_LEN != 0) block_id++;
+		char path_element[MAX_PATH_LEN];
 
-			/* check for end of tar archive */
-			if (block_id*Record::BLOCK_LEN >= _tar_size)
-				break;
+		if (record.max_name_len() > 100 || record.name()[99] == 0)
+			current_path.import(record.name());
 
-			/* lookout for empty eof-blocks */
-			if (*(_tar_base + (block_id*Record::BLOCK_LEN)) == 0x00)
-				if (*(_tar_base + (block_id*Record::BLOCK_LEN + 1)) == 0x00)
-					break;
+		/*
+		 * GNU tar does not null terminate names of length 100
+		 */
+		else {
+			copy_cstring(path_element, record.name(), 101);
+			current_path.import(path_element);
+		}
+
+		Path_element_token t(current_path.base());
+
+		Node *parent_node = &_root_node;
+
+		while(t) {
+
+			if (t.type() != Path_element_token::IDENT) {
+					t = t.next();
+					continue;
+			}
+
+			Absolute_path remaining_path(t.start());
+
+			Node *child_node = _path_index.lookup(*parent_node, t.start(), t.len());
+
+			if (child_node) {
+
+				if (remaining_path.has_single_element()) {
+					/* Found a node for the record to be inserted.
+					 * This is usually a directory node without
+					 * record. */
+					child_node->record = entry;
+				}
+			} else {
+
+				/* intermediate directories are created as nodes without record */
+				child_node = new (_alloc)
+					Node(_alloc_string(t.start(), t.len()), parent_node,
+					     remaining_path.has_single_element() ? entry : nullptr);
+
+				parent_node->insert(child_node);
+				parent_node->num_dirent++;
+				_path_index.insert(*child_node);
+			}
+
+			parent_node = child_node;
+			t = t.next();
 		}
 	}
 
 
-	struct Num_dirent_cache
+	/**
+	 * Buffer for the headers of a record including a GNU long name
+	 */
+	struct Header_buffer
 	{
-		Node     &root_node;
-		bool      valid;              /* true after first lookup */
-		char      key[256];           /* key used for lookup */
-		file_size cached_num_dirent;  /* cached value */
+		char data[2*Record::BLOCK_LEN + MAX_PATH_LEN];
+
+		Record const &record() const { return *(Record const *)data; }
+	};
 
-		Num_dirent_cache(Node &root_node)
-		: root_node(root_node), valid(false), cached_num_dirent(0) { }
 
-		file_size num_dirent(char const *path)
-		{
-			/* check for cache miss */
-			if (!valid || strcmp(path, key) != 0) {
-				Node *node = root_node.lookup(path);
-				if (!node)
-					return 0;
-				copy_cstring(key, path, sizeof(key));
-				cached_num_dirent = node->num_dirent();
-				valid = true;
+	/*
+	 * Scan the record headers of the archive and add a node for each record
+	 */
+	void _index_archive()
+	{
+		Header_buffer &buffer = *new (_alloc) Header_buffer;
+
+		file_size const archive_size = _archive.size();
+
+		for (file_size offset = 0; offset + Record::BLOCK_LEN <= archive_size; ) {
+
+			if (_archive.read(offset, Byte_range_ptr(buffer.data, Record::BLOCK_LEN))
+			    != Record::BLOCK_LEN)
+				break;
+
+			/* lookout for empty eof-blocks */
+			if (buffer.data[0] == 0x00 && buffer.data[1] == 0x00)
+				break;
+
+			Record const &record = buffer.record();
+
+			file_size const header_size = record.header_size();
+			if (header_size > sizeof(buffer.data)) {
+				error(_rom_name, " contains an oversized record at offset ", offset);
+				break;
 			}
-			return cached_num_dirent;
+
+			size_t const remaining = size_t(header_size) - Record::BLOCK_LEN;
+			if (remaining && _archive.read(offset + Record::BLOCK_LEN,
+			                               Byte_range_ptr(buffer.data + Record::BLOCK_LEN,
+			                                              remaining)) != remaining)
+				break;
+
+			bool const link = (record.type() == Record::TYPE_HARDLINK)
+			               || (record.type() == Record::TYPE_SYMLINK);
+
+			Entry const &entry = *new (_alloc)
+				Entry(record, offset + header_size,
+				      link ? _alloc_string(record.linked_name(), record.max_name_len())
+				           : nullptr);
+
+			_add_node(record, &entry);
+
+			/* one metablock and some datablocks, rounded up */
+			offset += Record::BLOCK_LEN
+			        + align_addr(record.storage_size(), { .log2 = Record::BLOCK_SHIFT });
 		}
-	} _cached_num_dirent;
+
+		destroy(_alloc, &buffer);
+	}
+
 
 	/**
 	 * Walk hardlinks until we reach a file
 	 */
 	Node const *dereference(char const *path)
 	{
-		Node const *node = _root_node.lookup(path);
+		Node const *node = _lookup(path);
 		Node const *slow_node = node;
 		int i = 0;
 		while (node) {
-			Record const *record = node->record;
+			Entry const *record = node->record;
 			if (!record || record->type() != Record::TYPE_HARDLINK)
 				break; /* got it */
 
@@ -528,9 +751,9 @@ class Vfs_tar::File_system : public Vfs::File_system
 			 * loop then eventually we catch it as the faster
 			 * laps the slower.
 			 */
-			node = _root_node.lookup(record->linked_name());
+			node = _lookup(record->linked_name());
 			if (i++ & 1) {
-				slow_node = _root_node.lookup(slow_node->record->linked_name());
+				slow_node = _lookup(slow_node->record->linked_name());
 				if (node == slow_node) {
 					error(_rom_name, " contains a hard-link loop at '", path, "'");
 					node = nullptr;
@@ -542,14 +765,18 @@ class Vfs_tar::File_system : public Vfs::File_system
 
 	public:
 
-		File_system(Vfs::Env &env, Genode::Node const &config)
+		/**
+		 * Constructor
+		 *
+		 * \param archive  archive content, must stay valid during the
+		 *                 lifetime of the file system
+		 */
+		File_system(Vfs::Env &env, Genode::Node const &config, Archive &archive)
 		:
-			_env(env.env()), _alloc(env.alloc()),
-			_rom_name(config.attribute_value("name", Rom_name())),
-			_root_node("", 0),
-			_cached_num_dirent(_root_node)
+			_env(env.env()), _alloc(env.alloc()), _archive(archive),
+			_rom_name(config.attribute_value("name", Rom_name()))
 		{
-			_for_each_tar_record_do(Add_node_action(_alloc, _root_node));
+			_index_archive();
 		}
 
 		/*********************************
@@ -562,7 +789,7 @@ class Vfs_tar::File_system : public Vfs::File_system
 			if (!node || !node->record)
 				return Dataspace_capability();
 
-			Record const *record = node->record;
+			Entry const *record = node->record;
 			if (record->type() != Record::TYPE_FILE) {
 				error("TAR record \"", path, "\" has unsupported type ", record->type());
 				return Dataspace_capability();
@@ -577,9 +804,12 @@ class Vfs_tar::File_system : public Vfs::File_system
 						.at   = { },  .executable = { },  .writeable = true
 					}).convert<Dataspace_capability>(
 						[&] (Genode::Env::Local_rm::Attachment &a) {
-							memcpy(a.ptr, record->data(), len);
+							Byte_range_ptr const dst((char *)a.ptr, len);
+							if (_archive.read(record->data_offset(), dst) != len)
+								return Dataspace_capability();
+
 							allocation.deallocate = false;
-							return allocation.cap;
+							return Dataspace_capability(allocation.cap);
 						},
 						[&] (Genode::Env::Local_rm::Error) {
 							return Dataspace_capability();
@@ -616,7 +846,7 @@ class Vfs_tar::File_system : public Vfs::File_system
 				return STAT_OK;
 			}
 
-			Record const &record = *node_ptr->record;
+			Entry const &record = *node_ptr->record;
 
 			auto node_type = [&] ()
 			{
@@ -658,14 +888,15 @@ class Vfs_tar::File_system : public Vfs::File_system
 
 		Rename_result rename(char const *from, char const *to) override
 		{
-			if (_root_node.lookup(from) || _root_node.lookup(to))
+			if (_lookup(from) || _lookup(to))
 				return RENAME_ERR_NO_PERM;
 			return RENAME_ERR_NO_ENTRY;
 		}
 
 		file_size num_dirent(char const *path) override
 		{
-			return _cached_num_dirent.num_dirent(path);
+			Node const *node = _lookup(path);
+			return node ? node->num_dirent : 0;
 		}
 
 		bool directory(char const *path) override
@@ -675,7 +906,7 @@ class Vfs_tar::File_system : public Vfs::File_system
 			if (!node)
 				return false;
 
-			Record const *record = node->record;
+			Entry const *record = node->record;
 
 			return record ? (record->type() == Record::TYPE_DIR) : true;
 		}
@@ -687,7 +918,7 @@ class Vfs_tar::File_system : public Vfs::File_system
 			 * case, return the whole path, which is relative to the root
 			 * of this file system.
 			 */
-			Node *node = _root_node.lookup(path);
+			Node const *node = _lookup(path);
 			return node ? path : 0;
 		}
 
@@ -757,7 +988,6 @@ class Vfs_tar::File_system : public Vfs::File_system
 		 ** File_system interface **
 		 ***************************/
 
-		static char const *name()   { return "tar"; }
 		char const *type() override { return "tar"; }
 
 
@@ -789,4 +1019,21 @@ class Vfs_tar::File_system : public Vfs::File_system
 		bool write_ready(Vfs_handle const &) const override { return false; }
 };
 
+
+/**
+ * Tar file system for an uncompressed archive provided as ROM module
+ */
+class Vfs_tar::Rom_file_system : private Rom_archive, public File_system
+{
+	public:
+
+		Rom_file_system(Vfs::Env &env, Genode::Node const &config)
+		:
+			Rom_archive(env.env(), config.attribute_value("name", String<64>()).string()),
+			File_system(env, config, *this)
+		{ }
+
+		static char const *name() { return "tar"; }
+};
+
 #endif /* _INCLUDE__VFS__TAR_FILE_SYSTEM_H_ */
@@ -0,0 +1,627 @@
+/*
+ * \brief  Write-back cache of block-device chunks
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _CACHE_H_
+#define _CACHE_H_
+
+/* Genode includes */
+#include <base/attached_ram_dataspace.h>
+#include <block_session/connection.h>
+#include <util/construct_at.h>
+
+namespace Block_cache {
+
+	using namespace Genode;
+
+	struct Job;
+
+	using Backend = Block::Connection<Job>;
+
+	class Cache;
+}
+
+
+struct Block_cache::Job : Backend::Job
+{
+	unsigned const line;   /* index of the cache line, unused for SYNC */
+
+	Job(Backend &backend, Block::Operation operation, unsigned line)
+	:
+		Backend::Job(backend, operation), line(line)
+	{ }
+};
+
+
+/**
+ * Cache of fixed-size chunks of the backend block device
+ *
+ * The cache consists of a fixed number of lines, each holding one chunk.
+ * Lines are looked up by chunk number via a hash table and are recycled in
+ * least-recently-used order. Client writes are merely copied into the cache
+ * and written back to the backend later on, either when the number of dirty
+ * lines exceeds the configured limit, when a line is needed for another
+ * chunk, or when a client requests a SYNC.
+ *
+ * Each client write is tagged with a sequence number. A dirty line
+ * remembers the sequence number of its oldest unwritten write. This way, a
+ * SYNC needs to wait only for the writes that happened before the SYNC,
+ * not for writes that keep coming in from other clients.
+ */
+class Block_cache::Cache : Noncopyable
+{
+	public:
+
+		using Chunk = uint64_t;   /* chunk number */
+		using Seq   = uint64_t;   /* sequence number of client writes */
+
+		struct Attr
+		{
+			size_t   chunk_size;    /* in bytes, multiple of the block size */
+			unsigned num_lines;
+			unsigned dirty_limit;   /* number of dirty lines kept at most */
+		};
+
+		enum class Access { DONE, PENDING, FAILED };
+
+		struct Stats
+		{
+			uint64_t read_hits, read_misses, readahead_loads, readahead_hits,
+			         writes, writebacks, evictions, read_errors, write_errors,
+			         syncs;
+
+			void print(Output &out) const
+			{
+				Genode::print(out, "hits:",            read_hits,       " "
+				                   "misses:",          read_misses,     " "
+				                   "readahead_loads:", readahead_loads, " "
+				                   "readahead_hits:",  readahead_hits,  " "
+				                   "writes:",          writes,          " "
+				                   "writebacks:",      writebacks,      " "
+				                   "evictions:",       evictions,       " "
+				                   "syncs:",           syncs,           " "
+				                   "read_errors:",     read_errors,     " "
+				                   "write_errors:",    write_errors);
+			}
+		};
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Cache(Cache const &);
+		Cache &operator = (Cache const &);
+
+		static constexpr unsigned NONE = ~0U;
+
+		/* number of lines written back at once to make room for a chunk */
+		static constexpr unsigned WRITE_BACK_BATCH = 16;
+
+		struct Line
+		{
+			enum class State { FREE, LOADING, VALID, FAILED };
+
+			State state = State::FREE;
+
+			Chunk chunk = 0;
+
+			bool writing   = false;   /* write-back in flight */
+			bool readahead = false;   /* loaded speculatively, not used yet */
+
+			Seq dirty_seq   = 0;   /* oldest unwritten write, 0 if clean */
+			Seq writing_seq = 0;   /* oldest write covered by the write-back */
+
+			unsigned lru_prev = NONE, lru_next = NONE;
+
+			unsigned next = NONE;   /* hash chain or free list */
+
+			bool dirty() const { return dirty_seq != 0; }
+
+			bool evictable() const
+			{
+				return (state == State::VALID || state == State::FAILED)
+				    && !dirty() && !writing;
+			}
+		};
+
+		Backend   &_backend;
+		Allocator &_alloc;
+
+		Attr const _attr;
+
+		size_t               const _block_size   = _backend.info().block_size;
+		Block::block_count_t const _chunk_blocks = _attr.chunk_size / _block_size;
+		Chunk                const _num_chunks   = (_backend.info().block_count
+		                                           + _chunk_blocks - 1) / _chunk_blocks;
+
+		static unsigned _power_of_two(unsigned n)
+		{
+			unsigned result = 1;
+			while (result < n)
+				result <<= 1;
+			return result;
+		}
+
+		unsigned const _num_buckets = _power_of_two(_attr.num_lines);
+
+		Attached_ram_dataspace _meta_ds;
+		Attached_ram_dataspace _data_ds;
+
+		Line     * const _lines   = _meta_ds.local_addr<Line>();
+		unsigned * const _buckets = (unsigned *)(_lines + _attr.num_lines);
+
+		unsigned _free = NONE;
+
+		unsigned _lru_head = NONE;   /* most recently used */
+		unsigned _lru_tail = NONE;   /* least recently used */
+
+		unsigned _num_dirty   = 0;
+		unsigned _num_loading = 0;
+		unsigned _num_writing = 0;
+		unsigned _num_used    = 0;
+
+		Seq _seq = 0;
+
+		/* sequence number covered by the most recent backend SYNC */
+		Seq  _synced_seq      = 0;
+		Seq  _sync_job_seq    = 0;
+		bool _sync_job_active = false;
+
+		Stats _stats { };
+
+		char *_data(unsigned i) { return _data_ds.local_addr<char>() + i*_attr.chunk_size; }
+
+		unsigned &_bucket(Chunk chunk) {
+			return _buckets[(chunk ^ (chunk >> 16)) & (_num_buckets - 1)]; }
+
+		Block::block_count_t _chunk_count(Chunk chunk) const
+		{
+			Block::block_number_t const first = chunk*_chunk_blocks;
+			return min(_chunk_blocks, _backend.info().block_count - first);
+		}
+
+		unsigned _lookup(Chunk chunk)
+		{
+			for (unsigned i = _bucket(chunk); i != NONE; i = _lines[i].next)
+				if (_lines[i].chunk == chunk)
+					return i;
+
+			return NONE;
+		}
+
+		void _lru_remove(unsigned i)
+		{
+			Line &line = _lines[i];
+
+			if (line.lru_prev != NONE) _lines[line.lru_prev].lru_next = line.lru_next;
+			else                       _lru_head = line.lru_next;
+
+			if (line.lru_next != NONE) _lines[line.lru_next].lru_prev = line.lru_prev;
+			else                       _lru_tail = line.lru_prev;
+
+			line.lru_prev = line.lru_next = NONE;
+		}
+
+		void _lru_insert_head(unsigned i)
+		{
+			Line &line = _lines[i];
+
+			line.lru_prev = NONE;
+			line.lru_next = _lru_head;
+
+			if (_lru_head != NONE) _lines[_lru_head].lru_prev = i;
+			else                   _lru_tail = i;
+
+			_lru_head = i;
+		}
+
+		void _touch(unsigned i)
+		{
+			if (_lru_head == i)
+				return;
+
+			_lru_remove(i);
+			_lru_insert_head(i);
+		}
+
+		/**
+		 * Remove line from the hash table and the LRU list
+		 */
+		void _unlink(unsigned i)
+		{
+			Line &line = _lines[i];
+
+			unsigned *link = &_bucket(line.chunk);
+			while (*link != i)
+				link = &_lines[*link].next;
+			*link = line.next;
+
+			_lru_remove(i);
+			_num_used--;
+		}
+
+		void _release(unsigned i)
+		{
+			_unlink(i);
+
+			_lines[i] = Line { };
+			_lines[i].next = _free;
+			_free = i;
+		}
+
+		/**
+		 * Obtain unused or clean line for 'chunk'
+		 *
+		 * \return line index, or NONE if all lines are busy or dirty
+		 */
+		unsigned _alloc_line(Chunk chunk)
+		{
+			unsigned i = _free;
+
+			if (i != NONE) {
+				_free = _lines[i].next;
+			} else {
+				for (i = _lru_tail; i != NONE; i = _lines[i].lru_prev)
+					if (_lines[i].evictable())
+						break;
+
+				if (i == NONE)
+					return NONE;
+
+				_unlink(i);
+				_stats.evictions++;
+			}
+
+			Line &line = _lines[i];
+			line       = Line { };
+			line.chunk = chunk;
+
+			unsigned &bucket = _bucket(chunk);
+			line.next = bucket;
+			bucket    = i;
+
+			_lru_insert_head(i);
+			_num_used++;
+
+			return i;
+		}
+
+		void _load(unsigned i, bool readahead)
+		{
+			Line &line = _lines[i];
+
+			line.state     = Line::State::LOADING;
+			line.readahead = readahead;
+			_num_loading++;
+
+			new (_alloc) Job(_backend, { .type         = Block::Operation::Type::READ,
+			                             .block_number = line.chunk*_chunk_blocks,
+			                             .count        = _chunk_count(line.chunk) }, i);
+		}
+
+		void _write_back(unsigned i)
+		{
+			Line &line = _lines[i];
+
+			line.writing     = true;
+			line.writing_seq = line.dirty_seq;
+			line.dirty_seq   = 0;
+			_num_dirty--;
+			_num_writing++;
+			_stats.writebacks++;
+
+			new (_alloc) Job(_backend, { .type         = Block::Operation::Type::WRITE,
+			                             .block_number = line.chunk*_chunk_blocks,
+			                             .count        = _chunk_count(line.chunk) }, i);
+		}
+
+		/**
+		 * Write back dirty lines, least recently used first
+		 *
+		 * \param limit  number of dirty lines to keep
+		 */
+		void _write_back_lru(unsigned limit)
+		{
+			for (unsigned i = _lru_tail; i != NONE && _num_dirty > limit; ) {
+				unsigned const prev = _lines[i].lru_prev;
+				if (_lines[i].dirty() && !_lines[i].writing)
+					_write_back(i);
+				i = prev;
+			}
+		}
+
+		/**
+		 * Call 'fn' with the data of the line holding 'chunk'
+		 *
+		 * \param need_data  if false, 'fn' overwrites the whole chunk
+		 */
+		Access _with_line(Chunk chunk, bool need_data, auto const &fn)
+		{
+			unsigned i = _lookup(chunk);
+
+			if (i == NONE) {
+				i = _alloc_line(chunk);
+
+				/* make room by writing back dirty lines */
+				if (i == NONE) {
+					if (_num_writing < WRITE_BACK_BATCH)
+						_write_back_lru(_num_dirty > WRITE_BACK_BATCH
+						                ? _num_dirty - WRITE_BACK_BATCH : 0);
+					return Access::PENDING;
+				}
+
+				if (need_data) {
+					_stats.read_misses++;
+					_load(i, false);
+					return Access::PENDING;
+				}
+
+				_lines[i].state = Line::State::VALID;
+			}
+
+			Line &line = _lines[i];
+
+			if (line.state == Line::State::LOADING)
+				return Access::PENDING;
+
+			if (line.state == Line::State::FAILED) {
+				if (need_data) {
+					/* report the error once, the next access loads again */
+					_release(i);
+					return Access::FAILED;
+				}
+				line.state = Line::State::VALID;
+			}
+
+			line.readahead = false;
+
+			fn(line, _data(i));
+			_touch(i);
+			return Access::DONE;
+		}
+
+		/**
+		 * Start loading chunks that are not cached yet
+		 *
+		 * Lines are only taken if available without write-back.
+		 */
+		void _prefetch(Chunk first, Chunk num, bool readahead)
+		{
+			for (Chunk chunk = first; chunk < first + num && chunk < _num_chunks; chunk++) {
+
+				unsigned const present = _lookup(chunk);
+				if (present != NONE) {
+					Line &line = _lines[present];
+					if (!readahead) {
+						_stats.read_hits++;
+						if (line.readahead) {
+							_stats.readahead_hits++;
+							line.readahead = false;
+						}
+						_touch(present);
+					}
+					continue;
+				}
+
+				unsigned const i = _alloc_line(chunk);
+				if (i == NONE)
+					return;
+
+				if (readahead)
+					_stats.readahead_loads++;
+				else
+					_stats.read_misses++;
+
+				_load(i, readahead);
+			}
+		}
+
+	public:
+
+		Cache(Env &env, Backend &backend, Allocator &alloc, Attr attr)
+		:
+			_backend(backend), _alloc(alloc), _attr(attr),
+			_meta_ds(env.ram(), env.rm(), _attr.num_lines*sizeof(Line)
+			                            + _num_buckets*sizeof(unsigned)),
+			_data_ds(env.ram(), env.rm(), _attr.num_lines*_attr.chunk_size)
+		{
+			for (unsigned i = 0; i < _num_buckets; i++)
+				_buckets[i] = NONE;
+
+			for (unsigned i = _attr.num_lines; i > 0; i--) {
+				Line &line = *construct_at<Line>(&_lines[i - 1]);
+				line.next = _free;
+				_free = i - 1;
+			}
+		}
+
+		Block::block_count_t chunk_blocks() const { return _chunk_blocks; }
+
+		Chunk num_chunks() const { return _num_chunks; }
+
+		/**
+		 * Sequence number of the most recent client write
+		 */
+		Seq seq() const { return _seq; }
+
+		Stats stats() const { return _stats; }
+
+		unsigned num_lines()   const { return _attr.num_lines; }
+		unsigned num_used()    const { return _num_used; }
+		unsigned num_dirty()   const { return _num_dirty; }
+		unsigned num_loading() const { return _num_loading; }
+
+		/**
+		 * Copy 'len' bytes at 'offset' within 'chunk' to 'dst'
+		 */
+		Access read(Chunk chunk, size_t offset, size_t len, char *dst)
+		{
+			return _with_line(chunk, true, [&] (Line &, char const *data) {
+				memcpy(dst, data + offset, len); });
+		}
+
+		/**
+		 * Copy 'len' bytes from 'src' to 'offset' within 'chunk'
+		 */
+		Access write(Chunk chunk, size_t offset, size_t len, char const *src)
+		{
+			bool const whole_chunk = (offset == 0)
+			                      && (len == _chunk_count(chunk)*_block_size);
+
+			return _with_line(chunk, !whole_chunk, [&] (Line &line, char *data) {
+				memcpy(data + offset, src, len);
+
+				_seq++;
+				_stats.writes++;
+				if (!line.dirty()) {
+					line.dirty_seq = _seq;
+					_num_dirty++;
+				}
+			});
+		}
+
+		/**
+		 * Start loading the chunks of a client read and account hits
+		 */
+		void load(Chunk first, Chunk num) { _prefetch(first, num, false); }
+
+		/**
+		 * Load chunks speculatively, e.g., for sequential reads
+		 */
+		void readahead(Chunk first, Chunk num)
+		{
+			if (_num_loading < num)
+				_prefetch(first, num, true);
+		}
+
+		/**
+		 * Write back dirty lines exceeding the dirty limit
+		 */
+		void write_back_excess()
+		{
+			if (_num_dirty > _attr.dirty_limit)
+				_write_back_lru(_attr.dirty_limit);
+		}
+
+		/**
+		 * Write back all dirty lines
+		 */
+		void write_back_all() { _write_back_lru(0); }
+
+		/**
+		 * Make all client writes up to 'seq' persistent
+		 *
+		 * The dirty lines written before 'seq' are written back, followed by
+		 * a SYNC of the backend. Failed write-backs are not retried but
+		 * accounted in 'Stats::write_errors'.
+		 *
+		 * \return true once the writes are persistent
+		 */
+		bool sync(Seq seq)
+		{
+			if (_synced_seq >= seq)
+				return true;
+
+			bool flushed = true;
+			for (unsigned i = 0; i < _attr.num_lines; i++) {
+				Line &line = _lines[i];
+
+				if (line.dirty() && line.dirty_seq <= seq) {
+					flushed = false;
+					if (!line.writing)
+						_write_back(i);
+				}
+
+				if (line.writing && line.writing_seq <= seq)
+					flushed = false;
+			}
+
+			if (!flushed || _sync_job_active)
+				return false;
+
+			_sync_job_active = true;
+			_sync_job_seq    = seq;
+			_stats.syncs++;
+
+			new (_alloc) Job(_backend, { .type         = Block::Operation::Type::SYNC,
+			                             .block_number = 0,
+			                             .count        = 0 }, NONE);
+
+			return false;
+		}
+
+		bool update_jobs() { return _backend.update_jobs(*this); }
+
+
+		/******************************************
+		 ** Backend::Update_jobs_policy interface **
+		 ******************************************/
+
+		void produce_write_content(Job &job, Block::seek_off_t offset, char *dst, size_t length)
+		{
+			memcpy(dst, _data(job.line) + offset, length);
+		}
+
+		void consume_read_result(Job &job, Block::seek_off_t offset, char const *src, size_t length)
+		{
+			memcpy(_data(job.line) + offset, src, length);
+		}
+
+		void completed(Job &job, bool success)
+		{
+			using Type = Block::Operation::Type;
+
+			switch (job.operation().type) {
+
+			case Type::READ:
+				{
+					_num_loading--;
+
+					Line &line = _lines[job.line];
+					if (success) {
+						line.state = Line::State::VALID;
+					} else {
+						_stats.read_errors++;
+
+						/* speculative loads are dropped silently */
+						if (line.readahead) _release(job.line);
+						else                line.state = Line::State::FAILED;
+					}
+				}
+				break;
+
+			case Type::WRITE:
+				{
+					Line &line = _lines[job.line];
+					line.writing = false;
+					_num_writing--;
+					if (!success)
+						_stats.write_errors++;
+				}
+				break;
+
+			case Type::SYNC:
+				_sync_job_active = false;
+				_synced_seq = max(_synced_seq, _sync_job_seq);
+				if (!success)
+					_stats.write_errors++;
+				break;
+
+			default: break;
+			}
+
+			destroy(_alloc, &job);
+		}
+};
+
+#endif /* _CACHE_H_ */
@@ -0,0 +1,529 @@
+/*
+ * \brief  Write-back block cache
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <block/request_stream.h>
+#include <os/reporter.h>
+#include <os/session_policy.h>
+#include <root/root.h>
+#include <timer_session/connection.h>
+
+/* local includes */
+#include "cache.h"
+
+namespace Block_cache {
+
+	class Session_component;
+	struct Main;
+}
+
+
+class Block_cache::Session_component : public  Rpc_object<Block::Session>,
+                                       private Block::Request_stream
+{
+	private:
+
+		static constexpr unsigned MAX_REQUESTS = 32;
+
+		struct Slot
+		{
+			enum class State { FREE, PENDING, COMPLETE };
+
+			State state = State::FREE;
+
+			Block::Request request { };
+
+			char *content = nullptr;
+
+			Block::block_count_t done = 0;   /* number of processed blocks */
+
+			Cache::Seq seq = 0;   /* writes covered by a SYNC */
+		};
+
+		Entrypoint &_ep;
+		Cache      &_cache;
+
+		size_t               const _block_size;
+		Block::block_count_t const _chunk_blocks = _cache.chunk_blocks();
+		Cache::Chunk         const _readahead_chunks;
+
+		Slot _slots[MAX_REQUESTS] { };
+
+		/* new requests are held back until a pending SYNC is completed */
+		bool _sync_pending = false;
+
+		/* block following the previous read, used to detect sequential reads */
+		Block::block_number_t _next_read = 0;
+
+		/* write errors already reported to the client */
+		uint64_t _reported_write_errors = _cache.stats().write_errors;
+
+		void _complete(Slot &slot, bool success)
+		{
+			slot.request.success = success;
+			slot.state           = Slot::State::COMPLETE;
+		}
+
+		Slot *_free_slot()
+		{
+			for (Slot &slot : _slots)
+				if (slot.state == Slot::State::FREE)
+					return &slot;
+
+			return nullptr;
+		}
+
+		bool _idle() const
+		{
+			for (Slot const &slot : _slots)
+				if (slot.state != Slot::State::FREE)
+					return false;
+
+			return true;
+		}
+
+		void _load(Block::Operation const &op)
+		{
+			Cache::Chunk const first = op.block_number / _chunk_blocks;
+			Cache::Chunk const last  = (op.block_number + op.count - 1) / _chunk_blocks;
+
+			_cache.load(first, last - first + 1);
+
+			if (_readahead_chunks && op.block_number == _next_read)
+				_cache.readahead(last + 1, _readahead_chunks);
+
+			_next_read = op.block_number + op.count;
+		}
+
+		Response _accept(Block::Request const &request)
+		{
+			using Type = Block::Operation::Type;
+
+			if (_sync_pending)
+				return Response::RETRY;
+
+			Slot * const slot_ptr = _free_slot();
+			if (!slot_ptr)
+				return Response::RETRY;
+
+			Slot &slot = *slot_ptr;
+
+			switch (request.operation.type) {
+
+			case Type::READ:
+			case Type::WRITE:
+				{
+					char *content = nullptr;
+					with_content(request, [&] (void *ptr, size_t) {
+						content = (char *)ptr; });
+
+					if (!content)
+						return Response::REJECTED;
+
+					slot = { .state   = Slot::State::PENDING,
+					         .request = request,
+					         .content = content,
+					         .done    = 0,
+					         .seq     = 0 };
+
+					if (request.operation.type == Type::READ)
+						_load(request.operation);
+				}
+				return Response::ACCEPTED;
+
+			case Type::SYNC:
+
+				/* the SYNC covers all writes acknowledged so far */
+				if (!_idle())
+					return Response::RETRY;
+
+				slot = { .state   = Slot::State::PENDING,
+				         .request = request,
+				         .content = nullptr,
+				         .done    = 0,
+				         .seq     = _cache.seq() };
+
+				_sync_pending = true;
+				return Response::ACCEPTED;
+
+			case Type::TRIM:
+
+				/* cached chunks are kept as trimmed blocks have undefined content */
+				slot.request = request;
+				_complete(slot, true);
+				return Response::ACCEPTED;
+
+			default: break;
+			}
+
+			return Response::REJECTED;
+		}
+
+		/**
+		 * Process pending request chunk by chunk
+		 *
+		 * \return true if progress was made
+		 */
+		bool _process(Slot &slot)
+		{
+			using Type   = Block::Operation::Type;
+			using Access = Cache::Access;
+
+			Block::Operation const &op = slot.request.operation;
+
+			if (op.type == Type::SYNC) {
+
+				if (!_cache.sync(slot.seq))
+					return false;
+
+				uint64_t const write_errors = _cache.stats().write_errors;
+
+				_complete(slot, write_errors == _reported_write_errors);
+				_reported_write_errors = write_errors;
+				_sync_pending = false;
+				return true;
+			}
+
+			bool progress = false;
+
+			while (slot.done < op.count) {
+
+				Block::block_number_t const block  = op.block_number + slot.done;
+				Block::block_count_t  const offset = block % _chunk_blocks;
+				Block::block_count_t  const count  = min(_chunk_blocks - offset,
+				                                         op.count - slot.done);
+
+				Cache::Chunk const chunk   = block / _chunk_blocks;
+				char       * const content = slot.content + slot.done*_block_size;
+
+				Access const access = (op.type == Type::READ)
+					? _cache.read (chunk, offset*_block_size, count*_block_size, content)
+					: _cache.write(chunk, offset*_block_size, count*_block_size, content);
+
+				if (access == Access::PENDING)
+					return progress;
+
+				if (access == Access::FAILED) {
+					_complete(slot, false);
+					return true;
+				}
+
+				slot.done += count;
+				progress = true;
+			}
+
+			_complete(slot, true);
+			return true;
+		}
+
+	public:
+
+		Session_component(Env::Local_rm             &rm,
+		                  Entrypoint                &ep,
+		                  Dataspace_capability       ds,
+		                  Signal_context_capability  sigh,
+		                  Block::Session::Info       info,
+		                  Block::Constrained_view    view,
+		                  Cache                     &cache,
+		                  Cache::Chunk               readahead_chunks)
+		:
+			Request_stream(rm, ds, ep, sigh, info, view),
+			_ep(ep), _cache(cache), _block_size(info.block_size),
+			_readahead_chunks(readahead_chunks)
+		{
+			_ep.manage(*this);
+		}
+
+		~Session_component() { _ep.dissolve(*this); }
+
+		Info info() const override { return Request_stream::info(); }
+
+		Capability<Tx> tx_cap() override { return Request_stream::tx_cap(); }
+
+		using Request_stream::wakeup_client_if_needed;
+
+		/**
+		 * Accept, process, and acknowledge requests
+		 *
+		 * \return true if progress was made
+		 */
+		bool process()
+		{
+			bool progress = false;
+
+			with_requests([&] (Block::Request request) {
+				Response const response = _accept(request);
+				progress |= (response != Response::RETRY);
+				return response;
+			});
+
+			for (Slot &slot : _slots)
+				if (slot.state == Slot::State::PENDING)
+					progress |= _process(slot);
+
+			try_acknowledge([&] (Block::Request_stream::Ack &ack) {
+				for (Slot &slot : _slots) {
+					if (slot.state != Slot::State::COMPLETE)
+						continue;
+
+					ack.submit(slot.request);
+					slot.state = Slot::State::FREE;
+					progress   = true;
+					return;
+				}
+			});
+
+			return progress;
+		}
+};
+
+
+struct Block_cache::Main : Rpc_object<Typed_root<Block::Session>>
+{
+	Env &_env;
+
+	Heap                   _heap       { _env.ram(), _env.rm() };
+	Attached_rom_dataspace _config_rom { _env, "config" };
+
+	Node _config() const { return _config_rom.node(); }
+
+	bool const _verbose = _config().attribute_value("verbose", false);
+
+	Allocator_avl _block_alloc { &_heap };
+
+	Backend _backend { _env, &_block_alloc,
+	                   _config().attribute_value("tx_buf_size", Num_bytes(1024*1024)) };
+
+	Block::Session::Info const _backend_info = _backend.info();
+
+	/* chunk size rounded down to a multiple of the block size */
+	size_t const _chunk_size =
+		max(_backend_info.block_size,
+		    _config().attribute_value("chunk_size", Num_bytes(4096))
+		    / _backend_info.block_size * _backend_info.block_size);
+
+	static unsigned _num_chunks(Num_bytes bytes, size_t chunk_size) {
+		return unsigned(max(bytes/chunk_size, size_t(1))); }
+
+	unsigned const _num_lines =
+		_num_chunks(_config().attribute_value("cache_size", Num_bytes(4*1024*1024)),
+		            _chunk_size);
+
+	Cache _cache { _env, _backend, _heap, {
+		.chunk_size  = _chunk_size,
+		.num_lines   = _num_lines,
+		.dirty_limit = min(_num_lines, _num_chunks(
+			_config().attribute_value("dirty_limit",
+			                        Num_bytes(_num_lines*_chunk_size/2)),
+			_chunk_size)) } };
+
+	Cache::Chunk const _readahead_chunks =
+		_config().attribute_value("readahead", Num_bytes(128*1024)) / _chunk_size;
+
+	Signal_handler<Main> _request_handler {
+		_env.ep(), *this, &Main::_handle_requests };
+
+	Timer::Connection _timer { _env };
+
+	using Periodic_timeout = Timer::Periodic_timeout<Main>;
+
+	uint64_t const _flush_interval_ms =
+		_config().attribute_value("flush_interval_ms", uint64_t(1000));
+
+	uint64_t const _report_interval_ms =
+		_config().attribute_value("report_interval_ms", uint64_t(1000));
+
+	Constructible<Periodic_timeout> _flush_timeout  { };
+	Constructible<Periodic_timeout> _report_timeout { };
+
+	Constructible<Expanding_reporter> _reporter { };
+
+	struct Block_session : Registry<Block_session>::Element
+	{
+		Attached_ram_dataspace _bulk_dataspace;
+		Session_component      _component;
+
+		Block_session(Registry<Block_session>       &registry,
+		              Env                           &env,
+		              size_t                         tx_buf_size,
+		              Block::Session::Info    const &info,
+		              Block::Constrained_view const &view,
+		              Signal_handler<Main>          &request_handler,
+		              Cache                         &cache,
+		              Cache::Chunk                   readahead_chunks)
+		:
+			Registry<Block_session>::Element(registry, *this),
+			_bulk_dataspace(env.ram(), env.rm(), tx_buf_size),
+			_component(env.rm(), env.ep(), _bulk_dataspace.cap(),
+			           request_handler, info, view, cache, readahead_chunks)
+		{ }
+
+		Capability<Block::Session> cap() const { return _component.cap(); }
+	};
+
+	Registry<Block_session> _sessions { };
+
+	void _handle_requests()
+	{
+		for (;;) {
+
+			bool progress = false;
+
+			_sessions.for_each([&] (Block_session &session) {
+				progress |= session._component.process(); });
+
+			_cache.write_back_excess();
+
+			progress |= _cache.update_jobs();
+
+			if (!progress)
+				break;
+		}
+
+		_sessions.for_each([&] (Block_session &session) {
+			session._component.wakeup_client_if_needed(); });
+	}
+
+	void _handle_flush_timeout(Duration)
+	{
+		_cache.write_back_all();
+		_handle_requests();
+	}
+
+	void _handle_report_timeout(Duration)
+	{
+		Cache::Stats const stats = _cache.stats();
+
+		if (_verbose)
+			log("lines used:", _cache.num_used(), "/", _cache.num_lines(),
+			    " dirty:", _cache.num_dirty(), " ", stats);
+
+		if (!_reporter.constructed())
+			return;
+
+		_reporter->generate([&] (Generator &g) {
+			g.attribute("chunk_size", _chunk_size);
+			g.attribute("lines",      _cache.num_lines());
+			g.attribute("used",       _cache.num_used());
+			g.attribute("dirty",      _cache.num_dirty());
+			g.attribute("loading",    _cache.num_loading());
+			g.node("read", [&] {
+				g.attribute("hits",            stats.read_hits);
+				g.attribute("misses",          stats.read_misses);
+				g.attribute("readahead_loads", stats.readahead_loads);
+				g.attribute("readahead_hits",  stats.readahead_hits);
+				g.attribute("errors",          stats.read_errors);
+			});
+			g.node("write", [&] {
+				g.attribute("chunks",     stats.writes);
+				g.attribute("writebacks", stats.writebacks);
+				g.attribute("syncs",      stats.syncs);
+				g.attribute("errors",     stats.write_errors);
+			});
+			g.node("evictions", [&] {
+				g.attribute("count", stats.evictions); });
+		});
+	}
+
+
+	/********************
+	 ** Root interface **
+	 ********************/
+
+	Root::Result session(Root::Session_args const &args,
+	                     Affinity const &) override
+	{
+		size_t const tx_buf_size =
+			Arg_string::find_arg(args.string(), "tx_buf_size").aligned_size();
+
+		Ram_quota const ram_quota = ram_quota_from_args(args.string());
+
+		if (tx_buf_size > ram_quota.value) {
+			warning("communication buffer size exceeds session quota");
+			return Session_error::INSUFFICIENT_RAM;
+		}
+
+		/* make sure policy is up-to-date */
+		_config_rom.update();
+
+		return with_matching_policy(label_from_args(args.string()), _config_rom.node(),
+
+			[&] (Node const &policy) -> Root::Result {
+
+				Block::Constrained_view view =
+					Block::Constrained_view::from_args(args.string());
+
+				view.writeable = view.writeable
+				              && policy.attribute_value("writeable", false);
+
+				if (view.offset.value >= _backend_info.block_count) {
+					error("offset larger than total block count");
+					return Session_error::DENIED;
+				}
+
+				Block::Session::Info const info {
+					.block_size  = _backend_info.block_size,
+					.block_count = _backend_info.block_count - view.offset.value,
+					.align_log2  = (uint8_t)log2(_backend_info.block_size, 0u),
+					.writeable   = _backend_info.writeable };
+
+				try {
+					Block_session const &session =
+						*new (_heap) Block_session(_sessions, _env, tx_buf_size,
+						                           info, view, _request_handler,
+						                           _cache, _readahead_chunks);
+					return { session.cap() };
+
+				} catch (...) { return Session_error::DENIED; }
+			},
+			[&] () -> Root::Result { return Session_error::DENIED; });
+	}
+
+	void upgrade(Capability<Session>, Root::Upgrade_args const &) override { }
+
+	void close(Capability<Session> cap) override
+	{
+		_sessions.for_each([&] (Block_session &session) {
+			if (cap == session.cap())
+				destroy(_heap, &session);
+		});
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		_backend.sigh(_request_handler);
+
+		_flush_timeout.conditional(_flush_interval_ms != 0, _timer, *this,
+		                           &Main::_handle_flush_timeout,
+		                           Microseconds(_flush_interval_ms*1000));
+
+		_config().with_optional_sub_node("report", [&] (Node const &report) {
+			if (report.attribute_value("statistics", false))
+				_reporter.construct(_env, "statistics", "statistics"); });
+
+		_report_timeout.conditional((_reporter.constructed() || _verbose)
+		                            && _report_interval_ms != 0, _timer, *this,
+		                            &Main::_handle_report_timeout,
+		                            Microseconds(_report_interval_ms*1000));
+
+		_env.parent().announce(_env.ep().manage(*this));
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Block_cache::Main main(env); }
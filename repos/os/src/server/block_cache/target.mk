@@ -0,0 +1,3 @@
+TARGET = block_cache
+SRC_CC = main.cc
+LIBS   = base
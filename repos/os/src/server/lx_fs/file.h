@@ -148,6 +148,8 @@ class Lx_fs::File : public Node
 			return ret ? false : true;
 		}
 
+		int fd() const override { return _fd; }
+
 		Status status() override
 		{
 			struct stat st { };
@@ -0,0 +1,318 @@
+/*
+ * \brief  Asynchronous file I/O via Linux io_uring
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/log.h>
+
+/* local includes */
+#include "io_uring.h"
+
+/* Linux includes */
+#include <sys/eventfd.h>
+#include <time.h>
+
+
+namespace {
+
+	int io_uring_setup(unsigned entries, io_uring_params &params) {
+		return (int)syscall(__NR_io_uring_setup, entries, &params); }
+
+	int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+		return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0); }
+
+	int io_uring_register(int fd, unsigned opcode, void const *arg, unsigned nr_args) {
+		return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args); }
+
+	template <typename T>
+	T *ring_ptr(void *ring, unsigned offset) {
+		return reinterpret_cast<T *>((char *)ring + offset); }
+}
+
+
+bool Lx_fs::Io_uring::_setup()
+{
+	io_uring_params params { };
+
+	_ring_fd = io_uring_setup(ENTRIES, params);
+	if (_ring_fd < 0)
+		return false;
+
+	_sq_ring_size = params.sq_off.array + params.sq_entries*sizeof(unsigned);
+	_cq_ring_size = params.cq_off.cqes  + params.cq_entries*sizeof(io_uring_cqe);
+	_sqes_size    = params.sq_entries*sizeof(io_uring_sqe);
+
+	bool const single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+	if (single_mmap)
+		_sq_ring_size = _cq_ring_size = max(_sq_ring_size, _cq_ring_size);
+
+	_sq_ring = mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE,
+	                MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_SQ_RING);
+	if (_sq_ring == MAP_FAILED)
+		return false;
+
+	if (single_mmap)
+		_cq_ring = _sq_ring;
+	else
+		_cq_ring = mmap(nullptr, _cq_ring_size, PROT_READ | PROT_WRITE,
+		                MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_CQ_RING);
+	if (_cq_ring == MAP_FAILED)
+		return false;
+
+	_sqes = mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE,
+	             MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_SQES);
+	if (_sqes == MAP_FAILED)
+		return false;
+
+	_sq = {
+		.head    = ring_ptr<unsigned>(_sq_ring, params.sq_off.head),
+		.tail    = ring_ptr<unsigned>(_sq_ring, params.sq_off.tail),
+		.mask    = ring_ptr<unsigned>(_sq_ring, params.sq_off.ring_mask),
+		.array   = ring_ptr<unsigned>(_sq_ring, params.sq_off.array),
+		.sqes    = (io_uring_sqe *)_sqes,
+		.entries = params.sq_entries };
+
+	_cq = {
+		.head    = ring_ptr<unsigned>(_cq_ring, params.cq_off.head),
+		.tail    = ring_ptr<unsigned>(_cq_ring, params.cq_off.tail),
+		.mask    = ring_ptr<unsigned>(_cq_ring, params.cq_off.ring_mask),
+		.cqes    = ring_ptr<io_uring_cqe>(_cq_ring, params.cq_off.cqes),
+		.entries = params.cq_entries };
+
+	_sq_tail = *_sq.tail;
+
+	/* let the kernel signal completions via an eventfd */
+	_event_fd = eventfd(0, EFD_CLOEXEC);
+	if (_event_fd < 0)
+		return false;
+
+	if (io_uring_register(_ring_fd, IORING_REGISTER_EVENTFD, &_event_fd, 1) < 0)
+		return false;
+
+	return true;
+}
+
+
+void Lx_fs::Io_uring::_cleanup()
+{
+	if (_sqes != MAP_FAILED)
+		munmap(_sqes, _sqes_size);
+
+	if (_cq_ring != MAP_FAILED && _cq_ring != _sq_ring)
+		munmap(_cq_ring, _cq_ring_size);
+
+	if (_sq_ring != MAP_FAILED)
+		munmap(_sq_ring, _sq_ring_size);
+
+	if (_event_fd >= 0)
+		close(_event_fd);
+
+	if (_ring_fd >= 0)
+		close(_ring_fd);
+
+	_sqes = _cq_ring = _sq_ring = MAP_FAILED;
+	_event_fd = _ring_fd = -1;
+}
+
+
+io_uring_sqe *Lx_fs::Io_uring::_alloc_sqe(Io_request &request)
+{
+	if (!valid())
+		return nullptr;
+
+	/* never exceed the capacity of the completion queue */
+	if (_in_flight >= _cq.entries)
+		return nullptr;
+
+	unsigned const head = __atomic_load_n(_sq.head, __ATOMIC_ACQUIRE);
+	if (_sq_tail - head >= _sq.entries) {
+
+		/* hand prepared requests to the kernel to free up entries */
+		submit();
+		if (_sq_tail - __atomic_load_n(_sq.head, __ATOMIC_ACQUIRE) >= _sq.entries)
+			return nullptr;
+	}
+
+	unsigned const index = _sq_tail & *_sq.mask;
+
+	io_uring_sqe &sqe = _sq.sqes[index];
+	memset(&sqe, 0, sizeof(sqe));
+	sqe.user_data = (__u64)&request;
+
+	_sq.array[index] = index;
+	_sq_tail++;
+	_unsubmitted++;
+	_in_flight++;
+
+	return &sqe;
+}
+
+
+bool Lx_fs::Io_uring::read(Io_request &request, int fd, void *dst,
+                           size_t len, uint64_t offset)
+{
+	io_uring_sqe * const sqe = _alloc_sqe(request);
+	if (!sqe)
+		return false;
+
+	sqe->opcode = IORING_OP_READ;
+	sqe->fd     = fd;
+	sqe->addr   = (__u64)dst;
+	sqe->len    = (__u32)len;
+	sqe->off    = offset;
+	return true;
+}
+
+
+bool Lx_fs::Io_uring::write(Io_request &request, int fd, void const *src,
+                            size_t len, uint64_t offset)
+{
+	io_uring_sqe * const sqe = _alloc_sqe(request);
+	if (!sqe)
+		return false;
+
+	sqe->opcode = IORING_OP_WRITE;
+	sqe->fd     = fd;
+	sqe->addr   = (__u64)src;
+	sqe->len    = (__u32)len;
+	sqe->off    = offset;
+	return true;
+}
+
+
+bool Lx_fs::Io_uring::fsync(Io_request &request, int fd)
+{
+	io_uring_sqe * const sqe = _alloc_sqe(request);
+	if (!sqe)
+		return false;
+
+	sqe->opcode = IORING_OP_FSYNC;
+	sqe->fd     = fd;
+	return true;
+}
+
+
+void Lx_fs::Io_uring::submit()
+{
+	if (!_unsubmitted)
+		return;
+
+	__atomic_store_n(_sq.tail, _sq_tail, __ATOMIC_RELEASE);
+
+	int ret = 0;
+	do { ret = io_uring_enter(_ring_fd, _unsubmitted, 0, 0); }
+	while (ret < 0 && errno == EINTR);
+
+	if (ret < 0) {
+		if (errno != EAGAIN && errno != EBUSY) {
+			error("io_uring_enter failed error=", Cstring { strerror(errno) });
+			return;
+		}
+
+		/*
+		 * The kernel is temporarily short of resources. Wake up the
+		 * completion thread, which triggers 'complete' and thereby
+		 * another 'submit' after a short delay, even if no request is
+		 * in flight that could complete.
+		 */
+		__atomic_store_n(&_retry_pending, true, __ATOMIC_RELEASE);
+		eventfd_write(_event_fd, 1);
+		return;
+	}
+	__atomic_store_n(&_retry_pending, false, __ATOMIC_RELEASE);
+	_unsubmitted -= min((unsigned)ret, _unsubmitted);
+}
+
+
+void Lx_fs::Io_uring::complete()
+{
+	if (!valid())
+		return;
+
+	for (;;) {
+		unsigned const head = *_cq.head;
+		if (head == __atomic_load_n(_cq.tail, __ATOMIC_ACQUIRE))
+			break;
+
+		io_uring_cqe const cqe = _cq.cqes[head & *_cq.mask];
+
+		/* release the entry before the request may prepare new ones */
+		__atomic_store_n(_cq.head, head + 1, __ATOMIC_RELEASE);
+		_in_flight--;
+
+		reinterpret_cast<Io_request *>(cqe.user_data)->io_completed(cqe.res);
+	}
+
+	/* requests prepared in reaction to completions */
+	submit();
+}
+
+
+void Lx_fs::Io_uring::wait_for_completion()
+{
+	if (!valid() || !_in_flight)
+		return;
+
+	__atomic_store_n(_sq.tail, _sq_tail, __ATOMIC_RELEASE);
+
+	int const ret = io_uring_enter(_ring_fd, _unsubmitted, 1, IORING_ENTER_GETEVENTS);
+	if (ret > 0)
+		_unsubmitted -= min((unsigned)ret, _unsubmitted);
+
+	complete();
+}
+
+
+void Lx_fs::Io_uring::entry()
+{
+	for (;;) {
+		eventfd_t value = 0;
+		if (eventfd_read(_event_fd, &value) != 0)
+			continue;
+
+		/* give the kernel time to recover before submitting again */
+		if (__atomic_load_n(&_retry_pending, __ATOMIC_ACQUIRE)) {
+			timespec const delay { .tv_sec = 0, .tv_nsec = 1000*1000 };
+			nanosleep(&delay, nullptr);
+		}
+		_completion_handler.local_submit();
+	}
+}
+
+
+Lx_fs::Io_uring::Io_uring(Env &env, bool enabled)
+:
+	Thread { env, "io_uring", Stack_size { 8*1024 } },
+	_env   { env }
+{
+	if (!enabled)
+		return;
+
+	if (!_setup()) {
+		warning("io_uring unavailable (", Cstring { strerror(errno) }, "), "
+		        "falling back to synchronous I/O");
+		_cleanup();
+		return;
+	}
+
+	start();
+}
+
+
+Lx_fs::Io_uring::~Io_uring()
+{
+	while (_in_flight)
+		wait_for_completion();
+
+	/* the completion thread stays blocked on the closed eventfd */
+	_cleanup();
+}
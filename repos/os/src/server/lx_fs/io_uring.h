@@ -0,0 +1,171 @@
+/*
+ * \brief  Asynchronous file I/O via Linux io_uring
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _IO_URING_H_
+#define _IO_URING_H_
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/signal.h>
+#include <base/thread.h>
+
+/* local includes */
+#include "lx_util.h"
+
+/* Linux includes */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#pragma GCC diagnostic pop
+
+
+namespace Lx_fs {
+
+	struct Io_request;
+	class  Io_uring;
+}
+
+
+/**
+ * Operation submitted to the 'Io_uring'
+ */
+struct Lx_fs::Io_request : Genode::Interface
+{
+	/**
+	 * Called at the entrypoint once the operation is completed
+	 *
+	 * \param result  number of bytes transferred or negative errno value
+	 */
+	virtual void io_completed(int result) = 0;
+};
+
+
+/**
+ * Submission and completion queue shared with the Linux kernel
+ *
+ * Requests are prepared by the entrypoint and handed to the kernel in
+ * batches via 'submit'. Completions are signalled by the kernel via an
+ * eventfd, which is monitored by a dedicated thread. This thread wakes up
+ * the entrypoint, which dispatches the completions to the requests in the
+ * order of their arrival.
+ */
+class Lx_fs::Io_uring final : public Thread
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Io_uring(Io_uring const &);
+		Io_uring &operator = (Io_uring const &);
+
+		enum { ENTRIES = 256 };
+
+		struct Submission_queue
+		{
+			unsigned     *head    { nullptr };
+			unsigned     *tail    { nullptr };
+			unsigned     *mask    { nullptr };
+			unsigned     *array   { nullptr };
+			io_uring_sqe *sqes    { nullptr };
+			unsigned      entries { 0 };
+		};
+
+		struct Completion_queue
+		{
+			unsigned     *head    { nullptr };
+			unsigned     *tail    { nullptr };
+			unsigned     *mask    { nullptr };
+			io_uring_cqe *cqes    { nullptr };
+			unsigned      entries { 0 };
+		};
+
+		Env &_env;
+
+		int _ring_fd  { -1 };
+		int _event_fd { -1 };
+
+		void   *_sq_ring      { MAP_FAILED };
+		void   *_cq_ring      { MAP_FAILED };
+		void   *_sqes         { MAP_FAILED };
+		size_t  _sq_ring_size { 0 };
+		size_t  _cq_ring_size { 0 };
+		size_t  _sqes_size    { 0 };
+
+		Submission_queue _sq { };
+		Completion_queue _cq { };
+
+		/* local copy of the submission-queue tail, published by 'submit' */
+		unsigned _sq_tail { 0 };
+
+		/* number of prepared requests not yet handed to the kernel */
+		unsigned _unsubmitted { 0 };
+
+		/* number of requests handed out but not completed */
+		unsigned _in_flight { 0 };
+
+		/* set if 'submit' failed transiently and must be retried */
+		bool _retry_pending { false };
+
+		Signal_handler<Io_uring> _completion_handler {
+			_env.ep(), *this, &Io_uring::complete };
+
+		bool _setup();
+		void _cleanup();
+
+		io_uring_sqe *_alloc_sqe(Io_request &);
+
+		void entry() override;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param enabled  if false, no ring is set up and 'valid' returns
+		 *                 false, which makes the caller resort to
+		 *                 synchronous I/O
+		 */
+		Io_uring(Env &env, bool enabled);
+
+		~Io_uring();
+
+		bool valid() const { return _ring_fd >= 0; }
+
+		/**
+		 * Prepare operations
+		 *
+		 * \return false if the ring is unavailable or exhausted
+		 */
+		bool read (Io_request &, int fd, void *dst, size_t len, uint64_t offset);
+		bool write(Io_request &, int fd, void const *src, size_t len, uint64_t offset);
+		bool fsync(Io_request &, int fd);
+
+		/**
+		 * Hand prepared operations to the kernel
+		 */
+		void submit();
+
+		/**
+		 * Dispatch available completions to their requests
+		 */
+		void complete();
+
+		/**
+		 * Block until at least one request completed and dispatch completions
+		 */
+		void wait_for_completion();
+};
+
+#endif /* _IO_URING_H_ */
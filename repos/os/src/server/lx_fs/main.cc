@@ -27,6 +27,7 @@
 
 /* local includes */
 #include "directory.h"
+#include "io_uring.h"
 #include "notifier.h"
 #include "open_node.h"
 #include "watch.h"
@@ -100,6 +101,207 @@ class Lx_fs::Session_component : private Session_resources,
 		Absolute_path const          _root_dir;
 		Signal_handler               _process_packet_dispatcher;
 		Notifier                    &_notifier;
+		Io_uring                    &_io_uring;
+
+		/**
+		 * Packet processed asynchronously via the io_uring
+		 */
+		struct Async_packet : Io_request
+		{
+			enum class State { FREE, IN_FLIGHT, COMPLETED };
+
+			Session_component *session { nullptr };
+			Packet_descriptor  packet  { };
+			uint64_t           inode   { 0 };
+			State              state   { State::FREE };
+
+			void io_completed(int result) override {
+				session->_async_packet_completed(*this, result); }
+		};
+
+		enum { MAX_ASYNC_PACKETS = 32 };
+
+		Async_packet _async_packets[MAX_ASYNC_PACKETS] { };
+
+		/* number of async packets that are in flight or not yet acknowledged */
+		unsigned _num_async_packets = 0;
+
+		/* set while the session waits for its in-flight packets on close */
+		bool _closing = false;
+
+		static bool _positioned(Packet_descriptor const &p)
+		{
+			return (p.operation() == Packet_descriptor::READ
+			     || p.operation() == Packet_descriptor::WRITE)
+			    && p.position() != (seek_off_t)SEEK_TAIL;
+		}
+
+		static bool _overlapping(Packet_descriptor const &a, Packet_descriptor const &b)
+		{
+			return a.position() < b.position() + b.length()
+			    && b.position() < a.position() + a.length();
+		}
+
+		/**
+		 * Return true if 'packet' must not be processed before the in-flight
+		 * packets for the node 'inode' are completed
+		 *
+		 * Reads and writes of disjoint ranges may be in flight concurrently.
+		 * All other operations retain the order of their submission.
+		 */
+		bool _conflicts(Packet_descriptor const &packet, uint64_t inode) const
+		{
+			for (Async_packet const &ap : _async_packets) {
+
+				if (ap.state != Async_packet::State::IN_FLIGHT || ap.inode != inode)
+					continue;
+
+				Packet_descriptor const &other = ap.packet;
+
+				if (packet.operation() == Packet_descriptor::READ
+				 && other .operation() == Packet_descriptor::READ)
+					continue;
+
+				if (_positioned(packet) && _positioned(other)
+				 && !_overlapping(packet, other))
+					continue;
+
+				return true;
+			}
+			return false;
+		}
+
+		bool _must_wait(Packet_descriptor const &packet)
+		{
+			if (!_num_async_packets)
+				return false;
+
+			bool result = false;
+			try {
+				_open_node_registry.apply<Open_node>(packet.handle(), [&] (Open_node &open_node) {
+					result = _conflicts(packet, open_node.node().inode()); });
+			} catch (Id_space<File_system::Node>::Unknown_id const &) { }
+
+			return result;
+		}
+
+		/**
+		 * Hand packet to the io_uring
+		 *
+		 * \return true if the packet is processed asynchronously
+		 */
+		bool _submit_async(Packet_descriptor const &packet, Open_node &open_node)
+		{
+			int const fd = open_node.node().fd();
+			if (fd < 0 || !_io_uring.valid())
+				return false;
+
+			Async_packet *ap = nullptr;
+			for (Async_packet &candidate : _async_packets)
+				if (candidate.state == Async_packet::State::FREE) {
+					ap = &candidate;
+					break;
+				}
+
+			if (!ap)
+				return false;
+
+			ap->packet = packet;
+			ap->inode  = open_node.node().inode();
+
+			bool submitted = false;
+
+			switch (packet.operation()) {
+
+			case Packet_descriptor::READ:
+
+				/* io_uring interprets an offset of ~0 as the file position */
+				if (packet.position() == (seek_off_t)SEEK_TAIL)
+					return false;
+
+				submitted = _io_uring.read(*ap, fd, tx_sink()->packet_content(packet),
+				                           packet.length(), packet.position());
+				break;
+
+			case Packet_descriptor::WRITE:
+				if (packet.position() == (seek_off_t)SEEK_TAIL)
+					return false;
+
+				submitted = _io_uring.write(*ap, fd, tx_sink()->packet_content(packet),
+				                            packet.length(), packet.position());
+				break;
+
+			case Packet_descriptor::SYNC:
+				submitted = _io_uring.fsync(*ap, fd);
+				break;
+
+			default:
+				break;
+			}
+
+			if (!submitted)
+				return false;
+
+			ap->state = Async_packet::State::IN_FLIGHT;
+			_num_async_packets++;
+			return true;
+		}
+
+		void _async_packet_completed(Async_packet &ap, int const result)
+		{
+			Packet_descriptor &packet = ap.packet;
+
+			ap.state = Async_packet::State::COMPLETED;
+
+			switch (packet.operation()) {
+
+			case Packet_descriptor::READ:
+
+				/* read data or EOF is a success */
+				packet.length(result > 0 ? size_t(result) : 0);
+				packet.succeeded(result >= 0);
+				break;
+
+			case Packet_descriptor::WRITE:
+
+				/* File system session can't handle partial writes */
+				if (result < 0 || size_t(result) != packet.length()) {
+					/* don't acknowledge */
+					ap.state = Async_packet::State::FREE;
+					_num_async_packets--;
+					break;
+				}
+				packet.succeeded(true);
+				break;
+
+			case Packet_descriptor::SYNC:
+				packet.length(0);
+				packet.succeeded(result == 0);
+				break;
+
+			default:
+				break;
+			}
+
+			if (!_closing)
+				_process_packets();
+		}
+
+		void _acknowledge_completed_packets()
+		{
+			for (Async_packet &ap : _async_packets) {
+
+				if (ap.state != Async_packet::State::COMPLETED)
+					continue;
+
+				if (!tx_sink()->ready_to_ack())
+					return;
+
+				tx_sink()->acknowledge_packet(ap.packet);
+				ap.state = Async_packet::State::FREE;
+				_num_async_packets--;
+			}
+		}
 
 		/******************************
 		 ** Packet-stream processing **
@@ -122,6 +324,10 @@ class Lx_fs::Session_component : private Session_resources,
 
 			case Packet_descriptor::READ:
 				if (tx_sink()->packet_valid(packet) && (packet.length() <= packet.size())) {
+
+					if (_submit_async(packet, open_node))
+						return;
+
 					res_length = open_node.node().read((char *)tx_sink()->packet_content(packet), length,
 					                                   packet.position());
 
@@ -132,6 +338,10 @@ class Lx_fs::Session_component : private Session_resources,
 
 			case Packet_descriptor::WRITE:
 				if (tx_sink()->packet_valid(packet) && (packet.length() <= packet.size())) {
+
+					if (_submit_async(packet, open_node))
+						return;
+
 					res_length = open_node.node().write((char const *)tx_sink()->packet_content(packet),
 					                                    length,
 					                                    packet.position());
@@ -170,6 +380,10 @@ class Lx_fs::Session_component : private Session_resources,
 			case Packet_descriptor::SYNC:
 
 				if (tx_sink()->packet_valid(packet)) {
+
+					if (_submit_async(packet, open_node))
+						return;
+
 					succeeded = open_node.node().sync();
 				}
 
@@ -206,6 +420,8 @@ class Lx_fs::Session_component : private Session_resources,
 		 */
 		void _process_packets()
 		{
+			_acknowledge_completed_packets();
+
 			while (tx_sink()->packet_avail()) {
 
 				/*
@@ -219,12 +435,26 @@ class Lx_fs::Session_component : private Session_resources,
 				 * in '_process_packet' would infinitely block the context
 				 * of the main thread. The main thread is however needed
 				 * for receiving any subsequent 'ready-to-ack' signals.
+				 *
+				 * Each asynchronously processed packet needs an
+				 * acknowledgement slot once completed.
 				 */
-				if (!tx_sink()->ready_to_ack())
-					return;
+				if (tx_sink()->ack_slots_free() <= _num_async_packets)
+					break;
+
+				/*
+				 * Defer packets that depend on in-flight packets until
+				 * their completion.
+				 */
+				if (_num_async_packets == MAX_ASYNC_PACKETS
+				 || _must_wait(tx_sink()->peek_packet()))
+					break;
 
 				_process_packet();
 			}
+
+			/* hand all packets prepared by this batch to the kernel at once */
+			_io_uring.submit();
 		}
 
 		/**
@@ -296,7 +526,8 @@ class Lx_fs::Session_component : private Session_resources,
 		                  size_t               tx_buf_size,
 		                  char const          *root_dir,
 		                  bool                 writeable,
-		                  Notifier            &notifier)
+		                  Notifier            &notifier,
+		                  Io_uring            &io_uring)
 		:
 			Session_resources { env.ram(), env.rm(), ram_quota, cap_quota, tx_buf_size },
 			Session_rpc_object {_packet_ds.cap(), env.rm(), env.ep().rpc_ep() },
@@ -305,8 +536,12 @@ class Lx_fs::Session_component : private Session_resources,
 			_writeable { writeable },
 			_root_dir { root_dir },
 			_process_packet_dispatcher { env.ep(), *this, &Session_component::_process_packets },
-			_notifier { notifier }
+			_notifier { notifier },
+			_io_uring { io_uring }
 		{
+			for (Async_packet &ap : _async_packets)
+				ap.session = this;
+
 			/*
 			 * Register '_process_packets' dispatch function as signal
 			 * handler for packet-avail and ready-to-ack signals.
@@ -320,6 +555,17 @@ class Lx_fs::Session_component : private Session_resources,
 		 */
 		~Session_component()
 		{
+			/* the kernel must not access the packet buffer after the session is gone */
+			_closing = true;
+			auto in_flight = [&] {
+				for (Async_packet const &ap : _async_packets)
+					if (ap.state == Async_packet::State::IN_FLIGHT)
+						return true;
+				return false;
+			};
+			while (in_flight())
+				_io_uring.wait_for_completion();
+
 			List<List_element<Open_node>> node_list;
 
 			auto collect_fn = [&node_list, this] (Open_node &open_node) {
@@ -545,6 +791,8 @@ class Lx_fs::Root : public Root_component<Session_component>
 		Genode::Env                    &_env;
 		Genode::Attached_rom_dataspace  _config   { _env, "config" };
 		Notifier                        _notifier { _env };
+		Io_uring                        _io_uring { _env,
+		                                            _config.node().attribute_value("io_uring", true) };
 
 		static inline bool writeable_from_args(char const *args)
 		{
@@ -624,7 +872,7 @@ class Lx_fs::Root : public Root_component<Session_component>
 				                           Genode::Cap_quota { cap_quota },
 				                           tx_buf_size,
 				                           absolute_root_dir(root_dir).string(),
-				                           writeable, _notifier };
+				                           writeable, _notifier, _io_uring };
 
 				auto ram_used { _env.pd().used_ram().value - initial_ram_usage };
 				auto cap_used { _env.pd().used_caps().value - initial_cap_usage };
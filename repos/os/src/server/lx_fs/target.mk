@@ -1,6 +1,6 @@
 TARGET   = lx_fs
 REQUIRES = linux
-SRC_CC   = main.cc notifier.cc lx_util.cc watch.cc
+SRC_CC   = main.cc notifier.cc lx_util.cc watch.cc io_uring.cc
 LIBS     = lx_hybrid
 
 INC_DIR += $(PRG_DIR)
@@ -37,6 +37,7 @@ Configuration::Configuration(Node const &node, Allocator &alloc)
 	_verbose_domain_state           { false },
 	_trace_packets                  { false },
 	_icmp_echo_server               { false },
+	_link_table_capacity            { 0 },
 	_icmp_type_3_code_on_fragm_ipv4 { 0 },
 	_dhcp_discover_timeout          { 0 },
 	_dhcp_request_timeout           { 0 },
@@ -87,7 +88,8 @@ Configuration::Configuration(Env                             &env,
                              Cached_timer                    &timer,
                              Configuration                   &old_config,
                              Quota                     const &shared_quota,
-                             Interface_list                  &interfaces)
+                             Interface_list                  &interfaces,
+                             Interface_wakeups               &wakeups)
 :
 	_alloc                          { alloc },
 	_max_packets_per_signal         { node.attribute_value("max_packets_per_signal",    (unsigned long)50) },
@@ -97,6 +99,7 @@ Configuration::Configuration(Env                             &env,
 	_verbose_domain_state           { node.attribute_value("verbose_domain_state",      false) },
 	_trace_packets                  { node.attribute_value("trace_packets",             false) },
 	_icmp_echo_server               { node.attribute_value("icmp_echo_server",          true) },
+	_link_table_capacity            { node.attribute_value("link_table_capacity",       (unsigned long)256) },
 	_icmp_type_3_code_on_fragm_ipv4 { _init_icmp_type_3_code_on_fragm_ipv4(node) },
 	_dhcp_discover_timeout          { read_sec_attr(node,  "dhcp_discover_timeout_sec", 10) },
 	_dhcp_request_timeout           { read_sec_attr(node,  "dhcp_request_timeout_sec",  10) },
@@ -162,6 +165,9 @@ Configuration::Configuration(Env                             &env,
 				log("[", domain, "] deinitiated domain"); }
 		});
 	}
+	/* index the rules of the domains that remained valid */
+	_domains.for_each([&] (Domain &domain) { domain.build_rule_indices(); });
+
 	node.with_optional_sub_node("report", [&] (Node const &report_node) {
 		if (old_config._reporter_ptr) {
 			/* re-use existing reporter */
@@ -201,7 +207,8 @@ Configuration::Configuration(Env                             &env,
 			[&] /* no_match */ ()
 			{
 				Nic_client &nic_client = *new (_alloc) Nic_client { label, domain, alloc, _nic_clients, *this };
-				if (!nic_client.finish_construction(env, timer, interfaces, old_config._nic_clients))
+				if (!nic_client.finish_construction(env, timer, interfaces, wakeups,
+				                                    old_config._nic_clients))
 					destroy(_alloc, &nic_client);
 			}
 		);
@@ -39,6 +39,7 @@ class Net::Configuration
 		bool                    const  _verbose_domain_state;
 		bool                    const  _trace_packets;
 		bool                    const  _icmp_echo_server;
+		unsigned long           const  _link_table_capacity;
 		Icmp_packet::Code       const  _icmp_type_3_code_on_fragm_ipv4;
 		Genode::Microseconds    const  _dhcp_discover_timeout;
 		Genode::Microseconds    const  _dhcp_request_timeout;
@@ -78,7 +79,8 @@ class Net::Configuration
 		              Cached_timer                            &timer,
 		              Configuration                           &old_config,
 		              Quota                             const &shared_quota,
-		              Interface_list                          &interfaces);
+		              Interface_list                          &interfaces,
+		              Interface_wakeups                       &wakeups);
 
 		~Configuration();
 
@@ -96,6 +98,7 @@ class Net::Configuration
 		bool                  verbose_domain_state()           const { return _verbose_domain_state; }
 		bool                  trace_packets()                  const { return _trace_packets; }
 		bool                  icmp_echo_server()               const { return _icmp_echo_server; }
+		unsigned long         link_table_capacity()            const { return _link_table_capacity; }
 		Icmp_packet::Code     icmp_type_3_code_on_fragm_ipv4() const { return _icmp_type_3_code_on_fragm_ipv4; }
 		Genode::Microseconds  dhcp_discover_timeout()          const { return _dhcp_discover_timeout; }
 		Genode::Microseconds  dhcp_request_timeout()           const { return _dhcp_request_timeout; }
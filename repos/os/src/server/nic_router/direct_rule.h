@@ -16,6 +16,7 @@
 
 /* local includes */
 #include <ipv4_address_prefix.h>
+#include <ipv4_prefix_trie.h>
 #include <list.h>
 
 /* Genode includes */
@@ -64,47 +65,82 @@ struct Net::Direct_rule : Direct_rule_base,
 
 
 template <typename T>
-struct Net::Direct_rule_list : List<T>
+class Net::Direct_rule_list : public List<T>
 {
-	using Base = List<T>;
-
-	void
-	find_longest_prefix_match(Ipv4_address const &ip,
-	                          auto         const &handle_match,
-	                          auto         const &handle_no_match) const
-	{
-		/*
-		 * Simply handling the first match is sufficient as the list is
-		 * sorted by the prefix size in descending order.
-		 */
-		for (T const *rule_ptr = Base::first();
-		     rule_ptr != nullptr;
-		     rule_ptr = rule_ptr->next()) {
+	private:
+
+		using Base = List<T>;
 
-			if (rule_ptr->dst().prefix_matches(ip)) {
+		Ipv4_prefix_trie<T> _trie    { };
+		bool                _indexed { false };
+
+	public:
 
-				handle_match(*rule_ptr);
+		void
+		find_longest_prefix_match(Ipv4_address const &ip,
+		                          auto         const &handle_match,
+		                          auto         const &handle_no_match) const
+		{
+			if (_indexed) {
+				_trie.find_longest_prefix_match(ip, handle_match, handle_no_match);
 				return;
 			}
+			/*
+			 * Simply handling the first match is sufficient as the list is
+			 * sorted by the prefix size in descending order.
+			 */
+			for (T const *rule_ptr = Base::first();
+			     rule_ptr != nullptr;
+			     rule_ptr = rule_ptr->next()) {
+
+				if (rule_ptr->dst().prefix_matches(ip)) {
+
+					handle_match(*rule_ptr);
+					return;
+				}
+			}
+			handle_no_match();
 		}
-		handle_no_match();
-	}
-
-	void insert(T &rule)
-	{
-		/*
-		 * Ensure that the list stays sorted by the prefix size in descending
-		 * order.
+
+		void insert(T &rule)
+		{
+			/*
+			 * Ensure that the list stays sorted by the prefix size in descending
+			 * order.
+			 */
+			T *behind = nullptr;
+			for (T *curr = Base::first(); curr; curr = curr->next()) {
+				if (rule.dst().prefix >= curr->dst().prefix) {
+					break; }
+
+				behind = curr;
+			}
+			Base::insert(&rule, behind);
+		}
+
+		/**
+		 * Build the lookup index once all rules are inserted
+		 *
+		 * Rules are added in list order, so that the trie selects the same
+		 * rule for duplicate prefixes as the list walk did.
 		 */
-		T *behind = nullptr;
-		for (T *curr = Base::first(); curr; curr = curr->next()) {
-			if (rule.dst().prefix >= curr->dst().prefix) {
-				break; }
+		void build_index(Genode::Allocator &alloc)
+		{
+			if (_indexed)
+				return;
+
+			Base::for_each([&] (T const &rule) {
+				_trie.insert(alloc, rule.dst(), rule); });
+
+			_indexed = true;
+		}
 
-			behind = curr;
+		void destroy_each(Genode::Deallocator &dealloc)
+		{
+			_trie.destroy_each(dealloc);
+			_indexed = false;
+			Base::destroy_each(dealloc);
 		}
-		Base::insert(&rule, behind);
-	}
 };
 
 #endif /* _RULE_H_ */
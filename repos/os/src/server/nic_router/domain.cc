@@ -83,9 +83,9 @@ void Domain::_prepare_reconstructing_ip_config()
 		 * Destroy all link states
 		 *
 		 * Strictly speaking, it is not necessary to destroy all link states,
-		 * only those that this domain applies NAT to. However, the Genode AVL
-		 * tree is not built for removing a selection of nodes and trying to do
-		 * it anyways is complicated. So, for now, we simply destroy all links.
+		 * only those that this domain applies NAT to. However, the link tables
+		 * are not built for removing a selection of link sides while iterating
+		 * over them. So, for now, we simply destroy all links.
 		 */
 		while (Link_side *link_side = _icmp_links.first()) {
 			Link &link { link_side->link() };
@@ -255,6 +255,8 @@ Domain::Domain(Configuration     &config,
 	_config              { config },
 	_node                { alloc, node },
 	_alloc               { alloc },
+	_link_table_capacity { node.attribute_value("link_table_capacity",
+	                                            config.link_table_capacity()) },
 	_ip_config           { node, alloc },
 	_verbose_packets     { node.attribute_value("verbose_packets",
 	                                            config.verbose_packets()) },
@@ -284,7 +286,7 @@ bool Domain::finish_construction() const
 }
 
 
-Link_side_tree &Domain::links(L3_protocol const protocol)
+Link_side_table &Domain::links(L3_protocol const protocol)
 {
 	switch (protocol) {
 	case L3_protocol::TCP:  return _tcp_links;
@@ -382,6 +384,15 @@ bool Domain::init(Domain_dict &domains)
 }
 
 
+void Domain::build_rule_indices()
+{
+	_ip_rules.build_index(_alloc);
+	_icmp_rules.build_index(_alloc);
+	_tcp_rules.build_index(_alloc);
+	_udp_rules.build_index(_alloc);
+}
+
+
 void Domain::deinit()
 {
 	_ip_rules.destroy_each(_alloc);
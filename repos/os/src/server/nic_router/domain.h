@@ -91,6 +91,7 @@ class Net::Domain : public List<Domain>::Element,
 		Configuration                        &_config;
 		Genode::Buffered_node           const _node;
 		Genode::Allocator                    &_alloc;
+		Genode::size_t                  const _link_table_capacity;
 		Ip_rule_list                          _ip_rules             { };
 		Forward_rule_tree                     _tcp_forward_rules    { };
 		Forward_rule_tree                     _udp_forward_rules    { };
@@ -109,9 +110,9 @@ class Net::Domain : public List<Domain>::Element,
 		List<Domain>                          _ip_config_dependents { };
 		Arp_cache                             _arp_cache            { *this };
 		Arp_waiter_list                       _foreign_arp_waiters  { };
-		Link_side_tree                        _tcp_links            { };
-		Link_side_tree                        _udp_links            { };
-		Link_side_tree                        _icmp_links           { };
+		Link_side_table                       _tcp_links            { _alloc, _link_table_capacity };
+		Link_side_table                       _udp_links            { _alloc, _link_table_capacity };
+		Link_side_table                       _icmp_links           { _alloc, _link_table_capacity };
 		Genode::size_t                        _tx_bytes             { 0 };
 		Genode::size_t                        _rx_bytes             { 0 };
 		bool                            const _verbose_packets;
@@ -178,6 +179,13 @@ class Net::Domain : public List<Domain>::Element,
 
 		[[nodiscard]] bool init(Domain_dict &domains);
 
+		/**
+		 * Build lookup indices of the IP, ICMP, TCP, and UDP rules
+		 *
+		 * Must be called once the domain is initialized successfully.
+		 */
+		void build_rule_indices();
+
 		void deinit();
 
 		void with_next_hop(Ipv4_address const &ip, auto const &ok_fn, auto const &error_fn) const
@@ -196,7 +204,7 @@ class Net::Domain : public List<Domain>::Element,
 
 		void try_reuse_ip_config(Domain const &domain);
 
-		Link_side_tree &links(L3_protocol const protocol);
+		Link_side_table &links(L3_protocol const protocol);
 
 		void attach_interface(Interface &interface);
 
@@ -264,9 +272,9 @@ class Net::Domain : public List<Domain>::Element,
 		Configuration               &config()              const { return _config; }
 		Arp_cache                   &arp_cache()                 { return _arp_cache; }
 		Arp_waiter_list             &foreign_arp_waiters()       { return _foreign_arp_waiters; }
-		Link_side_tree              &tcp_links()                 { return _tcp_links; }
-		Link_side_tree              &udp_links()                 { return _udp_links; }
-		Link_side_tree              &icmp_links()                { return _icmp_links; }
+		Link_side_table             &tcp_links()                 { return _tcp_links; }
+		Link_side_table             &udp_links()                 { return _udp_links; }
+		Link_side_table             &icmp_links()                { return _icmp_links; }
 		Domain_link_stats           &udp_stats()                 { return _udp_stats; }
 		Domain_link_stats           &tcp_stats()                 { return _tcp_stats; }
 		Domain_link_stats           &icmp_stats()                { return _icmp_stats; }
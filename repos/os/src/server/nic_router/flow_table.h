@@ -0,0 +1,212 @@
+/*
+ * \brief  Hash table for looking up connection-tracking state
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _FLOW_TABLE_H_
+#define _FLOW_TABLE_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <util/list.h>
+
+namespace Net { template <typename> class Flow_table; }
+
+
+/**
+ * Hash table of flows, e.g., link sides, keyed by their ID
+ *
+ * The table uses open addressing with linear probing. Each slot caches the
+ * hash of its flow, so probing touches the slot array only, up to the final
+ * comparison of the matching flow. The slot array is allocated once with a
+ * fixed capacity and kept at a load factor of at most 1/2. Flows beyond the
+ * capacity are kept in an overflow list, which is searched linearly.
+ *
+ * 'T' must be a 'Genode::List<T>::Element' and provide an 'id()' method
+ * whose result provides 'hash()' and 'operator !='.
+ */
+template <typename T>
+class Net::Flow_table
+{
+	private:
+
+		struct Slot
+		{
+			Genode::uint32_t  hash;
+			T                *flow;
+		};
+
+		Genode::Allocator    &_alloc;
+		Genode::size_t const  _max_hashed;
+		Genode::size_t const  _capacity   { _capacity_for(_max_hashed) };
+		Slot                 *_slots      { _alloc_slots(_alloc, _capacity) };
+		Genode::size_t        _count      { 0 };
+		Genode::List<T>       _overflow   { };
+
+		/* all slots below this index are empty */
+		Genode::size_t        _first_hint { 0 };
+
+		/**
+		 * Return power of two that holds 'max_hashed' flows at load 1/2
+		 */
+		static Genode::size_t _capacity_for(Genode::size_t max_hashed)
+		{
+			Genode::size_t capacity = max_hashed ? 2 : 0;
+			while (capacity && capacity < 2*max_hashed)
+				capacity *= 2;
+
+			return capacity;
+		}
+
+		static Slot *_alloc_slots(Genode::Allocator &alloc, Genode::size_t capacity)
+		{
+			using namespace Genode;
+
+			if (!capacity)
+				return nullptr;
+
+			return alloc.try_alloc(capacity*sizeof(Slot)).template convert<Slot *>(
+				[&] (Allocator::Allocation &a) {
+					a.deallocate = false;
+					Slot *slots = (Slot *)a.ptr;
+					for (size_t i = 0; i < capacity; i++)
+						slots[i] = { .hash = 0, .flow = nullptr };
+					return slots; },
+				[&] (Alloc_error) { return (Slot *)nullptr; });
+		}
+
+		bool _hashable() const { return _slots && _count < _max_hashed; }
+
+		Genode::size_t _index(Genode::uint32_t hash) const {
+			return hash & (_capacity - 1); }
+
+		Genode::size_t _next(Genode::size_t i) const {
+			return (i + 1) & (_capacity - 1); }
+
+		void _insert_slot(Genode::uint32_t hash, T &flow)
+		{
+			Genode::size_t i = _index(hash);
+			while (_slots[i].flow)
+				i = _next(i);
+
+			_slots[i] = { .hash = hash, .flow = &flow };
+			_count++;
+
+			if (i < _first_hint)
+				_first_hint = i;
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Flow_table(Flow_table const &);
+		Flow_table &operator = (Flow_table const &);
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param max_hashed  number of flows kept in the slot array
+		 *
+		 * If the slot array cannot be allocated, all flows are kept in the
+		 * overflow list.
+		 */
+		Flow_table(Genode::Allocator &alloc, Genode::size_t max_hashed)
+		: _alloc(alloc), _max_hashed(max_hashed) { }
+
+		~Flow_table()
+		{
+			if (_slots)
+				_alloc.free(_slots, _capacity*sizeof(Slot));
+		}
+
+		void insert(T *flow)
+		{
+			if (_hashable())
+				_insert_slot(flow->id().hash(), *flow);
+			else
+				_overflow.insert(flow);
+		}
+
+		void remove(T *flow)
+		{
+			Genode::size_t i = _capacity;
+			if (_slots) {
+				for (Genode::size_t j = _index(flow->id().hash()); _slots[j].flow; j = _next(j)) {
+					if (_slots[j].flow == flow) {
+						i = j;
+						break;
+					}
+				}
+			}
+			if (i == _capacity) {
+				_overflow.remove(flow);
+				return;
+			}
+			/*
+			 * Shift subsequent slots of the probe sequence backwards, so that
+			 * lookups never stop at the slot freed.
+			 */
+			for (Genode::size_t j = _next(i); _slots[j].flow; j = _next(j)) {
+
+				Genode::size_t const home = _index(_slots[j].hash);
+				bool const movable = (i <= j) ? (home <= i || home > j)
+				                              : (home <= i && home > j);
+				if (movable) {
+					_slots[i] = _slots[j];
+					i = j;
+				}
+			}
+			_slots[i] = { .hash = 0, .flow = nullptr };
+			_count--;
+
+			/* move a flow of the overflow list into the slot freed */
+			if (T *overflow_flow = _overflow.first()) {
+				_overflow.remove(overflow_flow);
+				_insert_slot(overflow_flow->id().hash(), *overflow_flow);
+			}
+		}
+
+		/**
+		 * Return any flow of the table, or nullptr if empty
+		 */
+		T *first()
+		{
+			for (; _slots && _first_hint < _capacity; _first_hint++)
+				if (_slots[_first_hint].flow)
+					return _slots[_first_hint].flow;
+
+			return _overflow.first();
+		}
+
+		void find_by_id(auto const &id, auto const &handle_match, auto const &handle_no_match) const
+		{
+			if (_slots) {
+				Genode::uint32_t const hash = id.hash();
+				for (Genode::size_t i = _index(hash); _slots[i].flow; i = _next(i)) {
+					if (_slots[i].hash == hash && !(_slots[i].flow->id() != id)) {
+						handle_match(*(T const *)_slots[i].flow);
+						return;
+					}
+				}
+			}
+			for (T const *flow = _overflow.first(); flow; flow = flow->next()) {
+				if (!(flow->id() != id)) {
+					handle_match(*flow);
+					return;
+				}
+			}
+			handle_no_match();
+		}
+};
+
+#endif /* _FLOW_TABLE_H_ */
@@ -162,27 +162,25 @@ static void _link_packet(L3_protocol  const  prot,
 }
 
 
-static void _update_checksum(L3_protocol   const prot,
-                             void         *const prot_base,
-                             size_t        const prot_size,
-                             Ipv4_address  const src,
-                             Ipv4_address  const dst,
-                             size_t        const ip_size)
+static void _update_checksum(L3_protocol            const  prot,
+                             void                  *const  prot_base,
+                             Internet_checksum_diff const &ip_icd,
+                             Internet_checksum_diff const &prot_icd)
 {
+	/* the TCP and UDP checksum also covers the IP addresses */
+	Internet_checksum_diff icd { prot_icd };
 	switch (prot) {
 	case L3_protocol::TCP:
-		((Tcp_packet *)prot_base)->update_checksum(src, dst, prot_size);
+		icd.add_up_diff(ip_icd);
+		((Tcp_packet *)prot_base)->update_checksum(icd);
 		return;
 	case L3_protocol::UDP:
-		((Udp_packet *)prot_base)->update_checksum(src, dst);
+		icd.add_up_diff(ip_icd);
+		((Udp_packet *)prot_base)->update_checksum(icd);
 		return;
 	case L3_protocol::ICMP:
-		{
-			Icmp_packet &icmp = *(Icmp_packet *)prot_base;
-			icmp.update_checksum(ip_size - sizeof(Ipv4_packet) -
-			                               sizeof(Icmp_packet));
-			return;
-		}
+		((Icmp_packet *)prot_base)->update_checksum(icd);
+		return;
 	default: ASSERT_NEVER_REACHED; }
 }
 
@@ -197,14 +195,15 @@ static Port _dst_port(L3_protocol const prot, void *const prot_base)
 }
 
 
-static void _dst_port(L3_protocol  const prot,
-                      void        *const prot_base,
-                      Port         const port)
+static void _dst_port(L3_protocol             const  prot,
+                      void                   *const  prot_base,
+                      Port                    const  port,
+                      Internet_checksum_diff        &icd)
 {
 	switch (prot) {
-	case L3_protocol::TCP:  (*(Tcp_packet *)prot_base).dst_port(port);  return;
-	case L3_protocol::UDP:  (*(Udp_packet *)prot_base).dst_port(port);  return;
-	case L3_protocol::ICMP: (*(Icmp_packet *)prot_base).query_id(port.value); return;
+	case L3_protocol::TCP:  (*(Tcp_packet *)prot_base).dst_port(port, icd);  return;
+	case L3_protocol::UDP:  (*(Udp_packet *)prot_base).dst_port(port, icd);  return;
+	case L3_protocol::ICMP: (*(Icmp_packet *)prot_base).query_id(port.value, icd); return;
 	default: ASSERT_NEVER_REACHED; }
 }
 
@@ -219,14 +218,15 @@ static Port _src_port(L3_protocol const prot, void *const prot_base)
 }
 
 
-static void _src_port(L3_protocol  const prot,
-                      void        *const prot_base,
-                      Port         const port)
+static void _src_port(L3_protocol             const  prot,
+                      void                   *const  prot_base,
+                      Port                    const  port,
+                      Internet_checksum_diff        &icd)
 {
 	switch (prot) {
-	case L3_protocol::TCP:  ((Tcp_packet *)prot_base)->src_port(port);        return;
-	case L3_protocol::UDP:  ((Udp_packet *)prot_base)->src_port(port);        return;
-	case L3_protocol::ICMP: ((Icmp_packet *)prot_base)->query_id(port.value); return;
+	case L3_protocol::TCP:  ((Tcp_packet *)prot_base)->src_port(port, icd);        return;
+	case L3_protocol::UDP:  ((Udp_packet *)prot_base)->src_port(port, icd);        return;
+	case L3_protocol::ICMP: ((Icmp_packet *)prot_base)->query_id(port.value, icd); return;
 	default: ASSERT_NEVER_REACHED; }
 }
 
@@ -332,12 +332,11 @@ void Interface::_pass_prot_to_domain(Domain                       &domain,
                                      Size_guard                   &size_guard,
                                      Ipv4_packet                  &ip,
                                      Internet_checksum_diff const &ip_icd,
+                                     Internet_checksum_diff const &prot_icd,
                                      L3_protocol            const  prot,
-                                     void                  *const  prot_base,
-                                     size_t                 const  prot_size)
+                                     void                  *const  prot_base)
 {
-	_update_checksum(
-		prot, prot_base, prot_size, ip.src(), ip.dst(), ip.total_length());
+	_update_checksum(prot, prot_base, ip_icd, prot_icd);
 
 	ip.update_checksum(ip_icd);
 	domain.interfaces().for_each([&] (Interface &interface)
@@ -648,9 +647,9 @@ Packet_result Interface::_nat_link_and_pass(Ethernet_frame         &eth,
                                             Size_guard             &size_guard,
                                             Ipv4_packet            &ip,
                                             Internet_checksum_diff &ip_icd,
+                                            Internet_checksum_diff &prot_icd,
                                             L3_protocol      const  prot,
                                             void            *const  prot_base,
-                                            size_t           const  prot_size,
                                             Link_side_id     const &local_id,
                                             Domain                 &local_domain,
                                             Domain                 &remote_domain)
@@ -667,7 +666,7 @@ Packet_result Interface::_nat_link_and_pass(Ethernet_frame         &eth,
 			Port src_port(0);
 			nat.port_alloc(prot).alloc().with_result(
 				[&] (Port src_port) {
-					_src_port(prot, prot_base, src_port);
+					_src_port(prot, prot_base, src_port, prot_icd);
 					ip.src(remote_domain.ip_config().interface().address, ip_icd);
 					remote_port_alloc_ptr = &nat.port_alloc(prot); },
 				[&] (auto) {
@@ -689,7 +688,7 @@ Packet_result Interface::_nat_link_and_pass(Ethernet_frame         &eth,
 	if (result.valid())
 		return result;
 
-	_pass_prot_to_domain(remote_domain, eth, size_guard, ip, ip_icd, prot, prot_base, prot_size);
+	_pass_prot_to_domain(remote_domain, eth, size_guard, ip, ip_icd, prot_icd, prot, prot_base);
 	return packet_handled();
 }
 
@@ -1077,10 +1076,10 @@ Packet_result Interface::_handle_icmp_query(Ethernet_frame          &eth,
                                             Size_guard              &size_guard,
                                             Ipv4_packet             &ip,
                                             Internet_checksum_diff  &ip_icd,
+                                            Internet_checksum_diff  &prot_icd,
                                             Packet_descriptor const &pkt,
                                             L3_protocol              prot,
                                             void                    *prot_base,
-                                            size_t                   prot_size,
                                             Domain                  &local_domain)
 {
 	Packet_result result { };
@@ -1105,11 +1104,11 @@ Packet_result Interface::_handle_icmp_query(Ethernet_frame          &eth,
 				return;
 			ip.src(remote_side.dst_ip(), ip_icd);
 			ip.dst(remote_side.src_ip(), ip_icd);
-			_src_port(prot, prot_base, remote_side.dst_port());
-			_dst_port(prot, prot_base, remote_side.src_port());
+			_src_port(prot, prot_base, remote_side.dst_port(), prot_icd);
+			_dst_port(prot, prot_base, remote_side.src_port(), prot_icd);
 			_pass_prot_to_domain(
-				remote_domain, eth, size_guard, ip, ip_icd, prot,
-				prot_base, prot_size);
+				remote_domain, eth, size_guard, ip, ip_icd, prot_icd, prot,
+				prot_base);
 
 			_link_packet(prot, prot_base, link, client);
 			result = packet_handled();
@@ -1132,7 +1131,7 @@ Packet_result Interface::_handle_icmp_query(Ethernet_frame          &eth,
 			if (result.valid())
 				return;
 			result = _nat_link_and_pass(
-				eth, size_guard, ip, ip_icd, prot, prot_base, prot_size, local_id, local_domain, remote_domain);
+				eth, size_guard, ip, ip_icd, prot_icd, prot, prot_base, local_id, local_domain, remote_domain);
 		},
 		[&] /* handle_no_match */ () { }
 	);
@@ -1146,12 +1145,12 @@ Packet_result Interface::_handle_icmp_error(Ethernet_frame          &eth,
                                             Internet_checksum_diff  &ip_icd,
                                             Packet_descriptor const &pkt,
                                             Domain                  &local_domain,
-                                            Icmp_packet             &icmp,
-                                            size_t                   icmp_sz)
+                                            Icmp_packet             &icmp)
 {
 	Packet_result result { };
 	Ipv4_packet            &embed_ip     { icmp.data<Ipv4_packet>(size_guard) };
 	Internet_checksum_diff  embed_ip_icd { };
+	Internet_checksum_diff  icmp_icd     { };
 
 	/* drop packet if embedded IP checksum invalid */
 	if (embed_ip.checksum_error()) {
@@ -1190,12 +1189,17 @@ Packet_result Interface::_handle_icmp_error(Ethernet_frame          &eth,
 			/* adapt source and destination of embedded IP and transport packet */
 			embed_ip.src(remote_side.src_ip(), embed_ip_icd);
 			embed_ip.dst(remote_side.dst_ip(), embed_ip_icd);
-			_src_port(embed_prot, embed_prot_base, remote_side.src_port());
-			_dst_port(embed_prot, embed_prot_base, remote_side.dst_port());
-
-			/* update checksum of both IP headers and the ICMP header */
-			embed_ip.update_checksum(embed_ip_icd);
-			icmp.update_checksum(icmp_sz - sizeof(Icmp_packet));
+			_src_port(embed_prot, embed_prot_base, remote_side.src_port(), icmp_icd);
+			_dst_port(embed_prot, embed_prot_base, remote_side.dst_port(), icmp_icd);
+
+			/*
+			 * Update checksum of both IP headers and the ICMP header. The
+			 * ICMP checksum covers the embedded IP header including its
+			 * checksum.
+			 */
+			icmp_icd.add_up_diff(embed_ip_icd);
+			embed_ip.update_checksum(embed_ip_icd, icmp_icd);
+			icmp.update_checksum(icmp_icd);
 			ip.update_checksum(ip_icd);
 
 			/* send adapted packet to all interfaces of remote domain */
@@ -1220,6 +1224,7 @@ Packet_result Interface::_handle_icmp(Ethernet_frame            &eth,
                                       Size_guard                &size_guard,
                                       Ipv4_packet               &ip,
                                       Internet_checksum_diff    &ip_icd,
+                                      Internet_checksum_diff    &prot_icd,
                                       Packet_descriptor   const &pkt,
                                       L3_protocol                prot,
                                       void                      *prot_base,
@@ -1247,8 +1252,8 @@ Packet_result Interface::_handle_icmp(Ethernet_frame            &eth,
 	/* try to act as ICMP router */
 	switch (icmp.type()) {
 	case Icmp_packet::Type::ECHO_REPLY:
-	case Icmp_packet::Type::ECHO_REQUEST: result = _handle_icmp_query(eth, size_guard, ip, ip_icd, pkt, prot, prot_base, prot_size, local_domain); break;
-	case Icmp_packet::Type::DST_UNREACHABLE: result = _handle_icmp_error(eth, size_guard, ip, ip_icd, pkt, local_domain, icmp, prot_size); break;
+	case Icmp_packet::Type::ECHO_REQUEST: result = _handle_icmp_query(eth, size_guard, ip, ip_icd, prot_icd, pkt, prot, prot_base, local_domain); break;
+	case Icmp_packet::Type::DST_UNREACHABLE: result = _handle_icmp_error(eth, size_guard, ip, ip_icd, pkt, local_domain, icmp); break;
 	default: result = packet_drop("unhandled type in ICMP"); }
 	return result;
 }
@@ -1260,8 +1265,9 @@ Packet_result Interface::_handle_ip(Ethernet_frame          &eth,
                                     Domain                  &local_domain)
 {
 	Packet_result result { };
-	Ipv4_packet            &ip     { eth.data<Ipv4_packet>(size_guard) };
-	Internet_checksum_diff  ip_icd { };
+	Ipv4_packet            &ip       { eth.data<Ipv4_packet>(size_guard) };
+	Internet_checksum_diff  ip_icd   { };
+	Internet_checksum_diff  prot_icd { };
 
 	/* drop fragmented IPv4 as it isn't supported */
 	Ipv4_address_prefix const &local_intf = local_domain.ip_config().interface();
@@ -1332,7 +1338,7 @@ Packet_result Interface::_handle_ip(Ethernet_frame          &eth,
 			}
 		}
 		if (prot == L3_protocol::ICMP) {
-			result = _handle_icmp(eth, size_guard, ip, ip_icd, pkt, prot, prot_base,
+			result = _handle_icmp(eth, size_guard, ip, ip_icd, prot_icd, pkt, prot, prot_base,
 			                      prot_size, local_domain, local_intf);
 		} else {
 
@@ -1359,11 +1365,11 @@ Packet_result Interface::_handle_ip(Ethernet_frame          &eth,
 						return;
 					ip.src(remote_side.dst_ip(), ip_icd);
 					ip.dst(remote_side.src_ip(), ip_icd);
-					_src_port(prot, prot_base, remote_side.dst_port());
-					_dst_port(prot, prot_base, remote_side.src_port());
+					_src_port(prot, prot_base, remote_side.dst_port(), prot_icd);
+					_dst_port(prot, prot_base, remote_side.src_port(), prot_icd);
 					_pass_prot_to_domain(
-						remote_domain, eth, size_guard, ip, ip_icd, prot,
-						prot_base, prot_size);
+						remote_domain, eth, size_guard, ip, ip_icd, prot_icd,
+						prot, prot_base);
 
 					_link_packet(prot, prot_base, link, client);
 					result = packet_handled();
@@ -1386,11 +1392,11 @@ Packet_result Interface::_handle_ip(Ethernet_frame          &eth,
 						return;
 					ip.dst(rule.to_ip(), ip_icd);
 					if (!(rule.to_port() == Port(0))) {
-						_dst_port(prot, prot_base, rule.to_port());
+						_dst_port(prot, prot_base, rule.to_port(), prot_icd);
 					}
 					result = _nat_link_and_pass(
-						eth, size_guard, ip, ip_icd, prot, prot_base,
-						prot_size, local_id, local_domain, remote_domain);
+						eth, size_guard, ip, ip_icd, prot_icd, prot, prot_base,
+						local_id, local_domain, remote_domain);
 				});
 				if (result.valid())
 					return result;
@@ -1408,7 +1414,7 @@ Packet_result Interface::_handle_ip(Ethernet_frame          &eth,
 					if (result.valid())
 						return;
 					result = _nat_link_and_pass(
-						eth, size_guard, ip, ip_icd, prot, prot_base, prot_size,
+						eth, size_guard, ip, ip_icd, prot_icd, prot, prot_base,
 						local_id, local_domain, remote_domain);
 				});
 		}
@@ -1706,15 +1712,12 @@ void Interface::_handle_pkt_stream_signal()
 	 * submit queue and might have forwarded it to any interface. We may have
 	 * also removed acks from our sink's ack queue.
 	 *
-	 * We therefore wakeup all sources and our sink. Note that the packet-stream
-	 * API takes care of emitting only the signals that are actually needed.
+	 * We therefore wakeup ourselves and each interface that a packet was
+	 * submitted to or acknowledged at. Note that the packet-stream API takes
+	 * care of emitting only the signals that are actually needed.
 	 */
-	_config_ptr->domains().for_each([&] (Domain &domain) {
-		domain.interfaces().for_each([&] (Interface &interface) {
-			interface.wakeup_source();
-		});
-	});
-	wakeup_sink();
+	_wakeup_later();
+	_wakeups.wakeup_all();
 }
 
 
@@ -1894,6 +1897,34 @@ void Interface::_send_submit_pkt(Packet_descriptor &pkt,
 		                               pkt_size);
 
 	_source.try_submit_packet(pkt);
+	_wakeup_later();
+}
+
+
+void Interface::_wakeup_later()
+{
+	if (_wakeup_pending)
+		return;
+
+	_wakeup_pending = true;
+	_wakeups.insert(_wakeups_elem);
+}
+
+
+void Interface::_wakeup()
+{
+	_wakeup_pending = false;
+	_source.wakeup();
+	_sink.wakeup();
+}
+
+
+void Interface_wakeups::wakeup_all()
+{
+	while (Element *elem = _pending.first()) {
+		_pending.remove(elem);
+		elem->object()->_wakeup();
+	}
 }
 
 
@@ -1904,6 +1935,7 @@ Interface::Interface(Genode::Entrypoint     &ep,
                      Mac_address      const  mac,
                      Configuration          &config,
                      Interface_list         &interfaces,
+                     Interface_wakeups      &wakeups,
                      Packet_stream_sink     &sink,
                      Packet_stream_source   &source,
                      Interface_policy       &policy)
@@ -1917,7 +1949,8 @@ Interface::Interface(Genode::Entrypoint     &ep,
 	_policy                    { policy },
 	_timer                     { timer },
 	_alloc                     { alloc },
-	_interfaces                { interfaces }
+	_interfaces                { interfaces },
+	_wakeups                   { wakeups }
 {
 	_interfaces.insert(this);
 	_config_ptr->with_report([&] (Report &r) { r.handle_interface_link_state(); });
@@ -2289,6 +2322,7 @@ void Interface::_ack_packet(Packet_descriptor const &pkt)
 		}
 		return;
 	}
+	_wakeup_later();
 }
 
 
@@ -2306,6 +2340,9 @@ Interface::~Interface()
 	_config_ptr->with_report([&] (Report &r) { r.handle_interface_link_state(); });
 	_detach_from_domain();
 	_interfaces.remove(this);
+
+	if (_wakeup_pending)
+		_wakeups.remove(_wakeups_elem);
 }
 
 
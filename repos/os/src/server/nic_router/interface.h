@@ -55,6 +55,7 @@ namespace Net {
 	class Interface_policy;
 	class Interface;
 	using Interface_list = List<Interface>;
+	class Interface_wakeups;
 	class Interface_link_stats;
 	class Interface_object_stats;
 	class Dhcp_server;
@@ -117,10 +118,37 @@ struct Net::Interface_policy : Genode::Interface
 };
 
 
+/**
+ * Interfaces with packet-stream signals pending
+ *
+ * A packet handled by one interface may be submitted to or acknowledged at
+ * any other interface. Each interface registers here on its first submit
+ * or acknowledgement, so that the signal handler can limit the wakeups to
+ * the interfaces actually touched.
+ */
+class Net::Interface_wakeups : Genode::Noncopyable
+{
+	private:
+
+		using Element = Genode::List_element<Interface>;
+
+		Genode::List<Element> _pending { };
+
+	public:
+
+		void insert(Element &elem) { _pending.insert(&elem); }
+
+		void remove(Element &elem) { _pending.remove(&elem); }
+
+		void wakeup_all();
+};
+
+
 class Net::Interface : private Interface_list::Element
 {
 	friend class List<Interface>;
 	friend class Genode::List<Interface>;
+	friend class Interface_wakeups;
 
 	private:
 
@@ -165,6 +193,9 @@ class Net::Interface : private Interface_list::Element
 		Dhcp_allocation_list                  _released_dhcp_allocations { };
 		Genode::Constructible<Dhcp_client>    _dhcp_client               { };
 		Interface_list                       &_interfaces;
+		Interface_wakeups                    &_wakeups;
+		Genode::List_element<Interface>       _wakeups_elem              { this };
+		bool                                  _wakeup_pending            { false };
 		Genode::Constructible<Update_domain>  _update_domain             { };
 		Interface_link_stats                  _udp_stats                 { };
 		Interface_link_stats                  _tcp_stats                 { };
@@ -250,10 +281,10 @@ class Net::Interface : private Interface_list::Element
 		                                Size_guard              &size_guard,
 		                                Ipv4_packet             &ip,
 		                                Internet_checksum_diff  &ip_icd,
+		                                Internet_checksum_diff  &prot_icd,
 		                                Packet_descriptor const &pkt,
 		                                L3_protocol              prot,
 		                                void                    *prot_base,
-		                                Genode::size_t           prot_size,
 		                                Domain                  &local_domain);
 
 		[[nodiscard]] Packet_result _handle_icmp_error(Ethernet_frame          &eth,
@@ -262,13 +293,13 @@ class Net::Interface : private Interface_list::Element
 		                                              Internet_checksum_diff  &ip_icd,
 		                                              Packet_descriptor const &pkt,
 		                                              Domain                  &local_domain,
-		                                              Icmp_packet             &icmp,
-		                                              Genode::size_t           icmp_sz);
+		                                              Icmp_packet             &icmp);
 
 		[[nodiscard]] Packet_result _handle_icmp(Ethernet_frame            &eth,
 		                                        Size_guard                &size_guard,
 		                                        Ipv4_packet               &ip,
 		                                        Internet_checksum_diff    &ip_icd,
+		                                        Internet_checksum_diff    &prot_icd,
 		                                        Packet_descriptor   const &pkt,
 		                                        L3_protocol                prot,
 		                                        void                      *prot_base,
@@ -285,9 +316,9 @@ class Net::Interface : private Interface_list::Element
 		                                              Size_guard             &size_guard,
 		                                              Ipv4_packet            &ip,
 		                                              Internet_checksum_diff &ip_icd,
+		                                              Internet_checksum_diff &prot_icd,
 		                                              L3_protocol      const  prot,
 		                                              void            *const  prot_base,
-		                                              Genode::size_t   const  prot_size,
 		                                              Link_side_id     const &local_id,
 		                                              Domain                 &local_domain,
 		                                              Domain                 &remote_domain);
@@ -304,9 +335,9 @@ class Net::Interface : private Interface_list::Element
 		                          Size_guard                   &size_guard,
 		                          Ipv4_packet                  &ip,
 		                          Internet_checksum_diff const &ip_icd,
+		                          Internet_checksum_diff const &prot_icd,
 		                          L3_protocol            const  prot,
-		                          void                  *const  prot_base,
-		                          Genode::size_t         const  prot_size);
+		                          void                  *const  prot_base);
 
 		void _handle_pkt();
 
@@ -327,6 +358,13 @@ class Net::Interface : private Interface_list::Element
 
 		void _ack_packet(Packet_descriptor const &pkt);
 
+		/**
+		 * Register for a wakeup at the end of the current signal handler
+		 */
+		void _wakeup_later();
+
+		void _wakeup();
+
 		void _send_submit_pkt(Genode::Packet_descriptor   &pkt,
 		                      void                      * &pkt_base,
 		                      Genode::size_t               pkt_size);
@@ -386,6 +424,7 @@ class Net::Interface : private Interface_list::Element
 		          Mac_address      const  mac,
 		          Configuration          &config,
 		          Interface_list         &interfaces,
+		          Interface_wakeups      &wakeups,
 		          Packet_stream_sink     &sink,
 		          Packet_stream_source   &source,
 		          Interface_policy       &policy);
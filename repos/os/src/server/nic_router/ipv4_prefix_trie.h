@@ -0,0 +1,173 @@
+/*
+ * \brief  Path-compressed binary trie for IPv4 longest-prefix matching
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _IPV4_PREFIX_TRIE_H_
+#define _IPV4_PREFIX_TRIE_H_
+
+/* local includes */
+#include <ipv4_address_prefix.h>
+
+/* Genode includes */
+#include <base/allocator.h>
+
+namespace Net { template <typename> class Ipv4_prefix_trie; }
+
+
+/**
+ * Index of objects by IPv4 prefix
+ *
+ * Each node stands for a prefix. Nodes without an object only exist where
+ * the paths of two prefixes diverge. A lookup visits at most one node per
+ * bit of the address, independent from the number of prefixes inserted.
+ */
+template <typename T>
+class Net::Ipv4_prefix_trie
+{
+	private:
+
+		struct Node
+		{
+			Genode::uint32_t const key;
+			Genode::uint8_t  const prefix;
+			T        const        *object;
+			Node                  *child[2] { nullptr, nullptr };
+
+			Node(Genode::uint32_t key, Genode::uint8_t prefix, T const *object)
+			: key(key), prefix(prefix), object(object) { }
+
+			bool matches(Genode::uint32_t ip) const {
+				return !((ip ^ key) & _mask(prefix)); }
+		};
+
+		Node *_root { nullptr };
+
+		static Genode::uint32_t _mask(unsigned prefix) {
+			return prefix ? ~0U << (32 - prefix) : 0; }
+
+		static unsigned _bit(Genode::uint32_t value, unsigned pos) {
+			return (value >> (31 - pos)) & 1; }
+
+		static unsigned _common_prefix(Genode::uint32_t a, Genode::uint32_t b,
+		                               unsigned max)
+		{
+			Genode::uint32_t const diff = a ^ b;
+			unsigned const common = diff ? __builtin_clz(diff) : 32;
+			return common < max ? common : max;
+		}
+
+		static void _destroy(Genode::Deallocator &dealloc, Node *node)
+		{
+			if (!node)
+				return;
+
+			_destroy(dealloc, node->child[0]);
+			_destroy(dealloc, node->child[1]);
+			destroy(dealloc, node);
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Ipv4_prefix_trie(Ipv4_prefix_trie const &);
+		Ipv4_prefix_trie &operator = (Ipv4_prefix_trie const &);
+
+	public:
+
+		Ipv4_prefix_trie() { }
+
+		/**
+		 * Add 'object' for 'dst'
+		 *
+		 * If the trie already holds an object for the same prefix, the
+		 * existing object is kept.
+		 */
+		void insert(Genode::Allocator &alloc, Ipv4_address_prefix const &dst,
+		            T const &object)
+		{
+			unsigned         const prefix = dst.prefix;
+			Genode::uint32_t const key    =
+				dst.address.to_uint32_little_endian() & _mask(prefix);
+
+			for (Node **node_ptr = &_root; ; ) {
+
+				Node *const node = *node_ptr;
+				if (!node) {
+					*node_ptr = new (alloc) Node(key, (Genode::uint8_t)prefix, &object);
+					return;
+				}
+				unsigned const common = _common_prefix(
+					key, node->key, prefix < node->prefix ? prefix : node->prefix);
+
+				if (common == node->prefix) {
+
+					/* the node is a prefix of 'dst' */
+					if (prefix == node->prefix) {
+						if (!node->object)
+							node->object = &object;
+						return;
+					}
+					node_ptr = &node->child[_bit(key, node->prefix)];
+					continue;
+				}
+				if (common == prefix) {
+
+					/* 'dst' is a prefix of the node */
+					Node &parent = *new (alloc) Node(key, (Genode::uint8_t)prefix, &object);
+					parent.child[_bit(node->key, prefix)] = node;
+					*node_ptr = &parent;
+					return;
+				}
+				/* the paths of 'dst' and the node diverge */
+				Node &branch = *new (alloc)
+					Node(key & _mask(common), (Genode::uint8_t)common, nullptr);
+
+				branch.child[_bit(node->key, common)] = node;
+				branch.child[_bit(key, common)] =
+					new (alloc) Node(key, (Genode::uint8_t)prefix, &object);
+
+				*node_ptr = &branch;
+				return;
+			}
+		}
+
+		void destroy_each(Genode::Deallocator &dealloc)
+		{
+			_destroy(dealloc, _root);
+			_root = nullptr;
+		}
+
+		void find_longest_prefix_match(Ipv4_address const &ip,
+		                               auto         const &handle_match,
+		                               auto         const &handle_no_match) const
+		{
+			Genode::uint32_t const value = ip.to_uint32_little_endian();
+
+			T const *best = nullptr;
+			for (Node const *node = _root; node && node->matches(value); ) {
+
+				if (node->object)
+					best = node->object;
+
+				if (node->prefix == 32)
+					break;
+
+				node = node->child[_bit(value, node->prefix)];
+			}
+			if (best)
+				handle_match(*best);
+			else
+				handle_no_match();
+		}
+};
+
+#endif /* _IPV4_PREFIX_TRIE_H_ */
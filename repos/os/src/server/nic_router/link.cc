@@ -39,9 +39,22 @@ bool Link_side_id::operator != (Link_side_id const &id) const
 }
 
 
-bool Link_side_id::operator > (Link_side_id const &id) const
+uint32_t Link_side_id::hash() const
 {
-	return memcmp(id.data_base(), data_base(), data_size()) > 0;
+	uint32_t src, dst;
+	memcpy(&src, src_ip.addr, sizeof(src));
+	memcpy(&dst, dst_ip.addr, sizeof(dst));
+
+	uint64_t key = ((uint64_t)src << 32 | dst)
+	             ^ ((uint64_t)src_port.value << 40 | (uint64_t)dst_port.value << 8);
+
+	/* finalizer of MurmurHash3 */
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53ULL;
+	key ^= key >> 33;
+	return (uint32_t)key;
 }
 
 
@@ -31,7 +31,6 @@
 #define _LINK_H_
 
 /* Genode includes */
-#include <util/avl_tree.h>
 #include <util/list.h>
 #include <net/ipv4.h>
 #include <net/port.h>
@@ -40,6 +39,7 @@
 #include <list.h>
 #include <l3_protocol.h>
 #include <lazy_one_shot_timeout.h>
+#include <flow_table.h>
 
 namespace Net {
 
@@ -51,7 +51,7 @@ namespace Net {
 	class  Interface;
 	class  Link_side_id;
 	class  Link_side;
-	class  Link_side_tree;
+	using  Link_side_table = Flow_table<Link_side>;
 	class  Link;
 	struct Link_list : List<Link> { };
 	class  Tcp_link;
@@ -78,11 +78,11 @@ struct Net::Link_side_id
 
 	bool operator != (Link_side_id const &id) const;
 
-	bool operator > (Link_side_id const &id) const;
+	Genode::uint32_t hash() const;
 };
 
 
-class Net::Link_side : public Genode::Avl_node<Link_side>
+class Net::Link_side : public Genode::List<Link_side>::Element
 {
 	friend class Link;
 
@@ -104,39 +104,9 @@ class Net::Link_side : public Genode::Avl_node<Link_side>
 		          Link_side_id const &id,
 		          Link               &link);
 
-		void find_by_id(Link_side_id const &id, auto const &handle_match, auto const &handle_no_match) const
-		{
-			if (id != _id) {
-
-				Link_side *const link_side_ptr {
-					Avl_node<Link_side>::child(id > _id) };
-
-				if (link_side_ptr != nullptr) {
-
-					link_side_ptr->find_by_id(
-						id, handle_match, handle_no_match);
-
-				} else {
-
-					handle_no_match();
-				}
-
-			} else {
-
-				handle_match(*this);
-			}
-		}
-
 		bool is_client() const;
 
 
-		/**************
-		 ** Avl_node **
-		 **************/
-
-		bool higher(Link_side *side) { return side->_id > _id; }
-
-
 		/*********
 		 ** Log **
 		 *********/
@@ -148,6 +118,7 @@ class Net::Link_side : public Genode::Avl_node<Link_side>
 		 ** Accessors **
 		 ***************/
 
+		Link_side_id const &id()        const { return _id; }
 		Domain             &domain()    const { return *_domain_ptr; }
 		Link               &link()      const { return _link; }
 		Ipv4_address const &src_ip()    const { return _id.src_ip; }
@@ -157,22 +128,6 @@ class Net::Link_side : public Genode::Avl_node<Link_side>
 };
 
 
-struct Net::Link_side_tree : Genode::Avl_tree<Link_side>
-{
-	void find_by_id(Link_side_id const &id, auto const &handle_match, auto const &handle_no_match) const
-	{
-		if (first() != nullptr) {
-
-			first()->find_by_id(id, handle_match, handle_no_match);
-
-		} else {
-
-			handle_no_match();
-		}
-	}
-};
-
-
 class Net::Link : public Link_list::Element
 {
 	protected:
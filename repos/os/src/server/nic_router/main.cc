@@ -36,14 +36,15 @@ class Net::Main
 		Genode::Env                    &_env;
 		Quota                           _shared_quota        { };
 		Interface_list                  _interfaces          { };
+		Interface_wakeups               _wakeups             { };
 		Cached_timer                    _timer               { _env };
 		Genode::Heap                    _heap                { &_env.ram(), &_env.rm() };
 		Signal_handler<Main>            _report_handler      { _env.ep(), *this, &Main::_handle_report };
 		Genode::Attached_rom_dataspace  _config_rom          { _env, "config" };
 		Configuration                  *_config_ptr          { new (_heap) Configuration { _config_rom.node(), _heap } };
 		Signal_handler<Main>            _config_handler      { _env.ep(), *this, &Main::_handle_config };
-		Nic_session_root                _nic_session_root    { _env, _timer, _heap, *_config_ptr, _shared_quota, _interfaces };
-		Uplink_session_root             _uplink_session_root { _env, _timer, _heap, *_config_ptr, _shared_quota, _interfaces };
+		Nic_session_root                _nic_session_root    { _env, _timer, _heap, *_config_ptr, _shared_quota, _interfaces, _wakeups };
+		Uplink_session_root             _uplink_session_root { _env, _timer, _heap, *_config_ptr, _shared_quota, _interfaces, _wakeups };
 
 		/*
 		 * Noncopyable
@@ -95,7 +96,7 @@ void Net::Main::_handle_config()
 	Configuration &new_config = *new (_heap)
 		Configuration {
 			_env, _config_rom.node(), _heap, _report_handler, _timer,
-			old_config, _shared_quota, _interfaces };
+			old_config, _shared_quota, _interfaces, _wakeups };
 
 	_nic_session_root.handle_config(new_config);
 	_uplink_session_root.handle_config(new_config);
@@ -40,7 +40,7 @@ Net::Nic_client::Nic_client(Session_label const &label_arg,
 
 
 bool Nic_client::finish_construction(Env &env, Cached_timer &timer, Interface_list &interfaces,
-                                     Nic_client_dict &old_nic_clients)
+                                     Interface_wakeups &wakeups, Nic_client_dict &old_nic_clients)
 {
 	char const *error = "";
 	old_nic_clients.with_element(
@@ -61,7 +61,8 @@ bool Nic_client::finish_construction(Env &env, Cached_timer &timer, Interface_li
 
 			try {
 				_crit.construct(new (_alloc)
-					Nic_client_interface(env, timer, _alloc, interfaces, _config, domain(), label()));
+					Nic_client_interface(env, timer, _alloc, interfaces, wakeups, _config,
+					                     domain(), label()));
 			}
 			catch (Insufficient_ram_quota) { error = "NIC session RAM quota"; }
 			catch (Insufficient_cap_quota) { error = "NIC session CAP quota"; }
@@ -126,6 +127,7 @@ Net::Nic_client_interface::Nic_client_interface(Env                 &env,
                                                 Cached_timer        &timer,
                                                 Genode::Allocator   &alloc,
                                                 Interface_list      &interfaces,
+                                                Interface_wakeups   &wakeups,
                                                 Configuration       &config,
                                                 Domain_name   const &domain_name,
                                                 Session_label const &label)
@@ -136,8 +138,8 @@ Net::Nic_client_interface::Nic_client_interface(Env                 &env,
 	_session_link_state_handler { env.ep(), *this,
 	                              &Nic_client_interface::_handle_session_link_state },
 	_interface                  { env.ep(), timer, mac_address(), alloc,
-	                              Mac_address(), config, interfaces, *rx(), *tx(),
-	                              *this }
+	                              Mac_address(), config, interfaces, wakeups, *rx(),
+	                              *tx(), *this }
 {
 	/* install packet stream signal handlers */
 	rx_channel()->sigh_packet_avail(_interface.pkt_stream_signal_handler());
@@ -64,7 +64,8 @@ class Net::Nic_client : private Nic_client_dict::Element
 
 		~Nic_client();
 
-		[[nodiscard]] bool finish_construction(Genode::Env &, Cached_timer &, Interface_list &, Nic_client_dict &);
+		[[nodiscard]] bool finish_construction(Genode::Env &, Cached_timer &, Interface_list &,
+		                                       Interface_wakeups &, Nic_client_dict &);
 
 
 		/**************
@@ -146,6 +147,7 @@ class Net::Nic_client_interface : public Nic_client_interface_base,
 		                     Cached_timer                &timer,
 		                     Genode::Allocator           &alloc,
 		                     Interface_list              &interfaces,
+		                     Interface_wakeups           &wakeups,
 		                     Configuration               &config,
 		                     Domain_name           const &domain_name,
 		                     Genode::Session_label const &label);
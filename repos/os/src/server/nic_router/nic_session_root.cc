@@ -240,6 +240,7 @@ Nic_session_component(Session_env                    &session_env,
                       Mac_address              const &router_mac,
                       Session_label            const &label,
                       Interface_list                 &interfaces,
+                      Interface_wakeups              &wakeups,
                       Configuration                  &config,
                       Ram_dataspace_capability const  ram_ds)
 :
@@ -248,7 +249,7 @@ Nic_session_component(Session_env                    &session_env,
 	                             &_packet_alloc, _session_env.ep().rpc_ep() },
 	_interface_policy          { label, _session_env, config },
 	_interface                 { _session_env.ep(), timer, router_mac, _alloc,
-	                             mac, config, interfaces, *_tx.sink(),
+	                             mac, config, interfaces, wakeups, *_tx.sink(),
 	                             *_rx.source(), _interface_policy },
 	_ram_ds                    { ram_ds }
 {
@@ -288,7 +289,8 @@ Net::Nic_session_root::Nic_session_root(Env               &env,
                                         Allocator         &alloc,
                                         Configuration     &config,
                                         Quota             &shared_quota,
-                                        Interface_list    &interfaces)
+                                        Interface_list    &interfaces,
+                                        Interface_wakeups &wakeups)
 :
 	Root_component<Nic_session_component> { &env.ep().rpc_ep(), &alloc },
 	_env                                  { env },
@@ -296,7 +298,8 @@ Net::Nic_session_root::Nic_session_root(Env               &env,
 	_mac_alloc                            { MAC_ALLOC_BASE },
 	_config_ptr                           { &config },
 	_shared_quota                         { shared_quota },
-	_interfaces                           { interfaces }
+	_interfaces                           { interfaces },
+	_wakeups                              { wakeups }
 {
 	_mac_alloc.alloc().with_result(
 		[&] (Mac_address const &mac){ _router_mac.construct(mac); },
@@ -323,7 +326,7 @@ Net::Nic_session_root::_create_session(char const *args)
 								Arg_string::find_arg(args, "tx_buf_size").ulong_value(0),
 								Arg_string::find_arg(args, "rx_buf_size").ulong_value(0),
 								_timer, mac, *_router_mac, label, _interfaces,
-								*_config_ptr, ram_ds);
+								_wakeups, *_config_ptr, ram_ds);
 						}
 						catch (...) {
 							_mac_alloc.free(mac);
@@ -147,6 +147,7 @@ class Net::Nic_session_component : private Nic_session_component_base,
 		                      Mac_address                      const &router_mac,
 		                      Genode::Session_label            const &label,
 		                      Interface_list                         &interfaces,
+		                      Interface_wakeups                      &wakeups,
 		                      Configuration                          &config,
 		                      Genode::Ram_dataspace_capability const  ram_ds);
 
@@ -185,6 +186,7 @@ class Net::Nic_session_root
 		Configuration                     *_config_ptr;
 		Quota                             &_shared_quota;
 		Interface_list                    &_interfaces;
+		Interface_wakeups                 &_wakeups;
 
 		void _invalid_downlink(char const *reason);
 
@@ -209,7 +211,8 @@ class Net::Nic_session_root
 		                 Genode::Allocator &alloc,
 		                 Configuration     &config,
 		                 Quota             &shared_quota,
-		                 Interface_list    &interfaces);
+		                 Interface_list    &interfaces,
+		                 Interface_wakeups &wakeups);
 
 		void handle_config(Configuration &config) { _config_ptr = &config; }
 };
@@ -88,6 +88,7 @@ Net::Uplink_session_component::Uplink_session_component(Session_env
                                                         Mac_address              const  mac,
                                                         Session_label            const &label,
                                                         Interface_list                 &interfaces,
+                                                        Interface_wakeups              &wakeups,
                                                         Configuration                  &config,
                                                         Ram_dataspace_capability const  ram_ds)
 :
@@ -96,7 +97,7 @@ Net::Uplink_session_component::Uplink_session_component(Session_env
 	                                &_packet_alloc, _session_env.ep().rpc_ep() },
 	_interface_policy             { label, _session_env, config },
 	_interface                    { _session_env.ep(), timer, mac, _alloc,
-	                                Mac_address(), config, interfaces, *_tx.sink(),
+	                                Mac_address(), config, interfaces, wakeups, *_tx.sink(),
 	                                *_rx.source(), _interface_policy },
 	_ram_ds                       { ram_ds }
 {
@@ -123,14 +124,16 @@ Net::Uplink_session_root::Uplink_session_root(Env               &env,
                                               Allocator         &alloc,
                                               Configuration     &config,
                                               Quota             &shared_quota,
-                                              Interface_list    &interfaces)
+                                              Interface_list    &interfaces,
+                                              Interface_wakeups &wakeups)
 :
 	Root_component<Uplink_session_component> { &env.ep().rpc_ep(), &alloc },
 	_env                                     { env },
 	_timer                                   { timer },
 	_config_ptr                              { &config },
 	_shared_quota                            { shared_quota },
-	_interfaces                              { interfaces }
+	_interfaces                              { interfaces },
+	_wakeups                                 { wakeups }
 { }
 
 
@@ -164,7 +167,7 @@ Net::Uplink_session_root::_create_session(char const *args)
 					session_at, session_env,
 					Arg_string::find_arg(args, "tx_buf_size").ulong_value(0),
 					Arg_string::find_arg(args, "rx_buf_size").ulong_value(0),
-					_timer, mac, label, _interfaces, *_config_ptr, ram_ds);
+					_timer, mac, label, _interfaces, _wakeups, *_config_ptr, ram_ds);
 			});
 	}
 	catch (Out_of_ram) {
@@ -110,6 +110,7 @@ class Net::Uplink_session_component : private Uplink_session_component_base,
 		                         Mac_address                      const  mac,
 		                         Genode::Session_label            const &label,
 		                         Interface_list                         &interfaces,
+		                         Interface_wakeups                      &wakeups,
 		                         Configuration                          &config,
 		                         Genode::Ram_dataspace_capability const  ram_ds);
 
@@ -132,11 +133,12 @@ class Net::Uplink_session_root
 
 		enum { MAC_ALLOC_BASE = 0x02 };
 
-		Genode::Env    &_env;
-		Cached_timer   &_timer;
-		Configuration  *_config_ptr;
-		Quota          &_shared_quota;
-		Interface_list &_interfaces;
+		Genode::Env       &_env;
+		Cached_timer      &_timer;
+		Configuration     *_config_ptr;
+		Quota             &_shared_quota;
+		Interface_list    &_interfaces;
+		Interface_wakeups &_wakeups;
 
 		void _invalid_downlink(char const *reason);
 
@@ -160,7 +162,8 @@ class Net::Uplink_session_root
 		                    Genode::Allocator &alloc,
 		                    Configuration     &config,
 		                    Quota             &shared_quota,
-		                    Interface_list    &interfaces);
+		                    Interface_list    &interfaces,
+		                    Interface_wakeups &wakeups);
 
 		void handle_config(Configuration &config) { _config_ptr = &config; }
 };
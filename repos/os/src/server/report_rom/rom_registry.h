@@ -26,6 +26,7 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 	private:
 
 		Genode::Allocator              &_md_alloc;
+		Genode::Allocator              &_content_alloc;
 		Genode::Ram_allocator          &_ram;
 		Genode::Env::Local_rm          &_rm;
 		Genode::Attached_rom_dataspace &_config_rom;
@@ -72,7 +73,8 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 			/* XXX if we run out of memory, the server will abort */
 
 			Module * const module = new (&_md_alloc)
-				Module(_ram, _rm, name, _read_write_policy, _read_write_policy);
+				Module(_ram, _rm, name, _read_write_policy, _read_write_policy,
+				       _zero_copy() ? &_content_alloc : nullptr);
 
 			_modules.insert(module);
 			return *module;
@@ -110,6 +112,16 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 			_try_to_destroy(module);
 		}
 
+		/**
+		 * Return true if reports are handed out as shared sealed dataspaces
+		 */
+		bool _zero_copy() const
+		{
+			_config_rom.update();
+
+			return _config_rom.node().attribute_value("zero_copy", false);
+		}
+
 		/**
 		 * Return report name that corresponds to the given ROM session label
 		 *
@@ -133,11 +145,19 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 
 	public:
 
-		Registry(Genode::Allocator &md_alloc,
+		/**
+		 * Constructor
+		 *
+		 * \param md_alloc       allocator for the ROM modules
+		 * \param content_alloc  allocator for the meta data of shared
+		 *                       content versions
+		 */
+		Registry(Genode::Allocator &md_alloc, Genode::Allocator &content_alloc,
 		         Genode::Ram_allocator &ram, Genode::Env::Local_rm &rm,
 		         Genode::Attached_rom_dataspace &config_rom)
 		:
-			_md_alloc(md_alloc), _ram(ram), _rm(rm), _config_rom(config_rom)
+			_md_alloc(md_alloc), _content_alloc(content_alloc),
+			_ram(ram), _rm(rm), _config_rom(config_rom)
 		{ }
 
 		Module &lookup(Writer &writer, Module::Name const &name) override
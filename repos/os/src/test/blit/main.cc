@@ -13,8 +13,11 @@
 
 #include <base/component.h>
 #include <base/log.h>
+#include <base/attached_ram_dataspace.h>
 #include <blit/blit.h>
 #include <blit/internal/slow.h>
+#include <nitpicker_gfx/texture_painter.h>
+#include <trace/timestamp.h>
 
 using namespace Blit;
 
@@ -367,20 +370,205 @@ static inline void test_simd_blend_mix()
 }
 
 
-void Component::construct(Genode::Env &)
+template <typename SIMD>
+static inline void test_simd_blend_avr_masked()
+{
+	/* odd number of pixels to cover the scalar tail of the SIMD loops */
+	enum { N = 37 };
+
+	uint32_t src[N] { }, dst[N] { };
+	for (unsigned i = 0; i < N; i++) {
+		src[i] = (i % 5 == 0) ? 0 : 0x01030507*i;
+		dst[i] = 0xffffffff - 0x00010203*i;
+	}
+
+	/* transparent block of four pixels */
+	for (unsigned i = 8; i < 12; i++)
+		src[i] = 0;
+
+	auto check = [&] (char const *msg, uint32_t const *ref, uint32_t const *got)
+	{
+		for (unsigned i = 0; i < N; i++) {
+			if (ref[i] != got[i]) {
+				error(msg, " mismatch at ", i, ": ref=", Hex(ref[i]),
+				      " simd=", Hex(got[i]));
+				throw 1;
+			}
+		}
+		log(msg, " matches slow version");
+	};
+
+	{
+		uint32_t ref[N], got[N];
+		memcpy(ref, dst, sizeof(ref));
+		memcpy(got, dst, sizeof(got));
+		Slow::Blend::xrgb_avr(ref, N, src, 0x00ff7f01);
+		SIMD::Blend::xrgb_avr(got, N, src, 0x00ff7f01);
+		check("avr   ", ref, got);
+	}
+	{
+		uint32_t ref[N], got[N];
+		memcpy(ref, dst, sizeof(ref));
+		memcpy(got, dst, sizeof(got));
+		Slow::Blend::xrgb_masked(ref, N, src);
+		SIMD::Blend::xrgb_masked(got, N, src);
+		check("masked", ref, got);
+	}
+}
+
+
+/**
+ * Check the 'Texture_painter' modes against a per-pixel reference
+ */
+static inline void test_texture_painter()
+{
+	using PT = Pixel_rgb888;
+
+	static Image<13, 7>  tex_pixels = Image<13, 7>::pattern();
+	static uint8_t       tex_alpha[13*7];
+	static Image<32, 16> bg = Image<32, 16>::pattern(), surface_pixels { }, ref { };
+
+	for (unsigned i = 0; i < 13*7; i++) {
+		tex_alpha[i] = uint8_t(i*11);
+		if (i % 3 == 0) tex_pixels.pixels[i] = 0;
+	}
+
+	Texture<PT> const texture { (PT *)tex_pixels.pixels, tex_alpha, { 13, 7 } };
+	Surface<PT>       surface { (PT *)surface_pixels.pixels, { 32, 16 } };
+
+	Color const color { 0x40, 0x80, 0xc1 };
+	PT    const mix_pixel(color.r, color.g, color.b);
+
+	/* position the texture partially outside the surface to test clipping */
+	Blit::Point const pos { 23, -2 };
+
+	auto for_each_covered = [&] (auto const &fn)
+	{
+		for (int y = 0; y < 16; y++)
+			for (int x = 0; x < 32; x++) {
+				int const tx = x - pos.x, ty = y - pos.y;
+				if (tx >= 0 && tx < 13 && ty >= 0 && ty < 7)
+					fn(ref.pixels[y*32 + x], unsigned(ty*13 + tx));
+			}
+	};
+
+	/*
+	 * The vectorized alpha blending may deviate from the per-pixel
+	 * 'PT::mix' by one in each color component.
+	 */
+	auto similar = [&] (uint32_t a, uint32_t b, unsigned tolerance)
+	{
+		for (unsigned shift = 0; shift < 24; shift += 8) {
+			int const diff = int((a >> shift) & 0xff) - int((b >> shift) & 0xff);
+			if (diff > int(tolerance) || diff < -int(tolerance))
+				return false;
+		}
+		return true;
+	};
+
+	auto test = [&] (char const *msg, Texture_painter::Mode mode,
+	                 unsigned tolerance, auto const &ref_fn)
+	{
+		surface_pixels = bg;
+		ref            = bg;
+		Texture_painter::paint(surface, texture, color, pos, mode, true);
+		for_each_covered(ref_fn);
+		for (unsigned i = 0; i < 32*16; i++) {
+			if (!similar(surface_pixels.pixels[i], ref.pixels[i], tolerance)) {
+				error("texture painter ", msg, " got:\n", surface_pixels,
+				      "\nexpected:\n", ref);
+				throw 1;
+			}
+		}
+		log("texture painter ", msg, " matches per-pixel reference");
+	};
+
+	auto pixel = [&] (uint32_t value) { PT p { }; p.pixel = value; return p; };
+
+	test("mixed ", Texture_painter::MIXED, 0, [&] (uint32_t &d, unsigned i) {
+		d = PT::avr(mix_pixel, pixel(tex_pixels.pixels[i])).pixel; });
+
+	test("masked", Texture_painter::MASKED, 0, [&] (uint32_t &d, unsigned i) {
+		if (tex_pixels.pixels[i]) d = tex_pixels.pixels[i]; });
+
+	test("alpha ", Texture_painter::SOLID, 1, [&] (uint32_t &d, unsigned i) {
+		if (tex_alpha[i])
+			d = PT::mix(pixel(d), pixel(tex_pixels.pixels[i]), tex_alpha[i] + 1).pixel; });
+}
+
+
+/**
+ * Measure the throughput of the blending operations in CPU cycles per pixel
+ */
+template <typename SIMD>
+static void bench_simd_blend(Env &env)
+{
+	enum { W = 1024, H = 768, N = W*H, ROUNDS = 8 };
+
+	Attached_ram_dataspace dst_ds   { env.ram(), env.rm(), N*sizeof(uint32_t) },
+	                       src_ds   { env.ram(), env.rm(), N*sizeof(uint32_t) },
+	                       alpha_ds { env.ram(), env.rm(), N };
+
+	uint32_t * const dst   = dst_ds  .local_addr<uint32_t>();
+	uint32_t * const src   = src_ds  .local_addr<uint32_t>();
+	uint8_t  * const alpha = alpha_ds.local_addr<uint8_t>();
+
+	for (unsigned i = 0; i < N; i++) {
+		src[i]   = (i & 0x10) ? 0x00f0a050 + i : 0;
+		dst[i]   = 0x00102030 ^ i;
+		alpha[i] = uint8_t(i*7);
+	}
+
+	auto measure = [&] (char const *msg, auto const &fn)
+	{
+		Trace::Timestamp const start = Trace::timestamp();
+		for (unsigned round = 0; round < ROUNDS; round++)
+			for (unsigned y = 0; y < H; y++)
+				fn(dst + y*W, W, src + y*W, alpha + y*W);
+		Trace::Timestamp const end = Trace::timestamp();
+
+		uint64_t const per_pixel_x100 = 100*(end - start)/(uint64_t(N)*ROUNDS);
+		log("bench ", msg, ": ", per_pixel_x100/100, ".",
+		    per_pixel_x100 % 100 < 10 ? "0" : "", per_pixel_x100 % 100,
+		    " cycles/pixel");
+	};
+
+	uint32_t const color = 0x00406080;
+
+	measure("alpha  slow", [&] (uint32_t *d, unsigned n, uint32_t const *s, uint8_t const *a) {
+		Slow::Blend::xrgb_a(d, n, s, a); });
+	measure("alpha  simd", [&] (uint32_t *d, unsigned n, uint32_t const *s, uint8_t const *a) {
+		SIMD::Blend::xrgb_a(d, n, s, a); });
+	measure("mixed  slow", [&] (uint32_t *d, unsigned n, uint32_t const *s, uint8_t const *) {
+		Slow::Blend::xrgb_avr(d, n, s, color); });
+	measure("mixed  simd", [&] (uint32_t *d, unsigned n, uint32_t const *s, uint8_t const *) {
+		SIMD::Blend::xrgb_avr(d, n, s, color); });
+	measure("masked slow", [&] (uint32_t *d, unsigned n, uint32_t const *s, uint8_t const *) {
+		Slow::Blend::xrgb_masked(d, n, s); });
+	measure("masked simd", [&] (uint32_t *d, unsigned n, uint32_t const *s, uint8_t const *) {
+		SIMD::Blend::xrgb_masked(d, n, s); });
+}
+
+
+void Component::construct(Genode::Env &env)
 {
 #ifdef _INCLUDE__BLIT__INTERNAL__NEON_H_
 	log("-- ARM Neon --");
 	test_simd_b2f<Neon>();
 	test_simd_blend_mix<Neon>();
+	test_simd_blend_avr_masked<Neon>();
+	bench_simd_blend<Neon>(env);
 #endif
 #ifdef _INCLUDE__BLIT__INTERNAL__SSE4_H_
 	log("-- SSE4 --");
 	test_simd_b2f<Sse4>();
 	test_simd_blend_mix<Sse4>();
+	test_simd_blend_avr_masked<Sse4>();
+	bench_simd_blend<Sse4>(env);
 #endif
 
 	test_b2f_dispatch();
+	test_texture_painter();
 
 	log("--- blit test finished ---");
 }
@@ -0,0 +1,326 @@
+/*
+ * \brief  Throughput and latency benchmark of File_system packet processing
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * For each '<fs>' node of the config, the benchmark opens a File_system
+ * session with the node's label and writes, syncs, and reads back a file
+ * named after the label while keeping up to 'depth' packets in flight.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <file_system_session/connection.h>
+#include <timer_session/connection.h>
+
+namespace Fs_packet_bench {
+
+	using namespace Genode;
+	using namespace File_system;
+	using File_system::Packet_descriptor;
+
+	struct Bench;
+	struct Main;
+
+	using Label = String<64>;
+}
+
+
+struct Fs_packet_bench::Bench
+{
+	/*
+	 * Noncopyable
+	 */
+	Bench(Bench const &);
+	Bench &operator = (Bench const &);
+
+	enum class Phase { WRITE, SYNC, SEQ_READ, RANDOM_READ, DONE };
+
+	struct Attr
+	{
+		Label    label;
+		size_t   file_size;
+		size_t   block_size;
+		unsigned depth;
+	};
+
+	Env                     &_env;
+	Timer::Connection       &_timer;
+	Attr               const _attr;
+	Signal_context_capability _done_sigh;
+
+	Heap          _heap      { _env.ram(), _env.rm() };
+	Allocator_avl _avl_alloc { &_heap };
+
+	File_system::Connection _fs { _env, _avl_alloc, _attr.label, true,
+	                              _attr.block_size*_attr.depth };
+
+	File_system::Session::Tx::Source &_tx { *_fs.tx() };
+
+	Dir_handle  const _dir  { _fs.dir("/", false) };
+	File_handle const _file { _fs.file(_dir, _attr.label.string(), READ_WRITE, true) };
+
+	Signal_handler<Bench> _handler { _env.ep(), *this, &Bench::_handle_acks };
+
+	unsigned const _num_blocks = unsigned(_attr.file_size/_attr.block_size);
+
+	Phase    _phase      = Phase::WRITE;
+	unsigned _submitted  = 0;   /* packets submitted in current phase */
+	unsigned _completed  = 0;   /* packets acknowledged in current phase */
+	uint64_t _start_us   = 0;
+	uint64_t _latency_us = 0;   /* sum of packet latencies in current phase */
+	uint64_t _max_us     = 0;
+	uint32_t _random     = 1;
+	bool     _failed     = false;
+
+	/* submission time of the packet occupying each slot of the bulk buffer */
+	uint64_t *_submit_us = (uint64_t *)_heap.alloc(_attr.depth*sizeof(uint64_t));
+
+	uint64_t _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
+	unsigned _slot(Packet_descriptor const &p) const {
+		return unsigned(p.offset()/_attr.block_size); }
+
+	/**
+	 * Return file offset of the n-th packet of the current phase
+	 */
+	seek_off_t _position(unsigned n)
+	{
+		if (_phase != Phase::RANDOM_READ)
+			return seek_off_t(n)*_attr.block_size;
+
+		/* linear congruential generator */
+		_random = _random*1103515245 + 12345;
+		return seek_off_t((_random >> 8) % _num_blocks)*_attr.block_size;
+	}
+
+	/**
+	 * Fill block with the file positions of its 64-bit words
+	 */
+	static void _fill(uint64_t *words, size_t len, seek_off_t position)
+	{
+		for (size_t i = 0; i < len/sizeof(uint64_t); i++)
+			words[i] = position + i*sizeof(uint64_t);
+	}
+
+	static bool _valid(uint64_t const *words, size_t len, seek_off_t position)
+	{
+		size_t const last = len/sizeof(uint64_t) - 1;
+		return words[0]    == position
+		    && words[last] == position + last*sizeof(uint64_t);
+	}
+
+	static char const *_name(Phase phase)
+	{
+		switch (phase) {
+		case Phase::WRITE:       return "write      ";
+		case Phase::SYNC:        return "sync       ";
+		case Phase::SEQ_READ:    return "seq read   ";
+		case Phase::RANDOM_READ: return "random read";
+		case Phase::DONE:        break;
+		}
+		return "";
+	}
+
+	unsigned _num_packets() const {
+		return _phase == Phase::SYNC ? 1 : _num_blocks; }
+
+	void _submit(Packet_descriptor const &alloc)
+	{
+		unsigned const n = _submitted++;
+
+		Packet_descriptor packet;
+
+		if (_phase == Phase::SYNC) {
+			packet = Packet_descriptor(alloc, _file, Packet_descriptor::SYNC, 0, 0);
+		} else {
+			seek_off_t const position = _position(n);
+			bool       const write    = (_phase == Phase::WRITE);
+
+			if (write)
+				_fill((uint64_t *)_tx.packet_content(alloc), _attr.block_size, position);
+
+			packet = Packet_descriptor(alloc, _file,
+			                           write ? Packet_descriptor::WRITE
+			                                 : Packet_descriptor::READ,
+			                           _attr.block_size, position);
+		}
+		_submit_us[_slot(packet)] = _now_us();
+		_tx.submit_packet(packet);
+	}
+
+	/*
+	 * The bulk buffer is partitioned into 'depth' slots of 'block_size'.
+	 * Each acknowledged packet hands its slot to the next packet.
+	 */
+	void _start_phase()
+	{
+		_submitted = _completed = 0;
+		_latency_us = _max_us = 0;
+		_start_us = _now_us();
+
+		for (unsigned i = 0; i < _attr.depth && _submitted < _num_packets(); i++)
+			_submit(Packet_descriptor(i*_attr.block_size, _attr.block_size));
+	}
+
+	void _finish_phase()
+	{
+		uint64_t const duration_us = max(_now_us() - _start_us, (uint64_t)1);
+
+		if (_phase == Phase::SYNC)
+			log("[", _attr.label, "] ", _name(_phase), ": ",
+			    duration_us, " us");
+		else
+			log("[", _attr.label, "] ", _name(_phase), ": ",
+			    (uint64_t(_attr.file_size)*1000*1000/duration_us)/1024, " KiB/s, "
+			    "latency avg ", _latency_us/_completed, " us, "
+			    "max ", _max_us, " us");
+
+		switch (_phase) {
+		case Phase::WRITE:       _phase = Phase::SYNC;        break;
+		case Phase::SYNC:        _phase = Phase::SEQ_READ;    break;
+		case Phase::SEQ_READ:    _phase = Phase::RANDOM_READ; break;
+		case Phase::RANDOM_READ: _phase = Phase::DONE;        break;
+		case Phase::DONE:                                     break;
+		}
+
+		if (_phase == Phase::DONE)
+			Signal_transmitter(_done_sigh).submit();
+		else
+			_start_phase();
+	}
+
+	void _handle_acks()
+	{
+		while (_phase != Phase::DONE && _tx.ack_avail()) {
+
+			Packet_descriptor const packet = _tx.get_acked_packet();
+
+			uint64_t const latency_us = _now_us() - _submit_us[_slot(packet)];
+			_latency_us += latency_us;
+			_max_us      = max(_max_us, latency_us);
+			_completed++;
+
+			bool const read = (packet.operation() == Packet_descriptor::READ);
+
+			if (!packet.succeeded()
+			 || (read && !_valid((uint64_t *)_tx.packet_content(packet),
+			                     packet.length(), packet.position()))) {
+				error("[", _attr.label, "] ", _name(_phase), " failed at ",
+				      packet.position());
+				_failed = true;
+				_phase  = Phase::DONE;
+				Signal_transmitter(_done_sigh).submit();
+				return;
+			}
+
+			/* reuse the slot of the bulk buffer for the next packet */
+			if (_submitted < _num_packets())
+				_submit(Packet_descriptor(packet.offset(), packet.size()));
+
+			if (_completed == _num_packets())
+				_finish_phase();
+		}
+	}
+
+	Bench(Env &env, Timer::Connection &timer, Attr const &attr,
+	      Signal_context_capability done_sigh)
+	:
+		_env(env), _timer(timer), _attr(attr), _done_sigh(done_sigh)
+	{
+		_fs.sigh(_handler);
+		_start_phase();
+	}
+
+	~Bench()
+	{
+		_heap.free(_submit_us, _attr.depth*sizeof(uint64_t));
+		_fs.close(_file);
+		_fs.close(_dir);
+	}
+
+	bool failed() const { return _failed; }
+};
+
+
+struct Fs_packet_bench::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Constructible<Bench> _bench { };
+
+	unsigned _index = 0;   /* index of '<fs>' node of current benchmark */
+
+	Signal_handler<Main> _done_handler { _env.ep(), *this, &Main::_handle_done };
+
+	bool _start_next()
+	{
+		Genode::Node const &config = _config.node();
+
+		size_t   const file_size  = config.attribute_value("file_size",  Number_of_bytes(16*1024*1024));
+		size_t   const block_size = config.attribute_value("block_size", Number_of_bytes(16*1024));
+		unsigned const depth      = min(config.attribute_value("depth", 16u),
+		                                (unsigned)File_system::Session::TX_QUEUE_SIZE);
+
+		unsigned i = 0;
+		bool started = false;
+		config.for_each_sub_node("fs", [&] (Genode::Node const &fs) {
+			if (i++ != _index || started)
+				return;
+
+			_bench.construct(_env, _timer, Bench::Attr {
+				.label      = fs.attribute_value("label", Label()),
+				.file_size  = file_size,
+				.block_size = block_size,
+				.depth      = depth }, _done_handler);
+			started = true;
+		});
+		_index++;
+		return started;
+	}
+
+	void _handle_done()
+	{
+		bool const failed = _bench->failed();
+		_bench.destruct();
+
+		if (failed) {
+			_env.parent().exit(-1);
+			return;
+		}
+
+		if (!_start_next()) {
+			log("--- fs_packet_bench finished ---");
+			_env.parent().exit(0);
+		}
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- fs_packet_bench started ---");
+
+		if (!_start_next()) {
+			error("no <fs> node configured");
+			_env.parent().exit(-1);
+		}
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Fs_packet_bench::Main main(env); }
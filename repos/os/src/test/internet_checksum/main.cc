@@ -24,6 +24,7 @@
 #include <base/sleep.h>
 #include <base/attached_rom_dataspace.h>
 #include <os/vfs.h>
+#include <timer_session/connection.h>
 
 using namespace Net;
 using namespace Genode;
@@ -122,6 +123,8 @@ struct Main
 	unsigned long num_tcp_checksums = 0;
 	unsigned long num_icmp_checksums = 0;
 	Pseudo_random_number_generator prng { config_rom.node().attribute_value("seed", 0ULL) };
+	Timer::Connection timer { env };
+	unsigned const bench_rounds { config_rom.node().attribute_value("bench_rounds", 20000U) };
 
 	Main(Env &env);
 
@@ -135,6 +138,22 @@ struct Main
 
 	void modify_ip4(Ipv4_packet &ip, Internet_checksum_diff &ip_icd);
 
+	void modify_tcp(Tcp_packet &tcp, Ipv4_packet &ip, Internet_checksum_diff const &ip_icd, size_t tcp_size);
+
+	void modify_udp(Udp_packet &udp, Ipv4_packet &ip, Internet_checksum_diff const &ip_icd);
+
+	void modify_icmp(Icmp_packet &icmp, size_t icmp_size);
+
+	void benchmark();
+
+	void check_updated_checksum(char const *prot, bool checksum_error)
+	{
+		if (checksum_error) {
+			error("frame ", num_packets + 1, ": ", prot, ": incremental update of checksum failed");
+			num_errors++;
+		}
+	}
+
 	void check_recalculated_checksum(char const *prot, uint16_t got_checksum, uint16_t expect_checksum)
 	{
 		if (got_checksum != expect_checksum) {
@@ -216,6 +235,113 @@ void Main::modify_ip4(Ipv4_packet &ip, Internet_checksum_diff &ip_icd)
 }
 
 
+void Main::modify_tcp(Tcp_packet &tcp, Ipv4_packet &ip, Internet_checksum_diff const &ip_icd, size_t tcp_size)
+{
+	Internet_checksum_diff tcp_icd { };
+	tcp.src_port(Port((uint16_t)(tcp.src_port().value + prng.random_byte())), tcp_icd);
+	tcp.dst_port(Port((uint16_t)(tcp.dst_port().value ^ prng.random_byte() << 8)), tcp_icd);
+
+	/* the TCP checksum also covers the IP addresses */
+	tcp_icd.add_up_diff(ip_icd);
+	tcp.update_checksum(tcp_icd);
+
+	/* the incremental update must match a re-calculation */
+	uint16_t const updated_checksum = tcp.checksum();
+	tcp.update_checksum(ip.src(), ip.dst(), tcp_size);
+	check_updated_checksum("tcp", updated_checksum != tcp.checksum());
+}
+
+
+void Main::modify_udp(Udp_packet &udp, Ipv4_packet &ip, Internet_checksum_diff const &ip_icd)
+{
+	Internet_checksum_diff udp_icd { };
+	udp.src_port(Port((uint16_t)(udp.src_port().value * prng.random_byte())), udp_icd);
+	udp.dst_port(Port((uint16_t)(udp.dst_port().value | prng.random_byte())), udp_icd);
+
+	/* the UDP checksum also covers the IP addresses */
+	udp_icd.add_up_diff(ip_icd);
+	udp.update_checksum(udp_icd);
+	check_updated_checksum("udp", udp.checksum_error(ip.src(), ip.dst()));
+}
+
+
+void Main::modify_icmp(Icmp_packet &icmp, size_t icmp_size)
+{
+	size_t const l5_size = icmp_size - sizeof(Icmp_packet);
+	if (icmp.type() != Icmp_packet::Type::ECHO_REQUEST &&
+	    icmp.type() != Icmp_packet::Type::ECHO_REPLY) {
+		icmp.update_checksum(l5_size);
+		return;
+	}
+	Internet_checksum_diff icmp_icd { };
+	icmp.query_id((uint16_t)(icmp.query_id() - prng.random_byte()), icmp_icd);
+	icmp.update_checksum(icmp_icd);
+	check_updated_checksum("icmp", icmp.checksum_error(l5_size));
+}
+
+
+/**
+ * Measure the throughput of full and incremental checksum calculations
+ */
+void Main::benchmark()
+{
+	static constexpr size_t MAX_SIZE = 9000;
+	static Packed_uint16 buf[MAX_SIZE / sizeof(Packed_uint16)];
+	for (Packed_uint16 &word : buf)
+		word.value = (uint16_t)(prng.random_byte() << 8 | prng.random_byte());
+
+	auto rate = [] (uint64_t count, uint64_t duration_us) {
+		return duration_us ? count*1000*1000/duration_us : 0; };
+
+	static constexpr size_t sizes[] = { 64, 576, 1500, MAX_SIZE };
+
+	uint16_t volatile result = 0;
+	for (size_t size : sizes) {
+
+		uint64_t const start_us = timer.elapsed_us();
+		for (unsigned i = 0; i < bench_rounds; i++) {
+			buf[0].value = (uint16_t)i;
+			result = (uint16_t)(result + internet_checksum(buf, size));
+		}
+		uint64_t const duration_us = timer.elapsed_us() - start_us;
+
+		log("full checksum of ", size, " bytes: ",
+		    rate((uint64_t)bench_rounds*size, duration_us) / (1024*1024), " MiB/s ",
+		    rate(bench_rounds, duration_us), " packets/s");
+	}
+
+	/* rewrite an IP address and a port of a 1500-byte TCP packet */
+	{
+		Ipv4_address src { (uint8_t)10 }, dst { (uint8_t)192 };
+		Tcp_packet &tcp = *(Tcp_packet *)buf;
+		size_t const tcp_size = 1500 - sizeof(Ipv4_packet);
+
+		uint64_t start_us = timer.elapsed_us();
+		for (unsigned i = 0; i < bench_rounds; i++) {
+			src.addr[3] = (uint8_t)i;
+			tcp.src_port(Port((uint16_t)i));
+			tcp.update_checksum(src, dst, tcp_size);
+		}
+		uint64_t const full_us = timer.elapsed_us() - start_us;
+
+		start_us = timer.elapsed_us();
+		for (unsigned i = 0; i < bench_rounds; i++) {
+			Internet_checksum_diff icd { };
+			uint8_t const new_src[4] { 10, 10, 10, (uint8_t)(i + 1) };
+			icd.add_up_diff((Packed_uint16 *)new_src, (Packed_uint16 *)src.addr, 4);
+			src.addr[3] = new_src[3];
+			tcp.src_port(Port((uint16_t)(i + 1)), icd);
+			tcp.update_checksum(icd);
+		}
+		uint64_t const incremental_us = timer.elapsed_us() - start_us;
+
+		log("NAT rewrite of ", tcp_size, "-byte TCP packet: full ",
+		    rate(bench_rounds, full_us), " packets/s incremental ",
+		    rate(bench_rounds, incremental_us), " packets/s");
+	}
+}
+
+
 Main::Main(Env &env) : env(env)
 {
 	using Append_result = Append_file::Append_result;
@@ -254,9 +380,9 @@ Main::Main(Env &env) : env(env)
 		Internet_checksum_diff ip_icd { };
 		modify_ip4(ip, ip_icd);
 		switch (ip.protocol()) {
-		case Ipv4_packet::Protocol::TCP: ip.data<Tcp_packet>(size_guard).update_checksum(ip.src(), ip.dst(), l4_size); break;
-		case Ipv4_packet::Protocol::UDP: ip.data<Udp_packet>(size_guard).update_checksum(ip.src(), ip.dst()); break;
-		case Ipv4_packet::Protocol::ICMP: ip.data<Icmp_packet>(size_guard).update_checksum(l4_size - sizeof(Icmp_packet)); break;
+		case Ipv4_packet::Protocol::TCP: modify_tcp(ip.data<Tcp_packet>(size_guard), ip, ip_icd, l4_size); break;
+		case Ipv4_packet::Protocol::UDP: modify_udp(ip.data<Udp_packet>(size_guard), ip, ip_icd); break;
+		case Ipv4_packet::Protocol::ICMP: modify_icmp(ip.data<Icmp_packet>(size_guard), l4_size); break;
 		default: break;
 		}
 		ip.update_checksum(ip_icd);
@@ -270,6 +396,8 @@ Main::Main(Env &env) : env(env)
 	    ") in ", num_packets, " packet", num_packets == 1 ? "" : "s", " with ", num_errors, " error", num_errors == 1 ? "" : "s");
 
 	pcap_file.destruct();
+
+	benchmark();
 	env.parent().exit(num_errors ? -1 : 0);
 }
 
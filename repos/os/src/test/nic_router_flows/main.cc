@@ -0,0 +1,274 @@
+/*
+ * \brief  Benchmark of the NIC-router link-side lookup under flow churn
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The test keeps a window of active flows, replacing the oldest flow by a
+ * new one at each step and looking up random active flows in between. The
+ * same workload is replayed once via the flow table used by the NIC router
+ * and once via an AVL tree, which the NIC router used before. It checks
+ * that both lookups find the same flows, also if most flows exceed the
+ * capacity of the flow table.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+#include <util/avl_tree.h>
+
+/* NIC-router includes */
+#include <flow_table.h>
+
+namespace Test {
+
+	using namespace Genode;
+	using namespace Net;
+
+	struct Flow_id;
+	struct Flow;
+	struct Flow_tree;
+	struct Random;
+	struct Main;
+}
+
+
+/**
+ * Counterpart of 'Net::Link_side_id'
+ */
+struct Test::Flow_id
+{
+	uint32_t src_ip;
+	uint16_t src_port;
+	uint32_t dst_ip;
+	uint16_t dst_port;
+
+	bool operator != (Flow_id const &id) const
+	{
+		return src_ip   != id.src_ip   || dst_ip   != id.dst_ip
+		    || src_port != id.src_port || dst_port != id.dst_port;
+	}
+
+	bool operator > (Flow_id const &id) const
+	{
+		if (src_ip   != id.src_ip)   return id.src_ip   > src_ip;
+		if (dst_ip   != id.dst_ip)   return id.dst_ip   > dst_ip;
+		if (src_port != id.src_port) return id.src_port > src_port;
+		return id.dst_port > dst_port;
+	}
+
+	uint32_t hash() const
+	{
+		uint64_t key = ((uint64_t)src_ip << 32 | dst_ip)
+		             ^ ((uint64_t)src_port << 40 | (uint64_t)dst_port << 8);
+
+		key ^= key >> 33;
+		key *= 0xff51afd7ed558ccdULL;
+		key ^= key >> 33;
+		key *= 0xc4ceb9fe1a85ec53ULL;
+		key ^= key >> 33;
+		return (uint32_t)key;
+	}
+};
+
+
+struct Test::Flow : List<Flow>::Element, Avl_node<Flow>
+{
+	Flow_id  const _id;
+	unsigned const number;
+
+	Flow(Flow_id const &id, unsigned number) : _id(id), number(number) { }
+
+	Flow_id const &id() const { return _id; }
+
+	bool higher(Flow *flow) { return flow->_id > _id; }
+
+	Flow const *find_by_id(Flow_id const &id) const
+	{
+		if (!(id != _id))
+			return this;
+
+		Flow const *const child { Avl_node<Flow>::child(id > _id) };
+		return child ? child->find_by_id(id) : nullptr;
+	}
+};
+
+
+struct Test::Flow_tree : Avl_tree<Flow>
+{
+	void find_by_id(Flow_id const &id, auto const &handle_match,
+	                auto const &handle_no_match) const
+	{
+		Flow const *const flow { first() ? first()->find_by_id(id) : nullptr };
+		if (flow)
+			handle_match(*flow);
+		else
+			handle_no_match();
+	}
+};
+
+
+/**
+ * Xorshift pseudo-random number generator
+ */
+struct Test::Random
+{
+	uint32_t _state;
+
+	uint32_t next()
+	{
+		_state ^= _state << 13;
+		_state ^= _state >> 17;
+		_state ^= _state << 5;
+		return _state;
+	}
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	unsigned const _steps {
+		_config.node().attribute_value("steps", 200000U) };
+
+	unsigned const _lookups_per_step {
+		_config.node().attribute_value("lookups_per_step", 8U) };
+
+	unsigned const _max_flows {
+		_config.node().attribute_value("max_flows", 65536U) };
+
+	bool _mismatch = false;
+
+	static Flow_id _flow_id(unsigned number)
+	{
+		Random random { number*2654435761U + 1 };
+		return { .src_ip   = 0x0a000000 | (random.next() & 0xffff),
+		         .src_port = (uint16_t)(1024 + number % 60000),
+		         .dst_ip   = 0xc0a80000 | (random.next() & 0xff),
+		         .dst_port = (uint16_t)(random.next() % 2 ? 80 : 443) };
+	}
+
+	struct Result { uint64_t duration_us; unsigned long checksum; };
+
+	/**
+	 * Replay churn on a window of 'num_flows' active flows
+	 */
+	Result _replay(auto &flows, unsigned num_flows)
+	{
+		Flow **window = new (_heap) Flow*[num_flows];
+
+		for (unsigned i = 0; i < num_flows; i++) {
+			window[i] = new (_heap) Flow(_flow_id(i), i);
+			flows.insert(window[i]);
+		}
+
+		Random random { 0x87654321 };
+		unsigned long checksum = 0;
+
+		uint64_t const start = _timer.elapsed_us();
+
+		for (unsigned step = 0; step < _steps; step++) {
+
+			/* replace the oldest flow by a new one */
+			unsigned const slot = step % num_flows;
+			flows.remove(window[slot]);
+			destroy(_heap, window[slot]);
+
+			window[slot] = new (_heap) Flow(_flow_id(num_flows + step), num_flows + step);
+			flows.insert(window[slot]);
+
+			/* look up active flows and, now and then, an unknown one */
+			for (unsigned i = 0; i < _lookups_per_step; i++) {
+				uint32_t const value = random.next();
+				unsigned const number = (value & 7)
+				                      ? window[value % num_flows]->number
+				                      : ~0U - value % 1024;
+
+				flows.find_by_id(_flow_id(number),
+					[&] (Flow const &flow) { checksum += flow.number + 1; },
+					[&] { checksum += 7; });
+			}
+		}
+		uint64_t const duration_us = _timer.elapsed_us() - start;
+
+		for (unsigned i = 0; i < num_flows; i++) {
+			flows.remove(window[i]);
+			destroy(_heap, window[i]);
+		}
+		destroy(_heap, window);
+
+		return { duration_us, checksum };
+	}
+
+	uint64_t _rate(uint64_t count, uint64_t duration_us)
+	{
+		return duration_us ? count*1000*1000/duration_us : 0;
+	}
+
+	void _measure(unsigned num_flows)
+	{
+		Result table_result { }, tree_result { };
+		{
+			Flow_table<Flow> table { _heap, num_flows };
+			table_result = _replay(table, num_flows);
+		}
+		{
+			Flow_tree tree { };
+			tree_result = _replay(tree, num_flows);
+		}
+		if (table_result.checksum != tree_result.checksum) {
+			error("flows: ", num_flows, " table lookup differs from tree lookup");
+			_mismatch = true;
+		}
+
+		/* keep most flows of small windows in the overflow list of the table */
+		if (num_flows <= 64) {
+			Flow_table<Flow> table { _heap, num_flows/4 };
+			if (_replay(table, num_flows).checksum != tree_result.checksum) {
+				error("flows: ", num_flows, " overflow lookup differs from tree lookup");
+				_mismatch = true;
+			}
+		}
+
+		uint64_t const lookups = (uint64_t)_steps*_lookups_per_step;
+
+		log("flows: ", num_flows,
+		    " table: ", _rate(_steps, table_result.duration_us), " links/s ",
+		                _rate(lookups, table_result.duration_us), " packets/s",
+		    " tree: ",  _rate(_steps, tree_result.duration_us), " links/s ",
+		                _rate(lookups, tree_result.duration_us), " packets/s");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- NIC-router flow-churn benchmark started ---");
+
+		for (unsigned num_flows = 16; num_flows <= _max_flows; num_flows *= 4)
+			_measure(num_flows);
+
+		if (_mismatch) {
+			_env.parent().exit(-1);
+			return;
+		}
+		log("--- NIC-router flow-churn benchmark finished ---");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,9 @@
+TARGET = test-nic_router_flows
+
+LIBS += base
+
+SRC_CC += main.cc
+
+NIC_ROUTER_DIR = $(call select_from_repositories,src/server/nic_router)
+
+INC_DIR += $(NIC_ROUTER_DIR)
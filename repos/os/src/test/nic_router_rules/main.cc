@@ -0,0 +1,222 @@
+/*
+ * \brief  Benchmark of the NIC-router rule lookup
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The test generates rule sets of increasing size with random destination
+ * prefixes and replays synthetic traffic against them, once via the sorted
+ * rule list and once via the prefix-trie index. It checks that both
+ * lookups select the same rule for each packet.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+
+/* NIC-router includes */
+#include <direct_rule.h>
+
+namespace Test {
+
+	using namespace Genode;
+	using namespace Net;
+
+	struct Rule;
+	struct Rule_list;
+	struct Random;
+	struct Main;
+}
+
+
+struct Test::Rule : Direct_rule<Rule>
+{
+	unsigned const id;
+
+	Rule(Ipv4_address_prefix const &dst, unsigned id)
+	: Direct_rule(dst), id(id) { }
+};
+
+
+struct Test::Rule_list : Direct_rule_list<Rule> { };
+
+
+/**
+ * Xorshift pseudo-random number generator
+ */
+struct Test::Random
+{
+	uint32_t _state;
+
+	uint32_t next()
+	{
+		_state ^= _state << 13;
+		_state ^= _state >> 17;
+		_state ^= _state << 5;
+		return _state;
+	}
+};
+
+
+struct Test::Main
+{
+	enum { MAX_ADDRESSES = 4096 };
+
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	unsigned const _lookups {
+		_config.node().attribute_value("lookups", 1000000U) };
+
+	unsigned const _max_rules {
+		_config.node().attribute_value("max_rules", 4096U) };
+
+	Ipv4_address _addresses[MAX_ADDRESSES] { };
+
+	bool _mismatch = false;
+
+	/**
+	 * Return rule prefix with lengths distributed like a routing table
+	 */
+	static Ipv4_address_prefix _random_prefix(Random &random)
+	{
+		static uint8_t const lengths[] = { 8, 12, 16, 16, 20, 24, 24, 24, 28, 32 };
+
+		Ipv4_address_prefix prefix;
+		prefix.prefix  = lengths[random.next() % sizeof(lengths)];
+		prefix.address = Ipv4_address::from_uint32_little_endian(random.next());
+		return prefix;
+	}
+
+	/**
+	 * Fill rule list and synthetic traffic, half of it hitting a rule
+	 */
+	void _generate(Rule_list &rules, unsigned num_rules, uint32_t seed)
+	{
+		Random random { seed };
+
+		Ipv4_address_prefix prefixes[64];
+		unsigned num_prefixes = 0;
+
+		for (unsigned i = 0; i < num_rules; i++) {
+			Ipv4_address_prefix const dst = _random_prefix(random);
+			rules.insert(*new (_heap) Rule(dst, i));
+
+			if (i < 64)
+				prefixes[num_prefixes++] = dst;
+		}
+		for (Ipv4_address &ip : _addresses) {
+
+			uint32_t value = random.next();
+			if (num_prefixes && (value & 1)) {
+				Ipv4_address_prefix const &dst =
+					prefixes[random.next() % num_prefixes];
+
+				uint32_t const mask = dst.prefix ? ~0U << (32 - dst.prefix) : 0;
+				value = (dst.address.to_uint32_little_endian() & mask)
+				      | (value & ~mask);
+			}
+			ip = Ipv4_address::from_uint32_little_endian(value);
+		}
+	}
+
+	unsigned _replay(Rule_list const &rules, uint64_t &duration_us)
+	{
+		unsigned hits = 0;
+
+		uint64_t const start = _timer.elapsed_us();
+
+		for (unsigned i = 0; i < _lookups; i++)
+			rules.find_longest_prefix_match(_addresses[i % MAX_ADDRESSES],
+				[&] (Rule const &rule) { hits += rule.id + 1; },
+				[&] { });
+
+		duration_us = _timer.elapsed_us() - start;
+		return hits;
+	}
+
+	void _check(Rule_list const &list, Rule_list const &indexed)
+	{
+		for (Ipv4_address const &ip : _addresses) {
+
+			unsigned list_id = ~0U, trie_id = ~0U;
+
+			list.find_longest_prefix_match(ip,
+				[&] (Rule const &rule) { list_id = rule.id; }, [&] { });
+
+			indexed.find_longest_prefix_match(ip,
+				[&] (Rule const &rule) { trie_id = rule.id; }, [&] { });
+
+			if (list_id != trie_id) {
+				error("lookup of ", ip, " differs, list: ", list_id,
+				      " trie: ", trie_id);
+				_mismatch = true;
+				return;
+			}
+		}
+	}
+
+	static uint64_t _rate(unsigned lookups, uint64_t duration_us)
+	{
+		return duration_us ? (uint64_t)lookups*1000*1000/duration_us : 0;
+	}
+
+	void _measure(unsigned num_rules)
+	{
+		Rule_list list { }, indexed { };
+
+		_generate(list,    num_rules, 0x12345678 + num_rules);
+		_generate(indexed, num_rules, 0x12345678 + num_rules);
+
+		indexed.build_index(_heap);
+
+		_check(list, indexed);
+
+		uint64_t list_us = 0, trie_us = 0;
+
+		unsigned const list_hits = _replay(list,    list_us);
+		unsigned const trie_hits = _replay(indexed, trie_us);
+
+		if (list_hits != trie_hits)
+			_mismatch = true;
+
+		log("rules: ", num_rules, " lookups: ", _lookups,
+		    " list: ", _rate(_lookups, list_us), " lookups/s",
+		    " trie: ", _rate(_lookups, trie_us), " lookups/s");
+
+		list.destroy_each(_heap);
+		indexed.destroy_each(_heap);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- NIC-router rule-lookup benchmark started ---");
+
+		for (unsigned num_rules = 4; num_rules <= _max_rules; num_rules *= 4)
+			_measure(num_rules);
+
+		if (_mismatch) {
+			error("trie lookup differs from list lookup");
+			_env.parent().exit(-1);
+			return;
+		}
+		log("--- NIC-router rule-lookup benchmark finished ---");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
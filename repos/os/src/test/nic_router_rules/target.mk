@@ -0,0 +1,11 @@
+TARGET = test-nic_router_rules
+
+LIBS += base net
+
+SRC_CC += main.cc ipv4_address_prefix.cc
+
+NIC_ROUTER_DIR = $(call select_from_repositories,src/server/nic_router)
+
+INC_DIR += $(NIC_ROUTER_DIR)
+
+vpath ipv4_address_prefix.cc $(NIC_ROUTER_DIR)
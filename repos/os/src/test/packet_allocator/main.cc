@@ -0,0 +1,231 @@
+/*
+ * \brief  Fragmentation stress test for packet allocators
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The test replays the same pseudo-random sequence of allocations and
+ * releases of mixed packet sizes against 'Genode::Packet_allocator' and
+ * 'Genode::Segregated_packet_allocator'. It checks that no two packets
+ * overlap and reports the rate of operations, the worst-case latency of a
+ * single operation, and the number of failed allocations.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/attached_rom_dataspace.h>
+#include <os/packet_allocator.h>
+#include <os/segregated_packet_allocator.h>
+#include <timer_session/connection.h>
+#include <trace/timestamp.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	enum {
+		BLOCK_SIZE  = 64,
+		BUFFER_SIZE = 1024*1024,
+		NUM_BLOCKS  = BUFFER_SIZE/BLOCK_SIZE,
+		MAX_LIVE    = 2048,
+	};
+
+	struct Random;
+	struct Stress;
+	struct Main;
+}
+
+
+/**
+ * Xorshift pseudo-random number generator
+ */
+struct Test::Random
+{
+	uint64_t _state;
+
+	uint64_t next()
+	{
+		_state ^= _state << 13;
+		_state ^= _state >> 7;
+		_state ^= _state << 17;
+		return _state;
+	}
+
+	/**
+	 * Return packet size following a mix of tiny and MTU-sized packets
+	 */
+	size_t packet_size()
+	{
+		unsigned const kind = (unsigned)(next() % 100);
+
+		if (kind < 60) return  64 + next() % 128;    /* tiny packets     */
+		if (kind < 95) return 1400 + next() % 200;   /* MTU-sized        */
+		return                4096 + next() % 12288; /* occasional large */
+	}
+};
+
+
+struct Test::Stress
+{
+	struct Packet { addr_t addr; size_t size; };
+
+	Allocator       &_heap;
+	Range_allocator &_alloc;
+
+	Packet   _live[MAX_LIVE] { };
+	uint16_t _owner[NUM_BLOCKS] { };  /* slot + 1 of the owning packet */
+
+	uint64_t _failed      = 0;
+	uint64_t _max_cycles  = 0;
+	bool     _overlap     = false;
+
+	static constexpr addr_t BASE = 0x100000;
+
+	Stress(Allocator &heap, Range_allocator &alloc) : _heap(heap), _alloc(alloc)
+	{
+		if (_alloc.add_range(BASE, BUFFER_SIZE).failed())
+			error("add_range failed");
+	}
+
+	~Stress()
+	{
+		for (Packet &p : _live)
+			if (p.size)
+				_alloc.free((void *)p.addr, p.size);
+
+		(void)_alloc.remove_range(BASE, BUFFER_SIZE);
+	}
+
+	void _mark(unsigned slot, Packet const &p, bool assign)
+	{
+		size_t const first = (p.addr - BASE)/BLOCK_SIZE;
+		size_t const last  = (p.addr - BASE + p.size - 1)/BLOCK_SIZE;
+
+		for (size_t i = first; i <= last; i++) {
+			if (assign && _owner[i])
+				_overlap = true;
+			_owner[i] = assign ? (uint16_t)(slot + 1) : 0;
+		}
+	}
+
+	void _measure(auto const &fn)
+	{
+		Trace::Timestamp const start = Trace::timestamp();
+		fn();
+		_max_cycles = max(_max_cycles, (uint64_t)(Trace::timestamp() - start));
+	}
+
+	void step(Random &random)
+	{
+		unsigned const slot = (unsigned)(random.next() % MAX_LIVE);
+		Packet &p = _live[slot];
+
+		if (p.size) {
+			_mark(slot, p, false);
+			_measure([&] { _alloc.free((void *)p.addr, p.size); });
+			p = { };
+			return;
+		}
+
+		size_t const size = random.packet_size();
+
+		_measure([&] {
+			_alloc.try_alloc(size).with_result(
+				[&] (Range_allocator::Allocation &a) {
+					a.deallocate = false;
+					p = { (addr_t)a.ptr, size }; },
+				[&] (Alloc_error) { _failed++; });
+		});
+
+		if (p.size)
+			_mark(slot, p, true);
+	}
+
+	bool whole_buffer_allocatable()
+	{
+		for (Packet &p : _live)
+			if (p.size) {
+				_alloc.free((void *)p.addr, p.size);
+				p = { };
+			}
+
+		return _alloc.try_alloc(BUFFER_SIZE).convert<bool>(
+			[&] (Range_allocator::Allocation &) { return true; },
+			[&] (Alloc_error) { return false; });
+	}
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	uint64_t const _operations = _config.node().attribute_value("operations", 1'000'000ULL);
+
+	Timer::Connection _timer { _env };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	/**
+	 * Run stress sequence, return true if the allocator behaved correctly
+	 */
+	bool _run(char const *name, Range_allocator &alloc, bool check_coalescing)
+	{
+		Stress &stress = *new (_heap) Stress(_heap, alloc);
+
+		Random random { 0x2545f4914f6cdd1dULL };
+
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (uint64_t i = 0; i < _operations; i++)
+			stress.step(random);
+
+		uint64_t const duration_us = max(_timer.elapsed_us() - start_us, 1ULL);
+
+		log(name, ": ", _operations, " operations in ", duration_us, " us -> ",
+		    (_operations*1'000'000ULL)/duration_us, " ops/s, "
+		    "max latency ", stress._max_cycles, " cycles, ",
+		    stress._failed, " failed allocations");
+
+		bool ok = true;
+
+		if (stress._overlap) {
+			error(name, ": overlapping packets");
+			ok = false;
+		}
+
+		if (check_coalescing && !stress.whole_buffer_allocatable()) {
+			error(name, ": free ranges not coalesced");
+			ok = false;
+		}
+
+		destroy(_heap, &stress);
+		return ok;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- packet-allocator stress test started ---");
+
+		Packet_allocator            bitmap     { &_heap, BLOCK_SIZE };
+		Segregated_packet_allocator segregated { &_heap, BLOCK_SIZE };
+
+		bool const ok = _run("Packet_allocator           ", bitmap,     false)
+		              & _run("Segregated_packet_allocator", segregated, true);
+
+		log("--- packet-allocator stress test finished ---");
+		_env.parent().exit(ok ? 0 : -1);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,270 @@
+/*
+ * \brief  Benchmark for the packet-descriptor path of packet streams
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * Source and sink of a packet stream are instantiated within the same
+ * component on a shared buffer, each side driven by its own thread. The
+ * benchmark measures the packet rate through the submit and acknowledgement
+ * queues, using the single-packet and the batched API. Payload workloads
+ * let the source write and the sink read each packet's content. Each
+ * workload is run with the default locking of the queue accesses and
+ * without locking ('Packet_stream_unlocked').
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/thread.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/attached_rom_dataspace.h>
+#include <os/packet_stream.h>
+#include <os/packet_allocator.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	enum { QUEUE_SIZE = 1024, MAX_BATCH = 64 };
+
+	template <typename LOCK>
+	using Policy = Packet_stream_policy<Packet_descriptor, QUEUE_SIZE, QUEUE_SIZE, char, LOCK>;
+
+	template <typename> struct Sink_thread;
+	template <typename> struct Stream;
+	struct Main;
+}
+
+
+/**
+ * Thread that acknowledges each packet as soon as it arrives
+ */
+template <typename LOCK>
+struct Test::Sink_thread : Thread
+{
+	using Sink = Packet_stream_sink<Policy<LOCK>>;
+
+	Sink &_sink;
+
+	uint64_t const _count;
+	unsigned const _batch;
+	bool     const _touch;
+
+	uint64_t _checksum = 0;
+
+	void _consume(Packet_descriptor const &packet)
+	{
+		if (!_touch)
+			return;
+
+		uint8_t const * const content = (uint8_t const *)_sink.packet_content(packet);
+		for (size_t i = 0; i < packet.size(); i++)
+			_checksum += content[i];
+	}
+
+	void _entry_single()
+	{
+		for (uint64_t i = 0; i < _count; ) {
+
+			if (!_sink.packet_avail() || !_sink.ready_to_ack())
+				continue;
+
+			Packet_descriptor const packet = _sink.get_packet();
+			_consume(packet);
+			_sink.acknowledge_packet(packet);
+			i++;
+		}
+	}
+
+	void _entry_batched()
+	{
+		Packet_descriptor packets[MAX_BATCH];
+
+		for (uint64_t i = 0; i < _count; ) {
+
+			unsigned const n = _sink.try_get_packets(packets, _batch);
+
+			for (unsigned j = 0; j < n; j++)
+				_consume(packets[j]);
+
+			for (unsigned acked = 0; acked < n; )
+				acked += _sink.try_ack_packets(packets + acked, n - acked);
+
+			_sink.wakeup();
+			i += n;
+		}
+	}
+
+	Sink_thread(Env &env, Sink &sink, uint64_t count, unsigned batch, bool touch)
+	:
+		Thread(env, "sink", Stack_size { 16*1024 }),
+		_sink(sink), _count(count), _batch(batch), _touch(touch)
+	{ }
+
+	void entry() override
+	{
+		if (_batch > 1) _entry_batched(); else _entry_single();
+	}
+};
+
+
+/**
+ * Source and sink of a packet stream on a shared buffer
+ */
+template <typename LOCK>
+struct Test::Stream
+{
+	using Source = Packet_stream_source<Policy<LOCK>>;
+	using Sink   = Packet_stream_sink<Policy<LOCK>>;
+
+	Env               &_env;
+	Timer::Connection &_timer;
+	String<16>  const  _locking;
+	uint64_t    const  _count;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Packet_allocator _packet_alloc { &_heap, 1024 };
+
+	Attached_ram_dataspace _buffer { _env.ram(), _env.rm(), 256*1024 };
+
+	Source _source { _buffer.cap(), _env.rm(), _packet_alloc };
+	Sink   _sink   { _buffer.cap(), _env.rm() };
+
+	void _report(char const *name, size_t size, unsigned batch, uint64_t start_us)
+	{
+		uint64_t const duration_us = max(_timer.elapsed_us() - start_us, 1ULL);
+
+		log(name, " ", _locking, " size=", size, " batch=", batch, ": ",
+		    _count, " packets in ", duration_us, " us -> ",
+		    (_count*1'000'000ULL)/duration_us, " packets/s");
+	}
+
+	/**
+	 * Submit 'packet' until it got acknowledged '_count' times
+	 *
+	 * The same packet is submitted over and over again to keep the
+	 * measurement free from bulk-buffer allocations.
+	 */
+	void _stream(Packet_descriptor const packet, unsigned batch, bool touch)
+	{
+		Packet_descriptor packets[MAX_BATCH];
+		for (unsigned i = 0; i < MAX_BATCH; i++)
+			packets[i] = packet;
+
+		auto produce = [&] {
+			if (!touch)
+				return;
+
+			uint8_t * const content = (uint8_t *)_source.packet_content(packet);
+			for (size_t i = 0; i < packet.size(); i++)
+				content[i] = (uint8_t)i;
+		};
+
+		uint64_t submitted = 0, acked = 0;
+
+		while (acked < _count) {
+
+			if (batch > 1) {
+				while (submitted < _count) {
+					unsigned const n = (unsigned)min((uint64_t)batch, _count - submitted);
+					for (unsigned i = 0; i < n; i++)
+						produce();
+					unsigned const submitted_now = _source.try_submit_packets(packets, n);
+					submitted += submitted_now;
+					if (submitted_now < n)
+						break;
+				}
+				_source.wakeup();
+				acked += _source.try_get_acked_packets(packets, batch);
+				continue;
+			}
+
+			while (submitted < _count && _source.ready_to_submit()) {
+				produce();
+				_source.try_submit_packet(packet);
+				submitted++;
+			}
+
+			while (_source.ack_avail()) {
+				_source.get_acked_packet();
+				acked++;
+			}
+		}
+	}
+
+	Stream(Env &env, Timer::Connection &timer, String<16> const &locking, uint64_t count)
+	:
+		_env(env), _timer(timer), _locking(locking), _count(count)
+	{ }
+
+	void measure(char const *name, size_t size, unsigned batch, bool touch)
+	{
+		Packet_descriptor const packet = _source.alloc_packet(size);
+
+		Sink_thread<LOCK> sink_thread { _env, _sink, _count, batch, touch };
+
+		uint64_t const start_us = _timer.elapsed_us();
+
+		sink_thread.start();
+
+		_stream(packet, batch, touch);
+
+		_report(name, size, batch, start_us);
+
+		sink_thread.join();
+
+		_source.release_packet(packet);
+	}
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	uint64_t const _count = _config.node().attribute_value("descriptors", 10'000'000ULL);
+	unsigned const _batch = min(_config.node().attribute_value("batch", 32u),
+	                            (unsigned)MAX_BATCH);
+
+	Timer::Connection _timer { _env };
+
+	template <typename LOCK>
+	void _measure(char const *locking)
+	{
+		Stream<LOCK> stream { _env, _timer, locking, _count };
+
+		stream.measure("descriptors", 64, 1, false);
+		stream.measure("descriptors", 64, _batch, false);
+
+		stream.measure("payload    ", 64, 1, true);
+		stream.measure("payload    ", 64, _batch, true);
+
+		stream.measure("payload    ", 1500, 1, true);
+		stream.measure("payload    ", 1500, _batch, true);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- packet-stream benchmark started ---");
+
+		_measure<Mutex>                 ("locked  ");
+		_measure<Packet_stream_unlocked>("unlocked");
+
+		log("--- packet-stream benchmark finished ---");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
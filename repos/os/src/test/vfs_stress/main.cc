@@ -429,6 +429,88 @@ struct Read_test : public Stress_test
 };
 
 
+struct Lookup_test : public Stress_test
+{
+	void lookup(int depth)
+	{
+		if (++depth > MAX_DEPTH) return;
+
+		size_t path_len = 1+strlen(path.base());
+		char dir_type = *(path.base()+(path_len-2));
+
+		using namespace Vfs;
+
+		/* stat and open the existing file */
+		path.append("/c");
+		{
+			Directory_service::Stat stat { };
+			if (vfs.stat(path.base(), stat) != Directory_service::STAT_OK) {
+				error("stat failed");
+				throw Exception();
+			}
+
+			Vfs_handle *handle = nullptr;
+			assert_open(vfs.open(
+				path.base(), Directory_service::OPEN_MODE_RDONLY, &handle, alloc));
+			handle->close();
+			count += 2;
+		}
+
+		/* stat a missing file */
+		path.base()[path_len] = '\0';
+		path.append("d");
+		{
+			Directory_service::Stat stat { };
+			if (vfs.stat(path.base(), stat) != Directory_service::STAT_ERR_NO_ENTRY) {
+				error("stat of missing file succeeded");
+				throw Exception();
+			}
+			++count;
+		}
+
+		switch (dir_type) {
+		case 'a':
+			path.base()[path_len] = '\0';
+			path.append("a");
+			lookup(depth);
+			[[fallthrough]];
+
+		case 'b':
+			path.base()[path_len] = '\0';
+			path.append("b");
+			lookup(depth);
+			return;
+
+		default:
+			error("bad directory ", Char(dir_type), " at the end of '", path, "'");
+			throw Exception();
+		}
+	}
+
+	Lookup_test(Vfs::File_system &vfs, Genode::Allocator &alloc, char const *parent)
+	: Stress_test(vfs, alloc, parent)
+	{
+		size_t path_len = strlen(path.base());
+		try {
+			path.append("/a");
+			lookup(1);
+
+			path.base()[path_len] = '\0';
+			path.append("/b");
+			lookup(1);
+		} catch (...) {
+			error("failed at ",path," after ",count," lookups");
+			throw;
+		}
+	}
+
+	Vfs::file_size wait()
+	{
+		return count;
+	}
+};
+
+
 struct Unlink_test : public Stress_test
 {
 	Vfs::Env::Io &_io;
@@ -609,6 +691,30 @@ void Component::construct(Genode::Env &env)
 	}
 
 
+	/******************
+	 ** Lookup files **
+	 ******************/
+
+	if (config_rom.node().attribute_value("lookup", true)) {
+		Vfs::file_size count = 0;
+		log("looking up files...");
+		elapsed_ms = timer.elapsed_ms();
+
+		for (int i = 0; i < ROOT_TREE_COUNT; ++i) {
+			path = { "/", i };
+			Lookup_test test(vfs_root, heap, path.string());
+			count += test.wait();
+		}
+
+		elapsed_ms = timer.elapsed_ms() - elapsed_ms;
+
+		if (count > 0)
+			log("performed ",count," lookups, ",
+			    (elapsed_ms*1000)/count,"μs/op, ",
+			    env.pd().used_ram().value/1024,"KiB consumed");
+	}
+
+
 	/*****************
 	 ** Write files **
 	 *****************/
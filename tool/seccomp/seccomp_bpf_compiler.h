@@ -16,6 +16,7 @@
 #include <seccomp.h> /* libseccomp */
 #include <asm/signal.h>
 #include <linux/sched.h>
+#include <linux/fcntl.h> /* F_ADD_SEALS, F_GET_SEALS */
 
 class Filter
 {
@@ -23,6 +24,9 @@ class Filter
 		scmp_filter_ctx _ctx = seccomp_init(SCMP_ACT_KILL_PROCESS);
 		uint32_t _arch;
 
+		/* permit the syscalls of the shared-memory RPC path */
+		bool _rpc_mailbox;
+
 
 		void _add_allow_rule(int syscall_number)
 		{
@@ -55,8 +59,8 @@ class Filter
 
 	public:
 
-		Filter(uint32_t arch)
-			: _arch(arch)
+		Filter(uint32_t arch, bool rpc_mailbox)
+			: _arch(arch), _rpc_mailbox(rpc_mailbox)
 		{
 		}
 
@@ -105,6 +109,14 @@ class Filter
 			/* This syscall is used to wait for a condition. This should be safe. */
 			_add_allow_rule(SCMP_SYS(futex));
 
+			/* These syscalls are used by the shared-memory path of the RPC
+			 * mechanism. They only create and size objects of the process. */
+			if (_rpc_mailbox) {
+				_add_allow_rule(SCMP_SYS(memfd_create));
+				_add_allow_rule(SCMP_SYS(ftruncate));
+				_add_allow_rule(SCMP_SYS(eventfd2));
+			}
+
 			/* This syscall ends the program. This should be safe */
 			_add_allow_rule(SCMP_SYS(exit));
 
@@ -145,6 +157,13 @@ class Filter
 						 * but it slould be save as it only uses an already open socket. */
 						_add_allow_rule(SCMP_SYS(mmap2));
 
+						/* The fcntl syscall is restricted to the sealing of
+						 * shared memory used by the RPC mechanism. */
+						if (_rpc_mailbox) {
+							_add_allow_rule(SCMP_SYS(fcntl64), SCMP_CMP32(1, SCMP_CMP_EQ, F_ADD_SEALS));
+							_add_allow_rule(SCMP_SYS(fcntl64), SCMP_CMP32(1, SCMP_CMP_EQ, F_GET_SEALS));
+						}
+
 						/* returning from signal handlers is safe */
 						_add_allow_rule(SCMP_SYS(sigreturn));
 					}
@@ -166,6 +185,13 @@ class Filter
 						 * but it slould be save as it only uses an already open socket. */
 						_add_allow_rule(SCMP_SYS(mmap));
 
+						/* The fcntl syscall is restricted to the sealing of
+						 * shared memory used by the RPC mechanism. */
+						if (_rpc_mailbox) {
+							_add_allow_rule(SCMP_SYS(fcntl), SCMP_CMP64(1, SCMP_CMP_EQ, F_ADD_SEALS));
+							_add_allow_rule(SCMP_SYS(fcntl), SCMP_CMP64(1, SCMP_CMP_EQ, F_GET_SEALS));
+						}
+
 						/* returning from signal handlers is safe */
 						_add_allow_rule(SCMP_SYS(rt_sigreturn));
 
@@ -193,6 +219,13 @@ class Filter
 						/* This syscall is only used on ARM. */
 						_add_allow_rule(SCMP_SYS(cacheflush));
 
+						/* The fcntl syscall is restricted to the sealing of
+						 * shared memory used by the RPC mechanism. */
+						if (_rpc_mailbox) {
+							_add_allow_rule(SCMP_SYS(fcntl64), SCMP_CMP32(1, SCMP_CMP_EQ, F_ADD_SEALS));
+							_add_allow_rule(SCMP_SYS(fcntl64), SCMP_CMP32(1, SCMP_CMP_EQ, F_GET_SEALS));
+						}
+
 						/* returning from signal handlers is safe */
 						_add_allow_rule(SCMP_SYS(sigreturn));
 					}
@@ -206,6 +239,13 @@ class Filter
 						_add_allow_rule(SCMP_SYS(cacheflush));
 						_add_allow_rule(SCMP_SYS(sigreturn));
 
+						/* The fcntl syscall is restricted to the sealing of
+						 * shared memory used by the RPC mechanism. */
+						if (_rpc_mailbox) {
+							_add_allow_rule(SCMP_SYS(fcntl), SCMP_CMP64(1, SCMP_CMP_EQ, F_ADD_SEALS));
+							_add_allow_rule(SCMP_SYS(fcntl), SCMP_CMP64(1, SCMP_CMP_EQ, F_GET_SEALS));
+						}
+
 						/* returning from signal handlers is safe */
 						_add_allow_rule(SCMP_SYS(rt_sigreturn));
 					}
@@ -13,11 +13,14 @@
  */
 
 #include <stdio.h>   /* printf */
+#include <string.h>  /* strcmp */
 #include <seccomp.h> /* libseccomp */
 #include "seccomp_bpf_compiler.h"
 
-int main()
+int main(int argc, char **argv)
 {
-	Filter filter(SCMP_ARCH_AARCH64);
+	bool const rpc_mailbox = (argc > 1) && (strcmp(argv[1], "rpc_mailbox") == 0);
+
+	Filter filter(SCMP_ARCH_AARCH64, rpc_mailbox);
 	return filter.create();
 }